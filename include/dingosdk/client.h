@@ -204,6 +204,10 @@ struct TransactionOptions {
   TransactionKind kind;
   TransactionIsolation isolation;
   uint32_t keep_alive_ms;
+  // read only txn reads one snapshot without buffer and commit, write ops are rejected
+  bool read_only{false};
+  // only for read only txn, read the snapshot of this ts without getting tso from coordinator, 0 means latest
+  int64_t snapshot_ts{0};
 };
 
 class Transaction {
@@ -229,7 +233,7 @@ class Transaction {
 
   Status BatchDelete(const std::vector<std::string>& keys);
 
-  // limit: 0 means no limit, will scan all key in [start_key, end_key)
+  // limit: 0 means no limit, will scan all key in [start_key, end_key), read only txn scans regions in parallel
   // maybe multiple invoke, when out_kvs.size < limit is over.
   Status Scan(const std::string& start_key, const std::string& end_key, uint64_t limit, std::vector<KVPair>& kvs);
 
@@ -19,11 +19,15 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <variant>
 #include <vector>
 
 #include "dingosdk/status.h"
 #include "dingosdk/types.h"
+#include "dingosdk/vector.h"
 
 namespace dingodb {
 namespace sdk {
@@ -74,51 +78,61 @@ class DocumentIndexCreator {
   explicit DocumentIndexCreator(Data* data);
 };
 
+// A field value of a document, stored inline: numbers in place and strings in a small string optimized std::string.
 class DocValue {
  public:
-  ~DocValue();
+  ~DocValue() = default;
 
-  DocValue(const DocValue&);
-  DocValue& operator=(const DocValue&);
-  DocValue(DocValue&& other) noexcept;
-  DocValue& operator=(DocValue&& other) noexcept;
+  DocValue(const DocValue&) = default;
+  DocValue& operator=(const DocValue&) = default;
+  DocValue(DocValue&& other) noexcept = default;
+  DocValue& operator=(DocValue&& other) noexcept = default;
 
   static DocValue FromInt(int64_t val);
   static DocValue FromDouble(double val);
-  static DocValue FromString(const std::string& val);
-  static DocValue FromBytes(const std::string& val);
+  static DocValue FromString(std::string val);
+  static DocValue FromBytes(std::string val);
   static DocValue FromBool(bool val);
-  static DocValue FromDatetime(const std::string& val);
+  static DocValue FromDatetime(std::string val);
 
-  Type GetType() const;
+  Type GetType() const { return type_; }
   int64_t IntValue() const;
   double DoubleValue() const;
-  std::string StringValue() const;
-  std::string BytesValue() const;
+  // string, bytes and datetime are returned by reference, valid as long as the value
+  const std::string& StringValue() const;
+  const std::string& BytesValue() const;
   bool BoolValue() const;
-  std::string DatetimeValue() const;
+  const std::string& DatetimeValue() const;
 
   std::string ToString() const;
 
  private:
-  friend class DocumentTranslater;
-  class Data;
-  std::unique_ptr<Data> data_;
+  explicit DocValue() = default;
 
-  explicit DocValue();
+  Type type_{Type::kTypeEnd};
+  std::variant<int64_t, double, bool, std::string> value_;
 };
 
+// Fields of a document in insertion order, kept in one vector since a document has a handful of fields.
 class Document {
  public:
+  // the field is ignored if key already exists
   void AddField(const std::string& key, const DocValue& value);
+  void AddField(std::string&& key, DocValue&& value);
+
+  // return nullptr if key not exists, the value is valid until the document is changed
+  const DocValue* GetField(std::string_view key) const;
 
+  const std::vector<std::pair<std::string, DocValue>>& Fields() const { return fields_; }
+
+  // copy of all fields, use GetField or Fields to read without copy
   std::unordered_map<std::string, DocValue> GetFields() const;
 
   std::string ToString() const;
 
  private:
   friend class DocumentTranslater;
-  std::unordered_map<std::string, DocValue> fields_;
+  std::vector<std::pair<std::string, DocValue>> fields_;
 };
 
 struct DocWithId {
@@ -159,6 +173,8 @@ struct DocSearchParam {
   std::vector<std::string> selected_keys;
   //search all need ,The maximum number of results to return.
   int32_t query_limited{40960};
+  // paged search all, the maximum number of results of one page
+  int32_t page_size{1024};
 };
 
 struct DocWithStore {
@@ -173,6 +189,49 @@ struct DocSearchResult {
   std::string ToString() const;
 };
 
+enum HybridFusionType : uint8_t {
+  // score of a hit is sum of weight / (rrf_k + rank) of the sides it is a candidate of, rank starts from 1
+  kReciprocalRankFusion,
+  // score of a hit is sum of weight * score of the sides it is a candidate of, scores of each side are min-max
+  // normalized to [0, 1], vector distances are turned to similarity first
+  kWeightedScoreFusion
+};
+
+struct HybridSearchParam {
+  // number of fused hits to return, 0 means all candidates
+  int32_t top_k{10};
+  HybridFusionType fusion_type{kReciprocalRankFusion};
+  int32_t rrf_k{60};
+  double text_weight{1.0};
+  double vector_weight{1.0};
+  // fetch documents of the fused hits from the document index, scalar data of the candidates is never fetched
+  bool with_scalar_data{true};
+  // If with_scalar_data is true, selected_keys is used to select scalar data, and if this parameter is null, all scalar
+  // data will be returned.
+  std::vector<std::string> selected_keys;
+};
+
+struct HybridSearchHit {
+  int64_t id{0};
+  // fused score, higher is better
+  double score{0.0};
+  // rank of the hit in full text and vector candidates starts from 1, 0 means it is not a candidate of that side
+  int32_t text_rank{0};
+  int32_t vector_rank{0};
+  float text_score{0.0};
+  float vector_distance{0.0};
+  // only id is set when with_scalar_data is false
+  DocWithId doc;
+
+  std::string ToString() const;
+};
+
+struct HybridSearchResult {
+  std::vector<HybridSearchHit> hits;
+
+  std::string ToString() const;
+};
+
 struct DocDeleteResult {
   int64_t doc_id;
   bool deleted;
@@ -235,6 +294,30 @@ class DocumentClient {
   Status SearchAllByIndexName(int64_t schema_id, const std::string& index_name, const DocSearchParam& search_param,
                            DocSearchResult& out_result);
 
+  // search all one page of at most page_size results in descending score order, only the stream of each region
+  // and the last returned result are kept in the page token. pass empty page_token for the first page, then pass
+  // next_page_token with the same search_param to get the following page, the search is finished when
+  // next_page_token is empty. the streams of the regions expire on store if the next page is not fetched in time.
+  // when regions of the index are split or merged between two pages, the next page fails with Aborted and the search
+  // must start again with empty page_token.
+  Status SearchAllPageByIndexId(int64_t index_id, const DocSearchParam& search_param, const std::string& page_token,
+                                DocSearchResult& out_result, std::string& next_page_token);
+  Status SearchAllPageByIndexName(int64_t schema_id, const std::string& index_name, const DocSearchParam& search_param,
+                                  const std::string& page_token, DocSearchResult& out_result,
+                                  std::string& next_page_token);
+
+  // full text search of doc_param on the document index and vector search of target_vector on vector_index_id run
+  // concurrently, candidates are fused by id so a document and a vector of the same entity must share the id.
+  // top_n of doc_param and topk of vector_param are the candidate counts, candidates are searched without payload
+  // and documents of the fused hits are fetched by one batch query at the end.
+  Status HybridSearchByIndexId(int64_t index_id, const DocSearchParam& doc_param, int64_t vector_index_id,
+                               const SearchParam& vector_param, const VectorWithId& target_vector,
+                               const HybridSearchParam& hybrid_param, HybridSearchResult& out_result);
+  Status HybridSearchByIndexName(int64_t schema_id, const std::string& index_name, const DocSearchParam& doc_param,
+                                 int64_t vector_index_id, const SearchParam& vector_param,
+                                 const VectorWithId& target_vector, const HybridSearchParam& hybrid_param,
+                                 HybridSearchResult& out_result);
+
   Status DeleteByIndexId(int64_t index_id, const std::vector<int64_t>& doc_ids,
                          std::vector<DocDeleteResult>& out_result);
   Status DeleteByIndexName(int64_t schema_id, const std::string& index_name, const std::vector<int64_t>& doc_ids,
@@ -251,6 +334,15 @@ class DocumentClient {
   Status ScanQueryByIndexName(int64_t schema_id, const std::string& index_name, const DocScanQueryParam& query_param,
                               DocScanQueryResult& out_result);
 
+  // scan one page of at most max_scan_count documents in id order, only one page is kept in memory.
+  // pass empty page_token to start from the start id of query_param, then pass next_page_token with the same
+  // query_param to get the following page, the scan is finished when next_page_token is empty.
+  Status ScanQueryPageByIndexId(int64_t index_id, const DocScanQueryParam& query_param, const std::string& page_token,
+                                DocScanQueryResult& out_result, std::string& next_page_token);
+  Status ScanQueryPageByIndexName(int64_t schema_id, const std::string& index_name,
+                                  const DocScanQueryParam& query_param, const std::string& page_token,
+                                  DocScanQueryResult& out_result, std::string& next_page_token);
+
   Status GetIndexMetricsByIndexId(int64_t index_id, DocIndexMetricsResult& out_result);
   Status GetIndexMetricsByIndexName(int64_t schema_id, const std::string& index_name,
                                     DocIndexMetricsResult& out_result);
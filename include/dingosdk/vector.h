@@ -16,6 +16,7 @@
 #define DINGODB_SDK_VECTOR_H_
 
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -264,9 +265,9 @@ struct Vector {
 
 // TODO: maybe use std::variant, when swig support
 struct ScalarField {
-  bool bool_data;
-  int64_t long_data;
-  double double_data;
+  bool bool_data{false};
+  int64_t long_data{0};
+  double double_data{0.0};
   std::string string_data;
 };
 
@@ -298,6 +299,58 @@ struct VectorWithId {
   std::string ToString() const;
 };
 
+// one scalar column of VectorBatch, only the data array matching type is used, one value per row
+struct ScalarColumn {
+  Type type;
+  std::vector<bool> bool_data;
+  std::vector<int64_t> long_data;
+  std::vector<double> double_data;
+  std::vector<std::string> string_data;
+
+  explicit ScalarColumn() : type(kTypeEnd) {}
+
+  explicit ScalarColumn(Type p_type) : type(p_type) {}
+
+  int64_t Size() const;
+
+  std::string ToString() const;
+};
+
+// Columnar batch of vectors, all vectors share dimension and value_type.
+// Vector data is a contiguous row-major matrix:
+//   float vector: float_values holds rows * dimension floats
+//   binary vector: dimension is in bits, every row packs its bits into BinaryRowBytes() = (dimension + 7) / 8
+//   bytes of binary_values, same as Vector::binary_values of kUint8/kInt8 vectors
+// ids is one per row, when index enable auto_increment ids can be empty and will be filled by sdk.
+// scalar_columns maps scalar key to column, every column must have one value per row.
+struct VectorBatch {
+  int32_t dimension;
+  ValueType value_type;
+  std::vector<int64_t> ids;
+  std::vector<float> float_values;
+  std::vector<uint8_t> binary_values;
+  std::map<std::string, ScalarColumn> scalar_columns;
+
+  explicit VectorBatch() : dimension(0), value_type(kNoneValueType) {}
+
+  explicit VectorBatch(ValueType p_value_type, int32_t p_dimension)
+      : dimension(p_dimension), value_type(p_value_type) {}
+
+  VectorBatch(VectorBatch&& other) = default;
+  VectorBatch& operator=(VectorBatch&& other) = default;
+
+  VectorBatch(const VectorBatch& other) = default;
+  VectorBatch& operator=(const VectorBatch&) = default;
+
+  // bytes of one row in binary_values
+  int32_t BinaryRowBytes() const { return (dimension + 7) / 8; }
+
+  // rows of the batch, derived from vector data
+  int64_t Rows() const;
+
+  std::string ToString() const;
+};
+
 enum FilterSource : uint8_t {
   kNoneFilterSource,
   // filter vector scalar include post filter and pre filter
@@ -313,7 +366,11 @@ enum FilterType : uint8_t {
   // first vector search, then filter
   kQueryPost,
   // first search from rocksdb, then search vector
-  kQueryPre
+  kQueryPre,
+  // Search chooses pre or post filter by the selectivity of langchain_expr_json estimated on sampled vectors, post
+  // filter over-fetches topk by the selectivity. Vectors are sampled in background, searches use pre filter until
+  // the first sample is taken. Other APIs use the default filter type of the server
+  kQueryAuto
 };
 
 enum SearchExtraParamType : uint8_t { kParallelOnQueries, kNprobe, kRecallNum, kEfSearch };
@@ -334,7 +391,11 @@ struct SearchParam {
   bool use_brute_force{false};      // use brute-force search
   std::map<SearchExtraParamType, int32_t> extra_params;  // The search method to use
   std::string langchain_expr_json;                       // must json format, will convert to coprocessor
+  // values of {"param": "<name>"} in langchain_expr_json, read the field of the value_type declared in json,
+  // so one compiled filter is reused by queries with different values
+  std::map<std::string, ScalarField> langchain_expr_params;
   uint32_t beamwidth{2};
+  bool client_rerank{false};  // re-score merged candidates with exact distance on client, need with_vector_data
 
   explicit SearchParam() = default;
 
@@ -351,7 +412,9 @@ struct SearchParam {
         use_brute_force(other.use_brute_force),
         extra_params(std::move(other.extra_params)),
         langchain_expr_json(std::move(other.langchain_expr_json)),
-        beamwidth(other.beamwidth) {
+        langchain_expr_params(std::move(other.langchain_expr_params)),
+        beamwidth(other.beamwidth),
+        client_rerank(other.client_rerank) {
     other.topk = 0;
     other.with_vector_data = true;
     other.with_scalar_data = false;
@@ -362,6 +425,7 @@ struct SearchParam {
     other.filter_type = kNoneFilterType;
     other.use_brute_force = false;
     other.beamwidth = 2;
+    other.client_rerank = false;
   }
 
   SearchParam& operator=(SearchParam&& other) noexcept {
@@ -377,7 +441,9 @@ struct SearchParam {
     use_brute_force = other.use_brute_force;
     extra_params = std::move(other.extra_params);
     langchain_expr_json = std::move(other.langchain_expr_json);
+    langchain_expr_params = std::move(other.langchain_expr_params);
     beamwidth = other.beamwidth;
+    client_rerank = other.client_rerank;
 
     other.topk = 0;
     other.with_vector_data = true;
@@ -389,6 +455,7 @@ struct SearchParam {
     other.filter_type = kNoneFilterType;
     other.use_brute_force = false;
     other.beamwidth = 2;
+    other.client_rerank = false;
 
     return *this;
   }
@@ -410,6 +477,17 @@ struct VectorWithDistance {
   std::string ToString() const;
 };
 
+struct SearchCacheStats {
+  int64_t hits{0};
+  int64_t misses{0};
+  int64_t entries{0};
+  int64_t bytes{0};
+
+  double HitRate() const { return hits + misses == 0 ? 0 : static_cast<double>(hits) / (hits + misses); }
+
+  std::string ToString() const;
+};
+
 struct SearchResult {
   // TODO : maybe remove VectorWithId
   VectorWithId id;
@@ -433,6 +511,28 @@ struct SearchResult {
   std::string ToString() const;
 };
 
+// top-k of one region for each target vector, in the same order as target vectors
+using RegionSearchCallback = std::function<void(int64_t region_id, const std::vector<SearchResult>& region_results)>;
+
+struct StreamSearchOption {
+  // return once this fraction of regions responded, 1.0 means wait for all regions
+  double quorum_ratio{1.0};
+  // return with the regions responded so far when deadline passes, 0 means no deadline
+  int64_t deadline_ms{0};
+  // called as soon as a region responds, calls are serialized and never happen after search returned
+  RegionSearchCallback region_callback;
+};
+
+struct StreamSearchResult {
+  // merged top-k of the responded regions
+  std::vector<SearchResult> results;
+  // regions not waited for or failed, results of them are missing
+  std::vector<int64_t> skipped_region_ids;
+  int64_t region_count{0};
+
+  std::string ToString() const;
+};
+
 struct DeleteResult {
   int64_t vector_id;
   bool deleted;
@@ -528,6 +628,48 @@ struct IndexMetricsResult {
   std::string ToString() const;
 };
 
+struct BulkLoadProgress {
+  // vectors accepted by Add, include the skipped ones
+  int64_t submitted_count{0};
+  // vectors acknowledged by stores
+  int64_t added_count{0};
+  // vectors skipped because the checkpoint shows they were added by a previous load
+  int64_t skipped_count{0};
+  // vectors resent after region split or region not ready
+  int64_t retried_count{0};
+  int64_t rpc_count{0};
+  // request bytes acknowledged by stores
+  int64_t bytes{0};
+  int64_t elapsed_ms{0};
+  // all input vectors before this offset are added
+  int64_t checkpoint{0};
+
+  double VectorsPerSecond() const { return elapsed_ms > 0 ? added_count * 1000.0 / elapsed_ms : 0.0; }
+
+  std::string ToString() const;
+};
+
+using BulkLoadProgressCallback = std::function<void(const BulkLoadProgress& progress)>;
+
+struct BulkLoadOption {
+  // vectors buffered for one region before sent in one rpc, rpc size is also bounded by flag index_rpc_max_batch_bytes
+  int64_t batch_size{2048};
+  // max in-flight rpc to one store
+  int64_t max_in_flight_per_store{4};
+  // max rpc waiting or in flight, Add blocks when reached
+  int64_t max_pending_rpcs{256};
+  // ids fetched by one auto increment request, only used when index is auto increment
+  int64_t id_prefetch_count{100000};
+  // file to record the checkpoint, when the file exists the load resumes from it and Add skips the vectors added by
+  // previous load, so the same input must be replayed in the same order. empty means no checkpoint, it must be empty
+  // for auto increment index
+  std::string checkpoint_path;
+  int64_t checkpoint_interval_ms{5000};
+  // called on a rpc thread at most once per progress_interval_ms, it must not block
+  BulkLoadProgressCallback progress_callback;
+  int64_t progress_interval_ms{1000};
+};
+
 class VectorIndexCreator {
  public:
   ~VectorIndexCreator();
@@ -567,6 +709,38 @@ class VectorIndexCreator {
   explicit VectorIndexCreator(Data* data);
 };
 
+// Pipelined loader for a large stream of vectors, Add routes vectors to regions and returns once they are buffered
+// or sent, rpc to different stores run concurrently. Add and Flush must not be called concurrently.
+// A failed rpc which is fixed by re-route is resent, other errors are returned by the following Add or Flush.
+class VectorBulkLoader {
+ public:
+  VectorBulkLoader(const VectorBulkLoader&) = delete;
+  const VectorBulkLoader& operator=(const VectorBulkLoader&) = delete;
+
+  // vectors not flushed are dropped
+  ~VectorBulkLoader();
+
+  // for auto increment index, the id of vectors is filled
+  Status Add(std::vector<VectorWithId>& vectors);
+  Status Add(VectorBatch& batch);
+
+  // send buffered vectors, wait all rpc done and save checkpoint
+  Status Flush();
+
+  // number of leading input vectors added by previous load
+  int64_t ResumeOffset() const;
+
+  void GetProgress(BulkLoadProgress& progress);
+
+ private:
+  friend class VectorClient;
+
+  // own
+  class Data;
+  Data* data_;
+  explicit VectorBulkLoader(Data* data);
+};
+
 class VectorClient {
  public:
   VectorClient(const VectorClient&) = delete;
@@ -580,11 +754,35 @@ class VectorClient {
   Status UpsertByIndexId(int64_t index_id, std::vector<VectorWithId>& vectors);
   Status UpsertByIndexName(int64_t schema_id, const std::string& index_name, std::vector<VectorWithId>& vectors);
 
+  // columnar batch version of add/upsert/search, vectors are encoded to request without per-vector object
+  Status AddByIndexId(int64_t index_id, VectorBatch& batch);
+  Status AddByIndexName(int64_t schema_id, const std::string& index_name, VectorBatch& batch);
+
+  Status UpsertByIndexId(int64_t index_id, VectorBatch& batch);
+  Status UpsertByIndexName(int64_t schema_id, const std::string& index_name, VectorBatch& batch);
+
+  Status SearchByIndexId(int64_t index_id, const SearchParam& search_param, const VectorBatch& target_batch,
+                         std::vector<SearchResult>& out_result);
+  Status SearchByIndexName(int64_t schema_id, const std::string& index_name, const SearchParam& search_param,
+                           const VectorBatch& target_batch, std::vector<SearchResult>& out_result);
+
   Status SearchByIndexId(int64_t index_id, const SearchParam& search_param,
                          const std::vector<VectorWithId>& target_vectors, std::vector<SearchResult>& out_result);
   Status SearchByIndexName(int64_t schema_id, const std::string& index_name, const SearchParam& search_param,
                            const std::vector<VectorWithId>& target_vectors, std::vector<SearchResult>& out_result);
 
+  // deliver the top-k of each region as it responds, and may return before all regions responded, see
+  // StreamSearchOption
+  Status StreamSearchByIndexId(int64_t index_id, const SearchParam& search_param,
+                               const std::vector<VectorWithId>& target_vectors, const StreamSearchOption& option,
+                               StreamSearchResult& out_result);
+  Status StreamSearchByIndexName(int64_t schema_id, const std::string& index_name, const SearchParam& search_param,
+                                 const std::vector<VectorWithId>& target_vectors, const StreamSearchOption& option,
+                                 StreamSearchResult& out_result);
+
+  // search result cache of this client, enabled by flag vector_search_cache_capacity_mb
+  void GetSearchCacheStats(SearchCacheStats& stats);
+
   Status DeleteByIndexId(int64_t index_id, const std::vector<int64_t>& vector_ids,
                          std::vector<DeleteResult>& out_result);
   Status DeleteByIndexName(int64_t schema_id, const std::string& index_name, const std::vector<int64_t>& vector_ids,
@@ -601,6 +799,20 @@ class VectorClient {
   Status ScanQueryByIndexName(int64_t schema_id, const std::string& index_name, const ScanQueryParam& query_param,
                               ScanQueryResult& out_result);
 
+  // scan one page of at most max_scan_count vectors in id order, only one page is kept in memory.
+  // pass empty page_token to start from the start id of query_param, then pass next_page_token with the same
+  // query_param to get the following page, the scan is finished when next_page_token is empty.
+  Status ScanQueryPageByIndexId(int64_t index_id, const ScanQueryParam& query_param, const std::string& page_token,
+                                ScanQueryResult& out_result, std::string& next_page_token);
+  Status ScanQueryPageByIndexName(int64_t schema_id, const std::string& index_name,
+                                  const ScanQueryParam& query_param, const std::string& page_token,
+                                  ScanQueryResult& out_result, std::string& next_page_token);
+
+  // caller own the out_loader
+  Status NewBulkLoaderByIndexId(int64_t index_id, const BulkLoadOption& option, VectorBulkLoader** out_loader);
+  Status NewBulkLoaderByIndexName(int64_t schema_id, const std::string& index_name, const BulkLoadOption& option,
+                                  VectorBulkLoader** out_loader);
+
   Status GetIndexMetricsByIndexId(int64_t index_id, IndexMetricsResult& out_result);
   Status GetIndexMetricsByIndexName(int64_t schema_id, const std::string& index_name, IndexMetricsResult& out_result);
 
@@ -638,6 +850,8 @@ class VectorClient {
 
   Status ImportAddByIndexId(int64_t index_id, std::vector<VectorWithId>& vectors);
   Status ImportAddByIndexName(int64_t schema_id, const std::string& index_name, std::vector<VectorWithId>& vectors);
+  Status ImportAddByIndexId(int64_t index_id, VectorBatch& batch);
+  Status ImportAddByIndexName(int64_t schema_id, const std::string& index_name, VectorBatch& batch);
 
   Status ImportDeleteByIndexId(int64_t index_id, const std::vector<int64_t>& vector_ids);
   Status ImportDeleteByIndexName(int64_t schema_id, const std::string& index_name,
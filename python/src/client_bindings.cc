@@ -220,7 +220,9 @@ void DefineClientBindings(pybind11::module& m) {
       .def(py::init<>())
       .def_readwrite("kind", &TransactionOptions::kind)
       .def_readwrite("isolation", &TransactionOptions::isolation)
-      .def_readwrite("keep_alive_ms", &TransactionOptions::keep_alive_ms);
+      .def_readwrite("keep_alive_ms", &TransactionOptions::keep_alive_ms)
+      .def_readwrite("read_only", &TransactionOptions::read_only)
+      .def_readwrite("snapshot_ts", &TransactionOptions::snapshot_ts);
 
   py::class_<Transaction>(m, "Transaction")
       .def("Get",
@@ -70,7 +70,9 @@ void DefineDocumentBindings(pybind11::module& m) {
 
   py::class_<Document>(m, "Document")
       .def(py::init<>())
-      .def("AddField", &Document::AddField)
+      .def("AddField", py::overload_cast<const std::string&, const DocValue&>(&Document::AddField))
+      .def("GetField", &Document::GetField, py::return_value_policy::reference_internal)
+      .def("Fields", &Document::Fields)
       .def("GetFields", &Document::GetFields)
       .def("ToString", &Document::ToString);
 
@@ -102,7 +104,8 @@ void DefineDocumentBindings(pybind11::module& m) {
       .def_readwrite("column_names", &DocSearchParam::column_names)
       .def_readwrite("with_scalar_data", &DocSearchParam::with_scalar_data)
       .def_readwrite("selected_keys", &DocSearchParam::selected_keys)
-      .def_readwrite("query_limited", &DocSearchParam::query_limited);
+      .def_readwrite("query_limited", &DocSearchParam::query_limited)
+      .def_readwrite("page_size", &DocSearchParam::page_size);
 
   py::class_<DocWithStore>(m, "DocWithStore")
       .def(py::init<>())
@@ -115,6 +118,36 @@ void DefineDocumentBindings(pybind11::module& m) {
       .def_readwrite("doc_sores", &DocSearchResult::doc_sores)
       .def("ToString", &DocSearchResult::ToString);
 
+  py::enum_<HybridFusionType>(m, "HybridFusionType")
+      .value("kReciprocalRankFusion", HybridFusionType::kReciprocalRankFusion)
+      .value("kWeightedScoreFusion", HybridFusionType::kWeightedScoreFusion);
+
+  py::class_<HybridSearchParam>(m, "HybridSearchParam")
+      .def(py::init<>())
+      .def_readwrite("top_k", &HybridSearchParam::top_k)
+      .def_readwrite("fusion_type", &HybridSearchParam::fusion_type)
+      .def_readwrite("rrf_k", &HybridSearchParam::rrf_k)
+      .def_readwrite("text_weight", &HybridSearchParam::text_weight)
+      .def_readwrite("vector_weight", &HybridSearchParam::vector_weight)
+      .def_readwrite("with_scalar_data", &HybridSearchParam::with_scalar_data)
+      .def_readwrite("selected_keys", &HybridSearchParam::selected_keys);
+
+  py::class_<HybridSearchHit>(m, "HybridSearchHit")
+      .def(py::init<>())
+      .def_readwrite("id", &HybridSearchHit::id)
+      .def_readwrite("score", &HybridSearchHit::score)
+      .def_readwrite("text_rank", &HybridSearchHit::text_rank)
+      .def_readwrite("vector_rank", &HybridSearchHit::vector_rank)
+      .def_readwrite("text_score", &HybridSearchHit::text_score)
+      .def_readwrite("vector_distance", &HybridSearchHit::vector_distance)
+      .def_readwrite("doc", &HybridSearchHit::doc)
+      .def("ToString", &HybridSearchHit::ToString);
+
+  py::class_<HybridSearchResult>(m, "HybridSearchResult")
+      .def(py::init<>())
+      .def_readwrite("hits", &HybridSearchResult::hits)
+      .def("ToString", &HybridSearchResult::ToString);
+
   py::class_<DocDeleteResult>(m, "DocDeleteResult")
       .def(py::init<>())
       .def_readwrite("doc_id", &DocDeleteResult::doc_id)
@@ -194,6 +227,43 @@ void DefineDocumentBindings(pybind11::module& m) {
              Status status = documentclient.SearchAllByIndexName(schema_id, index_name, search_param, out_result);
              return std::make_tuple(status, out_result);
            })
+      .def("SearchAllPageByIndexId",
+           [](DocumentClient& documentclient, int64_t index_id, const DocSearchParam& search_param,
+              const std::string& page_token) {
+             DocSearchResult out_result;
+             std::string next_page_token;
+             Status status =
+                 documentclient.SearchAllPageByIndexId(index_id, search_param, page_token, out_result, next_page_token);
+             return std::make_tuple(status, out_result, next_page_token);
+           })
+      .def("SearchAllPageByIndexName",
+           [](DocumentClient& documentclient, int64_t schema_id, const std::string& index_name,
+              const DocSearchParam& search_param, const std::string& page_token) {
+             DocSearchResult out_result;
+             std::string next_page_token;
+             Status status = documentclient.SearchAllPageByIndexName(schema_id, index_name, search_param, page_token,
+                                                                     out_result, next_page_token);
+             return std::make_tuple(status, out_result, next_page_token);
+           })
+      .def("HybridSearchByIndexId",
+           [](DocumentClient& documentclient, int64_t index_id, const DocSearchParam& doc_param,
+              int64_t vector_index_id, const SearchParam& vector_param, const VectorWithId& target_vector,
+              const HybridSearchParam& hybrid_param) {
+             HybridSearchResult out_result;
+             Status status = documentclient.HybridSearchByIndexId(index_id, doc_param, vector_index_id, vector_param,
+                                                                  target_vector, hybrid_param, out_result);
+             return std::make_tuple(status, out_result);
+           })
+      .def("HybridSearchByIndexName",
+           [](DocumentClient& documentclient, int64_t schema_id, const std::string& index_name,
+              const DocSearchParam& doc_param, int64_t vector_index_id, const SearchParam& vector_param,
+              const VectorWithId& target_vector, const HybridSearchParam& hybrid_param) {
+             HybridSearchResult out_result;
+             Status status = documentclient.HybridSearchByIndexName(schema_id, index_name, doc_param, vector_index_id,
+                                                                    vector_param, target_vector, hybrid_param,
+                                                                    out_result);
+             return std::make_tuple(status, out_result);
+           })
       .def("DeleteByIndexId",
            [](DocumentClient& documentclient, int64_t index_id, const std::vector<int64_t>& doc_ids) {
              std::vector<DocDeleteResult> out_result;
@@ -245,6 +315,24 @@ void DefineDocumentBindings(pybind11::module& m) {
              Status status = documentclient.ScanQueryByIndexName(schema_id, index_name, query_param, out_result);
              return std::make_tuple(status, out_result);
            })
+      .def("ScanQueryPageByIndexId",
+           [](DocumentClient& documentclient, int64_t index_id, const DocScanQueryParam& query_param,
+              const std::string& page_token) {
+             DocScanQueryResult out_result;
+             std::string next_page_token;
+             Status status =
+                 documentclient.ScanQueryPageByIndexId(index_id, query_param, page_token, out_result, next_page_token);
+             return std::make_tuple(status, out_result, next_page_token);
+           })
+      .def("ScanQueryPageByIndexName",
+           [](DocumentClient& documentclient, int64_t schema_id, const std::string& index_name,
+              const DocScanQueryParam& query_param, const std::string& page_token) {
+             DocScanQueryResult out_result;
+             std::string next_page_token;
+             Status status = documentclient.ScanQueryPageByIndexName(schema_id, index_name, query_param, page_token,
+                                                                     out_result, next_page_token);
+             return std::make_tuple(status, out_result, next_page_token);
+           })
       .def("GetIndexMetricsByIndexId",
            [](DocumentClient& documentclient, int64_t index_id) {
              DocIndexMetricsResult out_result;
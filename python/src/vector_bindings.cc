@@ -16,6 +16,7 @@
 #include "vector_bindings.h"
 
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -195,6 +196,42 @@ py::class_<BinaryIvfFlatParam>(m, "BinaryIvfFlatParam")
       .def_readwrite("vector", &VectorWithId::vector)
       .def_readwrite("scalar_data", &VectorWithId::scalar_data);
 
+  py::class_<ScalarColumn>(m, "ScalarColumn")
+      .def(py::init<>())
+      .def(py::init<Type>())
+      .def("Size", &ScalarColumn::Size)
+      .def("ToString", &ScalarColumn::ToString)
+      .def_readwrite("type", &ScalarColumn::type)
+      .def_readwrite("bool_data", &ScalarColumn::bool_data)
+      .def_readwrite("long_data", &ScalarColumn::long_data)
+      .def_readwrite("double_data", &ScalarColumn::double_data)
+      .def_readwrite("string_data", &ScalarColumn::string_data);
+
+  py::class_<VectorBatch>(m, "VectorBatch")
+      .def(py::init<>())
+      .def(py::init<ValueType, int32_t>())
+      .def("Rows", &VectorBatch::Rows)
+      .def("ToString", &VectorBatch::ToString)
+      .def_readwrite("dimension", &VectorBatch::dimension)
+      .def_readwrite("value_type", &VectorBatch::value_type)
+      .def_readwrite("ids", &VectorBatch::ids)
+      .def_readwrite("float_values", &VectorBatch::float_values)
+      .def_readwrite("binary_values", &VectorBatch::binary_values)
+      .def_readwrite("scalar_columns", &VectorBatch::scalar_columns)
+      // copy numpy arrays in one memcpy instead of converting element by element
+      .def("SetIds",
+           [](VectorBatch& batch, py::array_t<int64_t, py::array::c_style | py::array::forcecast> ids) {
+             batch.ids.assign(ids.data(), ids.data() + ids.size());
+           })
+      .def("SetFloatValues",
+           [](VectorBatch& batch, py::array_t<float, py::array::c_style | py::array::forcecast> values) {
+             batch.float_values.assign(values.data(), values.data() + values.size());
+           })
+      .def("SetBinaryValues",
+           [](VectorBatch& batch, py::array_t<uint8_t, py::array::c_style | py::array::forcecast> values) {
+             batch.binary_values.assign(values.data(), values.data() + values.size());
+           });
+
   py::enum_<FilterSource>(m, "FilterSource")
       .value("kNoneFilterSource", FilterSource::kNoneFilterSource)
       .value("kScalarFilter", FilterSource::kScalarFilter)
@@ -204,7 +241,8 @@ py::class_<BinaryIvfFlatParam>(m, "BinaryIvfFlatParam")
   py::enum_<FilterType>(m, "FilterType")
       .value("kNoneFilterType", FilterType::kNoneFilterType)
       .value("kQueryPost", FilterType::kQueryPost)
-      .value("kQueryPre", FilterType::kQueryPre);
+      .value("kQueryPre", FilterType::kQueryPre)
+      .value("kQueryAuto", FilterType::kQueryAuto);
 
   py::enum_<SearchExtraParamType>(m, "SearchExtraParamType")
       .value("kParallelOnQueries", SearchExtraParamType::kParallelOnQueries)
@@ -229,7 +267,9 @@ py::class_<BinaryIvfFlatParam>(m, "BinaryIvfFlatParam")
       .def_readwrite("use_brute_force", &SearchParam::use_brute_force)
       .def_readwrite("extra_params", &SearchParam::extra_params)
       .def_readwrite("langchain_expr_json", &SearchParam::langchain_expr_json)
-      .def_readwrite("beamwidth", &SearchParam::beamwidth);
+      .def_readwrite("langchain_expr_params", &SearchParam::langchain_expr_params)
+      .def_readwrite("beamwidth", &SearchParam::beamwidth)
+      .def_readwrite("client_rerank", &SearchParam::client_rerank);
 
   py::class_<VectorWithDistance>(m, "VectorWithDistance")
       .def(py::init<>())
@@ -245,6 +285,28 @@ py::class_<BinaryIvfFlatParam>(m, "BinaryIvfFlatParam")
       .def_readwrite("id", &SearchResult::id)
       .def_readwrite("vector_datas", &SearchResult::vector_datas);
 
+  py::class_<StreamSearchOption>(m, "StreamSearchOption")
+      .def(py::init<>())
+      .def_readwrite("quorum_ratio", &StreamSearchOption::quorum_ratio)
+      .def_readwrite("deadline_ms", &StreamSearchOption::deadline_ms)
+      .def_readwrite("region_callback", &StreamSearchOption::region_callback);
+
+  py::class_<StreamSearchResult>(m, "StreamSearchResult")
+      .def(py::init<>())
+      .def("ToString", &StreamSearchResult::ToString)
+      .def_readwrite("results", &StreamSearchResult::results)
+      .def_readwrite("skipped_region_ids", &StreamSearchResult::skipped_region_ids)
+      .def_readwrite("region_count", &StreamSearchResult::region_count);
+
+  py::class_<SearchCacheStats>(m, "SearchCacheStats")
+      .def(py::init<>())
+      .def("ToString", &SearchCacheStats::ToString)
+      .def("HitRate", &SearchCacheStats::HitRate)
+      .def_readwrite("hits", &SearchCacheStats::hits)
+      .def_readwrite("misses", &SearchCacheStats::misses)
+      .def_readwrite("entries", &SearchCacheStats::entries)
+      .def_readwrite("bytes", &SearchCacheStats::bytes);
+
   py::class_<DeleteResult>(m, "DeleteResult")
       .def(py::init<>())
       .def("ToString", &DeleteResult::ToString)
@@ -292,6 +354,58 @@ py::class_<BinaryIvfFlatParam>(m, "BinaryIvfFlatParam")
       .def_readwrite("min_vector_id", &IndexMetricsResult::min_vector_id)
       .def_readwrite("memory_bytes", &IndexMetricsResult::memory_bytes);
 
+  py::class_<BulkLoadProgress>(m, "BulkLoadProgress")
+      .def(py::init<>())
+      .def("ToString", &BulkLoadProgress::ToString)
+      .def("VectorsPerSecond", &BulkLoadProgress::VectorsPerSecond)
+      .def_readwrite("submitted_count", &BulkLoadProgress::submitted_count)
+      .def_readwrite("added_count", &BulkLoadProgress::added_count)
+      .def_readwrite("skipped_count", &BulkLoadProgress::skipped_count)
+      .def_readwrite("retried_count", &BulkLoadProgress::retried_count)
+      .def_readwrite("rpc_count", &BulkLoadProgress::rpc_count)
+      .def_readwrite("bytes", &BulkLoadProgress::bytes)
+      .def_readwrite("elapsed_ms", &BulkLoadProgress::elapsed_ms)
+      .def_readwrite("checkpoint", &BulkLoadProgress::checkpoint);
+
+  py::class_<BulkLoadOption>(m, "BulkLoadOption")
+      .def(py::init<>())
+      .def_readwrite("batch_size", &BulkLoadOption::batch_size)
+      .def_readwrite("max_in_flight_per_store", &BulkLoadOption::max_in_flight_per_store)
+      .def_readwrite("max_pending_rpcs", &BulkLoadOption::max_pending_rpcs)
+      .def_readwrite("id_prefetch_count", &BulkLoadOption::id_prefetch_count)
+      .def_readwrite("checkpoint_path", &BulkLoadOption::checkpoint_path)
+      .def_readwrite("checkpoint_interval_ms", &BulkLoadOption::checkpoint_interval_ms)
+      .def_readwrite("progress_callback", &BulkLoadOption::progress_callback)
+      .def_readwrite("progress_interval_ms", &BulkLoadOption::progress_interval_ms);
+
+  py::class_<VectorBulkLoader>(m, "VectorBulkLoader")
+      .def("Add",
+           [](VectorBulkLoader& loader, std::vector<VectorWithId>& vectors) {
+             Status status;
+             {
+               // progress_callback is called from rpc threads, it takes the gil by itself
+               py::gil_scoped_release release;
+               status = loader.Add(vectors);
+             }
+             return std::make_tuple(status, vectors);
+           })
+      .def("Add",
+           [](VectorBulkLoader& loader, VectorBatch& batch) {
+             Status status;
+             {
+               py::gil_scoped_release release;
+               status = loader.Add(batch);
+             }
+             return std::make_tuple(status, batch.ids);
+           })
+      .def("Flush", &VectorBulkLoader::Flush, py::call_guard<py::gil_scoped_release>())
+      .def("ResumeOffset", &VectorBulkLoader::ResumeOffset)
+      .def("GetProgress", [](VectorBulkLoader& loader) {
+        BulkLoadProgress progress;
+        loader.GetProgress(progress);
+        return progress;
+      });
+
   py::class_<VectorIndexCreator>(m, "VectorIndexCreator")
       .def("SetSchemaId", &VectorIndexCreator::SetSchemaId)
       .def("SetName", &VectorIndexCreator::SetName)
@@ -325,6 +439,16 @@ py::class_<BinaryIvfFlatParam>(m, "BinaryIvfFlatParam")
              Status status = vectorclient.AddByIndexName(schema_id, index_name, vectors);
              return std::make_tuple(status, vectors);
            })
+      .def("AddByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, VectorBatch& batch) {
+             Status status = vectorclient.AddByIndexId(index_id, batch);
+             return std::make_tuple(status, batch.ids);
+           })
+      .def("AddByIndexName",
+           [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name, VectorBatch& batch) {
+             Status status = vectorclient.AddByIndexName(schema_id, index_name, batch);
+             return std::make_tuple(status, batch.ids);
+           })
       .def("UpsertByIndexId",
            [](VectorClient& vectorclient, int64_t index_id, std::vector<VectorWithId>& vectors) {
              Status status = vectorclient.UpsertByIndexId(index_id, vectors);
@@ -336,6 +460,29 @@ py::class_<BinaryIvfFlatParam>(m, "BinaryIvfFlatParam")
              Status status = vectorclient.UpsertByIndexName(schema_id, index_name, vectors);
              return std::make_tuple(status, vectors);
            })
+      .def("UpsertByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, VectorBatch& batch) {
+             return vectorclient.UpsertByIndexId(index_id, batch);
+           })
+      .def("UpsertByIndexName",
+           [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name, VectorBatch& batch) {
+             return vectorclient.UpsertByIndexName(schema_id, index_name, batch);
+           })
+      .def("SearchByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, const SearchParam& search_param,
+              const VectorBatch& target_batch) {
+             std::vector<SearchResult> out_result;
+             Status status = vectorclient.SearchByIndexId(index_id, search_param, target_batch, out_result);
+             return std::make_tuple(status, out_result);
+           })
+      .def("SearchByIndexName",
+           [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name,
+              const SearchParam& search_param, const VectorBatch& target_batch) {
+             std::vector<SearchResult> out_result;
+             Status status =
+                 vectorclient.SearchByIndexName(schema_id, index_name, search_param, target_batch, out_result);
+             return std::make_tuple(status, out_result);
+           })
       .def("SearchByIndexId",
            [](VectorClient& vectorclient, int64_t index_id, const SearchParam& search_param,
               const std::vector<VectorWithId>& target_vectors) {
@@ -402,6 +549,68 @@ py::class_<BinaryIvfFlatParam>(m, "BinaryIvfFlatParam")
              Status status = vectorclient.ScanQueryByIndexName(schema_id, index_name, query_param, out_result);
              return std::make_tuple(status, out_result);
            })
+      .def("ScanQueryPageByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, const ScanQueryParam& query_param,
+              const std::string& page_token) {
+             ScanQueryResult out_result;
+             std::string next_page_token;
+             Status status =
+                 vectorclient.ScanQueryPageByIndexId(index_id, query_param, page_token, out_result, next_page_token);
+             return std::make_tuple(status, out_result, next_page_token);
+           })
+      .def("ScanQueryPageByIndexName",
+           [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name,
+              const ScanQueryParam& query_param, const std::string& page_token) {
+             ScanQueryResult out_result;
+             std::string next_page_token;
+             Status status = vectorclient.ScanQueryPageByIndexName(schema_id, index_name, query_param, page_token,
+                                                                   out_result, next_page_token);
+             return std::make_tuple(status, out_result, next_page_token);
+           })
+      .def("StreamSearchByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, const SearchParam& search_param,
+              const std::vector<VectorWithId>& target_vectors, const StreamSearchOption& option) {
+             StreamSearchResult out_result;
+             Status status;
+             {
+               // region_callback is called from rpc threads, it takes the gil by itself
+               py::gil_scoped_release release;
+               status = vectorclient.StreamSearchByIndexId(index_id, search_param, target_vectors, option, out_result);
+             }
+             return std::make_tuple(status, out_result);
+           })
+      .def("StreamSearchByIndexName",
+           [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name,
+              const SearchParam& search_param, const std::vector<VectorWithId>& target_vectors,
+              const StreamSearchOption& option) {
+             StreamSearchResult out_result;
+             Status status;
+             {
+               py::gil_scoped_release release;
+               status = vectorclient.StreamSearchByIndexName(schema_id, index_name, search_param, target_vectors,
+                                                             option, out_result);
+             }
+             return std::make_tuple(status, out_result);
+           })
+      .def("GetSearchCacheStats",
+           [](VectorClient& vectorclient) {
+             SearchCacheStats stats;
+             vectorclient.GetSearchCacheStats(stats);
+             return stats;
+           })
+      .def("NewBulkLoaderByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, const BulkLoadOption& option) {
+             VectorBulkLoader* ptr = nullptr;
+             Status status = vectorclient.NewBulkLoaderByIndexId(index_id, option, &ptr);
+             return std::make_tuple(status, ptr);
+           })
+      .def("NewBulkLoaderByIndexName",
+           [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name,
+              const BulkLoadOption& option) {
+             VectorBulkLoader* ptr = nullptr;
+             Status status = vectorclient.NewBulkLoaderByIndexName(schema_id, index_name, option, &ptr);
+             return std::make_tuple(status, ptr);
+           })
       .def("GetIndexMetricsByIndexId",
            [](VectorClient& vectorclient, int64_t index_id) {
              IndexMetricsResult out_result;
@@ -551,6 +760,16 @@ py::class_<BinaryIvfFlatParam>(m, "BinaryIvfFlatParam")
              Status status = vectorclient.ImportAddByIndexName(schema_id, index_name, vectors);
              return std::make_tuple(status, vectors);
            })
+      .def("ImportAddByIndexId",
+           [](VectorClient& vectorclient, int64_t index_id, VectorBatch& batch) {
+             Status status = vectorclient.ImportAddByIndexId(index_id, batch);
+             return std::make_tuple(status, batch.ids);
+           })
+      .def("ImportAddByIndexName",
+           [](VectorClient& vectorclient, int64_t schema_id, const std::string& index_name, VectorBatch& batch) {
+             Status status = vectorclient.ImportAddByIndexName(schema_id, index_name, batch);
+             return std::make_tuple(status, batch.ids);
+           })
       .def("ImportDeleteByIndexId",
            [](VectorClient& vectorclient, int64_t index_id, const std::vector<int64_t>& vector_ids) {
              Status status = vectorclient.ImportDeleteByIndexId(index_id, vector_ids);
@@ -112,6 +112,7 @@ DEFINE_bool(with_vector_data, true, "Vector search flag with_vector_data");
 DEFINE_bool(with_scalar_data, false, "Vector search flag with_scalar_data");
 DEFINE_bool(with_table_data, false, "Vector search flag with_table_data");
 DEFINE_bool(vector_search_use_brute_force, false, "Vector search flag use_brute_force");
+DEFINE_bool(vector_search_client_rerank, false, "Vector search flag client_rerank");
 DEFINE_bool(vector_search_enable_range_search, false, "Vector search flag enable_range_search");
 DEFINE_double(vector_search_radius, 0.1, "Vector search flag radius");
 
@@ -1009,6 +1010,9 @@ void Environment::PrintParam() {
   std::cout << fmt::format("{:<34}: {:>32}", "vector_search_use_brute_force",
                            FLAGS_vector_search_use_brute_force ? "true" : "false")
             << '\n';
+  std::cout << fmt::format("{:<34}: {:>32}", "vector_search_client_rerank",
+                           FLAGS_vector_search_client_rerank ? "true" : "false")
+            << '\n';
   std::cout << fmt::format("{:<34}: {:>32}", "vector_search_enable_range_search",
                            FLAGS_vector_search_enable_range_search ? "true" : "false")
             << '\n';
@@ -73,6 +73,7 @@ static std::string GetUsageMessage() {
   message += "\n  --with_scalar_data vector search flag with_scalar_data, default(false)";
   message += "\n  --with_table_data vector search flag with_table_data, default(false)";
   message += "\n  --vector_search_use_brute_force vector search flag use_brute_force, default(false)";
+  message += "\n  --vector_search_client_rerank vector search flag client_rerank, default(false)";
   message += "\n  --vector_search_enable_range_search vector search flag enable_range_search, default(false)";
   message += "\n  --vector_search_radius vector search flag radius, default(0.1)";
   message += "\n  --vector_search_nprobe vector search flag nprobe, default(80)";
@@ -64,6 +64,7 @@ DECLARE_bool(with_vector_data);
 DECLARE_bool(with_scalar_data);
 DECLARE_bool(with_table_data);
 DECLARE_bool(vector_search_use_brute_force);
+DECLARE_bool(vector_search_client_rerank);
 DECLARE_bool(vector_search_enable_range_search);
 DECLARE_double(vector_search_radius);
 DEFINE_string(vector_search_filter_type, "", "Vector search filter type, e.g. pre/post");
@@ -1145,6 +1146,7 @@ Operation::Result VectorSearchOperation::ExecuteAutoData(VectorIndexEntryPtr ent
   search_param.with_scalar_data = FLAGS_with_scalar_data;
   search_param.with_table_data = FLAGS_with_table_data;
   search_param.use_brute_force = FLAGS_vector_search_use_brute_force;
+  search_param.client_rerank = FLAGS_vector_search_client_rerank;
 
   if (FLAGS_vector_search_enable_range_search) {
     search_param.radius = FLAGS_vector_search_radius;
@@ -1227,6 +1229,7 @@ Operation::Result VectorSearchOperation::ExecuteManualData(VectorIndexEntryPtr e
   search_param.with_scalar_data = FLAGS_with_scalar_data;
   search_param.with_table_data = FLAGS_with_table_data;
   search_param.use_brute_force = FLAGS_vector_search_use_brute_force;
+  search_param.client_rerank = FLAGS_vector_search_client_rerank;
   search_param.topk = FLAGS_vector_search_topk;
 
   if (FLAGS_vector_index_type == "IVF_FLAT" || FLAGS_vector_index_type == "IVF_PQ") {
@@ -14,27 +14,26 @@
 
 #include "sdk/auto_increment_manager.h"
 
-#include <condition_variable>
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <tuple>
 #include <utility>
 
+#include "common/logging.h"
 #include "dingosdk/status.h"
 #include "glog/logging.h"
 #include "sdk/client_stub.h"
 #include "sdk/common/param_config.h"
 #include "sdk/rpc/coordinator_rpc.h"
+#include "sdk/utils/actuator.h"
 
 namespace dingodb {
 
 namespace sdk {
 
-struct AutoIncrementer::Req {
-  explicit Req() = default;
-  std::condition_variable cv;
-};
-
 Status AutoIncrementer::GetNextId(int64_t& next) {
   std::vector<int64_t> ids;
   DINGO_RETURN_NOT_OK(GetNextIds(ids, 1));
@@ -43,76 +42,137 @@ Status AutoIncrementer::GetNextId(int64_t& next) {
   return Status::OK();
 }
 
-Status AutoIncrementer::GetNextIds(std::vector<int64_t>& to_fill, int64_t count) {
-  CHECK_GT(count, 0);
-
-  return RunOperation([this, &to_fill, &count]() {
-    Status s;
-    while (s.ok() && count > 0) {
-      if (id_cache_.size() < count) {
-        s = RefillCache();
-      } else {
-        to_fill.insert(to_fill.end(), id_cache_.begin(), id_cache_.begin() + count);
-        id_cache_.erase(id_cache_.begin(), id_cache_.begin() + count);
-        count = 0;
+bool AutoIncrementer::TakeAll(IdRange& range, int64_t count, std::vector<int64_t>& to_fill) {
+  int64_t next = range.next.load(std::memory_order_relaxed);
+  while (next + count <= range.end) {
+    if (range.next.compare_exchange_weak(next, next + count, std::memory_order_relaxed)) {
+      for (int64_t i = 0; i < count; i++) {
+        to_fill.push_back(next + i);
       }
+      return true;
     }
-    return s;
-  });
+  }
+  return false;
 }
 
-Status AutoIncrementer::GetAutoIncrementId(int64_t& start_id) {
-  return RunOperation([this, &start_id]() {
-    Status s;
-    while (s.ok()) {
-      if (id_cache_.empty()) {
-        s = RefillCache();
-      } else {
-        start_id = id_cache_.front();
-        break;
+int64_t AutoIncrementer::TakeSome(IdRange& range, int64_t count, std::vector<int64_t>& to_fill) {
+  int64_t next = range.next.load(std::memory_order_relaxed);
+  while (next < range.end) {
+    int64_t take = std::min(count, range.end - next);
+    if (range.next.compare_exchange_weak(next, next + take, std::memory_order_relaxed)) {
+      for (int64_t i = 0; i < take; i++) {
+        to_fill.push_back(next + i);
       }
+      return take;
     }
-    return s;
-  });
+  }
+  return 0;
 }
 
-Status AutoIncrementer::UpdateAutoIncrementId(int64_t start_id) {
-  CHECK_GT(start_id, 0);
+Status AutoIncrementer::GetNextIds(std::vector<int64_t>& to_fill, int64_t count) {
+  CHECK_GT(count, 0);
 
-  return RunOperation([this, start_id]() {
-    UpdateAutoIncrementRpc rpc;
-    PrepareUpdateAutoIncrementRequest(*rpc.MutableRequest(), start_id);
-    DINGO_RETURN_NOT_OK(stub_.GetMetaRpcController()->SyncCall(rpc));
-    VLOG(kSdkVlogLevel) << "UpdateAutoIncrement request:" << rpc.Request()->DebugString()
-                        << " response:" << rpc.Response()->DebugString();
-    id_cache_.clear();
+  std::shared_ptr<IdRange> range = std::atomic_load(&current_);
+  if (range != nullptr && TakeAll(*range, count, to_fill)) {
+    MaybePrefetch(*range);
     return Status::OK();
-  });
-}
+  }
 
-Status AutoIncrementer::RunOperation(std::function<Status()> operation) {
-  Req req;
   {
     std::unique_lock<std::mutex> lk(mutex_);
-    queue_.push_back(&req);
-    while (&req != queue_.front()) {
-      req.cv.wait(lk);
+    size_t origin_size = to_fill.size();
+    while (count > 0) {
+      // other caller may have installed a new range while waiting for the mutex
+      range = std::atomic_load(&current_);
+      if (range != nullptr) {
+        count -= TakeSome(*range, count, to_fill);
+        if (count == 0) {
+          break;
+        }
+      }
+
+      int64_t start = 0;
+      int64_t end = 0;
+      Status s = NextRangeUnlocked(count, start, end);
+      if (!s.ok()) {
+        // ids already taken from the current range are dropped and leave a gap, the caller gets all or none
+        to_fill.resize(origin_size);
+        return s;
+      }
+
+      // take ids before publish the range, so ids of this call stay consecutive when ranges are adjacent
+      int64_t take = std::min(count, end - start);
+      for (int64_t i = 0; i < take; i++) {
+        to_fill.push_back(start + i);
+      }
+      count -= take;
+
+      range = std::make_shared<IdRange>(start + take, end);
+      std::atomic_store(&current_, range);
     }
   }
-  Status s = operation();
-  {
-    std::unique_lock<std::mutex> lk(mutex_);
-    queue_.pop_front();
-    if (!queue_.empty()) {
-      queue_.front()->cv.notify_one();
+
+  MaybePrefetch(*range);
+  return Status::OK();
+}
+
+Status AutoIncrementer::GetAutoIncrementId(int64_t& start_id) {
+  std::shared_ptr<IdRange> range = std::atomic_load(&current_);
+  if (range != nullptr) {
+    int64_t next = range->next.load(std::memory_order_relaxed);
+    if (next < range->end) {
+      start_id = next;
+      return Status::OK();
+    }
+  }
+
+  std::unique_lock<std::mutex> lk(mutex_);
+  while (true) {
+    range = std::atomic_load(&current_);
+    if (range != nullptr) {
+      int64_t next = range->next.load(std::memory_order_relaxed);
+      if (next < range->end) {
+        start_id = next;
+        return Status::OK();
+      }
     }
+
+    int64_t start = 0;
+    int64_t end = 0;
+    DINGO_RETURN_NOT_OK(NextRangeUnlocked(1, start, end));
+    std::atomic_store(&current_, std::make_shared<IdRange>(start, end));
   }
-  return s;
 }
 
-Status AutoIncrementer::RefillCache() {
+Status AutoIncrementer::UpdateAutoIncrementId(int64_t start_id) {
+  CHECK_GT(start_id, 0);
+
+  std::unique_lock<std::mutex> lk(mutex_);
+  UpdateAutoIncrementRpc rpc;
+  PrepareUpdateAutoIncrementRequest(*rpc.MutableRequest(), start_id);
+  DINGO_RETURN_NOT_OK(stub_.GetMetaRpcController()->SyncCall(rpc));
+  VLOG(kSdkVlogLevel) << "UpdateAutoIncrement request:" << rpc.Request()->DebugString()
+                      << " response:" << rpc.Response()->DebugString();
+
+  // callers which loaded the old range before it is unpublished must not take ids from it after update
+  std::shared_ptr<IdRange> old = std::atomic_load(&current_);
+  if (old != nullptr) {
+    old->next.store(old->end, std::memory_order_relaxed);
+  }
+  std::atomic_store(&current_, std::shared_ptr<IdRange>());
+  ranges_.clear();
+  cached_count_ = 0;
+  generation_++;
+  return Status::OK();
+}
+
+Status AutoIncrementer::FetchRange(int64_t min_count, int64_t& start, int64_t& end) {
   GenerateAutoIncrementRpc rpc;
   PrepareGenerateAutoIncrementRequest(*rpc.MutableRequest());
+  // large batch is fetched by one request instead of many requests of flag auto_incre_req_count
+  if (rpc.Request()->count() < min_count) {
+    rpc.MutableRequest()->set_count(min_count);
+  }
 
   DINGO_RETURN_NOT_OK(stub_.GetMetaRpcController()->SyncCall(rpc));
   VLOG(kSdkVlogLevel) << "GenerateAutoIncrement request:" << rpc.Request()->DebugString()
@@ -122,12 +182,80 @@ Status AutoIncrementer::RefillCache() {
   const auto* request = rpc.Request();
   CHECK_GT(response->end_id(), response->start_id())
       << " request:" << request->DebugString() << " response: " << response->DebugString();
-  for (int64_t i = response->start_id(); i < response->end_id(); i++) {
-    id_cache_.push_back(i);
-  }
+  start = response->start_id();
+  end = response->end_id();
   return Status::OK();
 }
 
+Status AutoIncrementer::NextRangeUnlocked(int64_t min_count, int64_t& start, int64_t& end) {
+  if (!ranges_.empty()) {
+    std::tie(start, end) = ranges_.front();
+    ranges_.pop_front();
+    cached_count_ -= end - start;
+    return Status::OK();
+  }
+
+  return FetchRange(min_count, start, end);
+}
+
+void AutoIncrementer::MaybePrefetch(const IdRange& range) {
+  if (FLAGS_auto_incre_prefetch_ratio <= 0) {
+    return;
+  }
+
+  auto low_watermark = static_cast<int64_t>(FLAGS_auto_incre_req_count * FLAGS_auto_incre_prefetch_ratio);
+  if (range.Remain() >= low_watermark) {
+    return;
+  }
+
+  // not owned by shared_ptr, nothing keeps it alive for the background fetch
+  std::weak_ptr<AutoIncrementer> weak_self = weak_from_this();
+  if (weak_self.expired()) {
+    return;
+  }
+
+  int64_t generation = 0;
+  {
+    // the caller holding the mutex is switching range, it checks again after that
+    std::unique_lock<std::mutex> lk(mutex_, std::try_to_lock);
+    if (!lk.owns_lock() || prefetching_ || range.Remain() + cached_count_ >= low_watermark) {
+      return;
+    }
+    prefetching_ = true;
+    generation = generation_;
+  }
+
+  bool scheduled = stub_.GetActuator()->Schedule(
+      [weak_self, generation] {
+        auto self = weak_self.lock();
+        if (self != nullptr) {
+          self->Prefetch(generation);
+        }
+      },
+      0);
+
+  if (!scheduled) {
+    std::unique_lock<std::mutex> lk(mutex_);
+    prefetching_ = false;
+  }
+}
+
+void AutoIncrementer::Prefetch(int64_t generation) {
+  int64_t start = 0;
+  int64_t end = 0;
+  Status s = FetchRange(FLAGS_auto_incre_req_count, start, end);
+  if (!s.ok()) {
+    DINGO_LOG(WARNING) << "prefetch auto increment id fail, status: " << s.ToString();
+  }
+
+  std::unique_lock<std::mutex> lk(mutex_);
+  prefetching_ = false;
+  if (s.ok() && generation == generation_) {
+    ranges_.emplace_back(start, end);
+    cached_count_ += end - start;
+  }
+}
+
 void VectorIndexAutoInrementer::PrepareGenerateAutoIncrementRequest(pb::meta::GenerateAutoIncrementRequest& request) {
   *request.mutable_table_id() = vector_index_->GetIndexDefWithId().index_id();
   request.set_count(FLAGS_auto_incre_req_count);
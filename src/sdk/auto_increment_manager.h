@@ -15,11 +15,14 @@
 #ifndef DINGODB_SDK_AUTO_INCREMENT_MANAGER_H_
 #define DINGODB_SDK_AUTO_INCREMENT_MANAGER_H_
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <deque>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "dingosdk/status.h"
@@ -32,7 +35,11 @@ namespace sdk {
 
 class ClientStub;
 
-class AutoIncrementer {
+// Ids are cached as [start, end) ranges fetched from meta server. GetNextIds takes ids from the current range by
+// atomic compare-and-swap, only the caller which finds the current range exhausted takes the mutex to install the next
+// range. When cached ids drop below flag auto_incre_prefetch_ratio of auto_incre_req_count, the next range is fetched
+// in background, so callers seldom wait for meta server.
+class AutoIncrementer : public std::enable_shared_from_this<AutoIncrementer> {
  public:
   AutoIncrementer(const ClientStub& stub) : stub_(stub) {}
 
@@ -40,6 +47,7 @@ class AutoIncrementer {
 
   Status GetNextId(int64_t& next);
 
+  // ids of one call are consecutive unless they cross two fetched ranges, on error to_fill is left unchanged
   Status GetNextIds(std::vector<int64_t>& to_fill, int64_t count);
 
   Status GetAutoIncrementId(int64_t& start_id);
@@ -52,15 +60,42 @@ class AutoIncrementer {
 
  private:
   friend class AutoIncrementerManager;
-  Status RefillCache();
-  Status RunOperation(std::function<Status()> operation);
+
+  struct IdRange {
+    IdRange(int64_t p_next, int64_t p_end) : next(p_next), end(p_end) {}
+
+    std::atomic<int64_t> next;
+    const int64_t end;
+
+    int64_t Remain() const { return std::max(end - next.load(std::memory_order_relaxed), static_cast<int64_t>(0)); }
+  };
+
+  // take count ids only when range has enough ids
+  static bool TakeAll(IdRange& range, int64_t count, std::vector<int64_t>& to_fill);
+  // take at most count ids, return the number taken
+  static int64_t TakeSome(IdRange& range, int64_t count, std::vector<int64_t>& to_fill);
+
+  // fetch one range of at least min_count ids from meta server
+  Status FetchRange(int64_t min_count, int64_t& start, int64_t& end);
+
+  // pop a cached range or fetch one, must hold mutex_
+  Status NextRangeUnlocked(int64_t min_count, int64_t& start, int64_t& end);
+
+  void MaybePrefetch(const IdRange& range);
+  void Prefetch(int64_t generation);
 
   const ClientStub& stub_;
 
+  // accessed by std::atomic_load and std::atomic_store
+  std::shared_ptr<IdRange> current_;
+
+  // protect the members below, serialize range switch and update
   std::mutex mutex_;
-  struct Req;
-  std::deque<Req*> queue_;
-  std::vector<int64_t> id_cache_;
+  std::deque<std::pair<int64_t, int64_t>> ranges_;
+  int64_t cached_count_{0};
+  bool prefetching_{false};
+  // bumped by update, range prefetched before it is dropped
+  int64_t generation_{0};
 };
 
 class VectorIndexAutoInrementer : public AutoIncrementer {
@@ -25,6 +25,7 @@
 #include "sdk/rpc/rpc_client.h"
 #include "sdk/transaction/txn_lock_resolver.h"
 #include "sdk/transaction/txn_region_scanner_impl.h"
+#include "sdk/transaction/txn_status_cache.h"
 #include "sdk/utils/net_util.h"
 #include "sdk/utils/thread_pool_actuator.h"
 
@@ -66,11 +67,20 @@ Status ClientStub::Open(const std::vector<EndPoint>& endpoints) {
 
   txn_lock_resolver_ = std::make_shared<TxnLockResolver>(*(this));
 
+  txn_status_cache_ = std::make_shared<TxnStatusCache>(FLAGS_txn_status_cache_capacity);
+
   actuator_ = std::make_shared<ThreadPoolActuator>();
   actuator_->Start(FLAGS_actuator_thread_num);
 
   vector_index_cache_ = std::make_shared<VectorIndexCache>(*this);
 
+  vector_search_cache_ = std::make_shared<VectorSearchCache>(FLAGS_vector_search_cache_capacity_mb * 1024 * 1024,
+                                                             FLAGS_vector_search_cache_ttl_ms,
+                                                             FLAGS_vector_search_cache_quantize_step);
+
+  vector_search_coalescer_ = std::make_shared<VectorSearchCoalescer>(FLAGS_vector_search_coalesce_window_us,
+                                                                     FLAGS_vector_search_coalesce_max_batch);
+
   document_index_cache_ = std::make_shared<DocumentIndexCache>(*this);
 
   auto_increment_manager_ = std::make_shared<AutoIncrementerManager>(*this);
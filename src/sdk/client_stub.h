@@ -26,7 +26,10 @@
 #include "sdk/rpc/coordinator_rpc_controller.h"
 #include "sdk/rpc/rpc_client.h"
 #include "sdk/transaction/txn_lock_resolver.h"
+#include "sdk/transaction/txn_status_cache.h"
 #include "sdk/vector/vector_index_cache.h"
+#include "sdk/vector/vector_search_cache.h"
+#include "sdk/vector/vector_search_coalescer.h"
 #include "utils/actuator.h"
 
 namespace dingodb {
@@ -85,6 +88,11 @@ class ClientStub {
     return txn_lock_resolver_;
   }
 
+  virtual std::shared_ptr<TxnStatusCache> GetTxnStatusCache() const {
+    DCHECK_NOTNULL(txn_status_cache_.get());
+    return txn_status_cache_;
+  }
+
   virtual std::shared_ptr<Actuator> GetActuator() const {
     DCHECK_NOTNULL(actuator_.get());
     return actuator_;
@@ -95,6 +103,16 @@ class ClientStub {
     return vector_index_cache_;
   }
 
+  virtual std::shared_ptr<VectorSearchCache> GetVectorSearchCache() const {
+    DCHECK_NOTNULL(vector_search_cache_.get());
+    return vector_search_cache_;
+  }
+
+  virtual std::shared_ptr<VectorSearchCoalescer> GetVectorSearchCoalescer() const {
+    DCHECK_NOTNULL(vector_search_coalescer_.get());
+    return vector_search_coalescer_;
+  }
+
   virtual std::shared_ptr<DocumentIndexCache> GetDocumentIndexCache() const {
     DCHECK_NOTNULL(document_index_cache_.get());
     return document_index_cache_;
@@ -116,8 +134,11 @@ class ClientStub {
   std::shared_ptr<RegionScannerFactory> txn_region_scanner_factory_;
   std::shared_ptr<AdminTool> admin_tool_;
   std::shared_ptr<TxnLockResolver> txn_lock_resolver_;
+  std::shared_ptr<TxnStatusCache> txn_status_cache_;
   std::shared_ptr<Actuator> actuator_;
   std::shared_ptr<VectorIndexCache> vector_index_cache_;
+  std::shared_ptr<VectorSearchCache> vector_search_cache_;
+  std::shared_ptr<VectorSearchCoalescer> vector_search_coalescer_;
   std::shared_ptr<DocumentIndexCache> document_index_cache_;
   std::shared_ptr<AutoIncrementerManager> auto_increment_manager_;
 };
@@ -34,6 +34,13 @@ static int64_t Tso2Timestamp(pb::meta::TsoTimestamp tso) {
   return (tso.physical() << kPhysicalShiftBits) + tso.logical();
 }
 
+static pb::meta::TsoTimestamp Timestamp2Tso(int64_t ts) {
+  pb::meta::TsoTimestamp tso;
+  tso.set_physical(ts >> kPhysicalShiftBits);
+  tso.set_logical(ts & kLogicalMask);
+  return tso;
+}
+
 // if a == b, return 0
 // if a < b, return 1
 // if a > b, return -1
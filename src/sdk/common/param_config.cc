@@ -22,6 +22,9 @@ DEFINE_int64(actuator_thread_num, 8, "actuator thread num");
 DEFINE_int64(coordinator_interaction_delay_ms, 500, "coordinator interaction delay ms");
 DEFINE_int64(coordinator_interaction_max_retry, 30, "coordinator interaction max retry");
 DEFINE_int64(auto_incre_req_count, 1000, "raw kv max retry times");
+DEFINE_double(auto_incre_prefetch_ratio, 0.2,
+              "prefetch next auto increment ids in background when cached ids are less than this ratio of "
+              "auto_incre_req_count, 0 means disable");
 
 // ChannelOptions should set "timeout_ms > connect_timeout_ms" for circuit breaker
 DEFINE_int64(rpc_channel_timeout_ms, 500000, "rpc channel timeout ms");
@@ -47,6 +50,39 @@ DEFINE_int64(raw_kv_max_retry, 10, "raw kv max retry times");
 DEFINE_int64(vector_op_delay_ms, 500, "vector task base backoff delay ms");
 DEFINE_int64(vector_op_max_retry, 30, "vector task max retry times");
 
+DEFINE_int64(index_rpc_max_batch_count, 2048, "max vectors or documents in one rpc of index write task");
+DEFINE_int64(index_rpc_max_batch_bytes, 8 * 1024 * 1024, "max request bytes in one rpc of index write task");
+DEFINE_int64(index_rpc_max_in_flight, 32, "max in-flight rpc of one index write task");
+
+DEFINE_int64(vector_search_cache_capacity_mb, 0, "vector search result cache capacity mb, 0 means disable");
+DEFINE_int64(vector_search_cache_ttl_ms, 5000, "vector search result cache ttl ms");
+DEFINE_double(vector_search_cache_quantize_step, 1e-6, "query float values within one step share search cache entry");
+
+DEFINE_int64(vector_search_coalesce_window_us, 0,
+             "max wait us to merge concurrent searches of same index and param into one task, 0 means disable");
+DEFINE_int64(vector_search_coalesce_max_batch, 64, "max query vectors of one merged vector search");
+DEFINE_int64(vector_search_late_materialize_min_regions, 0,
+             "search with payload over at least this many regions gets only ids and distances from regions, then "
+             "fetch payload of the merged top-k by batch query, 0 means disable");
+
+DEFINE_int64(langchain_filter_cache_capacity, 1024,
+             "max compiled langchain filters cached per vector index, cache is cleared when full, 0 means disable");
+
+DEFINE_int64(vector_filter_sample_per_region, 64,
+             "vectors scanned from every region to estimate filter selectivity of auto filter type search");
+DEFINE_int64(vector_filter_sample_ttl_s, 300, "sampled scalar data of a vector index is refreshed after this seconds");
+DEFINE_int64(vector_filter_auto_max_overfetch, 10,
+             "auto filter type uses post filter when topk over-fetched by 1 / selectivity is within this factor, "
+             "otherwise pre filter");
+
+DEFINE_int64(scan_query_page_parallel_regions, 4, "regions scanned concurrently by one page of cursor scan query");
+
 DEFINE_int64(txn_max_batch_count, 1000, "txn max batch count");
+DEFINE_int64(txn_status_cache_capacity, 10240,
+             "max committed or rollbacked txn status cached to skip checking txn status when resolve lock, "
+             "0 means disable");
+DEFINE_int64(txn_parallel_scan_regions, 8, "regions scanned concurrently by one read only txn scan");
+DEFINE_int64(txn_lock_resolve_max_parallel, 16,
+             "max txn status checks or resolve rpcs running concurrently in one batch lock resolve");
 
 DEFINE_bool(log_rpc_time, false, "log rpc time");
@@ -30,6 +30,7 @@ const int64_t kPrefetchRegionCount = 3;
 DECLARE_int64(coordinator_interaction_delay_ms);
 DECLARE_int64(coordinator_interaction_max_retry);
 DECLARE_int64(auto_incre_req_count);
+DECLARE_double(auto_incre_prefetch_ratio);
 
 // store config
 // ChannelOptions should set "timeout_ms > connect_timeout_ms" for circuit breaker
@@ -61,7 +62,30 @@ DECLARE_int64(txn_op_max_retry);
 DECLARE_int64(vector_op_delay_ms);
 DECLARE_int64(vector_op_max_retry);
 
+DECLARE_int64(index_rpc_max_batch_count);
+DECLARE_int64(index_rpc_max_batch_bytes);
+DECLARE_int64(index_rpc_max_in_flight);
+
+DECLARE_int64(vector_search_cache_capacity_mb);
+DECLARE_int64(vector_search_cache_ttl_ms);
+DECLARE_double(vector_search_cache_quantize_step);
+
+DECLARE_int64(vector_search_coalesce_window_us);
+DECLARE_int64(vector_search_coalesce_max_batch);
+DECLARE_int64(vector_search_late_materialize_min_regions);
+
+DECLARE_int64(langchain_filter_cache_capacity);
+
+DECLARE_int64(vector_filter_sample_per_region);
+DECLARE_int64(vector_filter_sample_ttl_s);
+DECLARE_int64(vector_filter_auto_max_overfetch);
+
+DECLARE_int64(scan_query_page_parallel_regions);
+
 DECLARE_int64(txn_max_batch_count);
+DECLARE_int64(txn_status_cache_capacity);
+DECLARE_int64(txn_parallel_scan_regions);
+DECLARE_int64(txn_lock_resolve_max_parallel);
 DECLARE_bool(log_rpc_time);
 
 #endif  // DINGODB_SDK_PARAM_CONFIG_H_
\ No newline at end of file
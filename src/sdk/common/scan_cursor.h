@@ -0,0 +1,90 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_SCAN_CURSOR_H_
+#define DINGODB_SDK_SCAN_CURSOR_H_
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dingosdk/status.h"
+#include "sdk/client_stub.h"
+#include "sdk/region.h"
+
+namespace dingodb {
+namespace sdk {
+namespace scan_cursor {
+
+// page token of cursor scan only holds the id to resume from, empty token means the scan is finished
+inline std::string EncodeToken(int64_t next_id) { return std::to_string(next_id); }
+
+inline Status DecodeToken(const std::string& token, int64_t& next_id) {
+  errno = 0;
+  char* end = nullptr;
+  next_id = std::strtoll(token.c_str(), &end, 10);
+  if (token.empty() || errno != 0 || *end != '\0' || next_id <= 0) {
+    return Status::InvalidArgument("invalid page token: " + token);
+  }
+  return Status::OK();
+}
+
+// Regions of an id range partitioned index in scan order, from the region which holds cursor_id to the last one.
+// Index is VectorIndex or DocumentIndex, their partition ids are in ascending id order.
+template <class Index, class ToRangeKey>
+Status OrderedRegions(const ClientStub& stub, const Index& index, int64_t cursor_id, bool is_reverse,
+                      ToRangeKey to_range_key, std::vector<std::shared_ptr<Region>>& regions) {
+  int64_t cursor_part_id = index.GetPartitionId(cursor_id);
+  std::string cursor_key = to_range_key(index, cursor_id);
+
+  auto part_ids = index.GetPartitionIds();
+  if (is_reverse) {
+    std::reverse(part_ids.begin(), part_ids.end());
+  }
+
+  auto iter = std::find(part_ids.begin(), part_ids.end(), cursor_part_id);
+  for (; iter != part_ids.end(); iter++) {
+    const auto& range = index.GetPartitionRange(*iter);
+    std::vector<std::shared_ptr<Region>> part_regions;
+    DINGO_RETURN_NOT_OK(
+        stub.GetMetaCache()->ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), part_regions));
+    if (is_reverse) {
+      std::reverse(part_regions.begin(), part_regions.end());
+    }
+
+    for (auto& region : part_regions) {
+      if (*iter == cursor_part_id) {
+        // regions of cursor partition which are entirely behind the cursor
+        const auto& region_range = region->Range();
+        if ((!is_reverse && region_range.end_key() <= cursor_key) ||
+            (is_reverse && region_range.start_key() > cursor_key)) {
+          continue;
+        }
+      }
+      regions.push_back(std::move(region));
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace scan_cursor
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_SCAN_CURSOR_H_
@@ -23,6 +23,7 @@
 #include "sdk/document/document_index.h"
 #include "sdk/document/document_task.h"
 #include "sdk/rpc/document_service_rpc.h"
+#include "sdk/rpc/rpc_batch.h"
 #include "sdk/rpc/store_rpc_controller.h"
 
 namespace dingodb {
@@ -55,7 +56,7 @@ class DocumentAddTask : public DocumentTask {
   std::unordered_map<int64_t, int64_t> doc_id_to_idx_;
   Status status_;
 
-  std::atomic<int> sub_tasks_count_{0};
+  RpcWindow window_;
 };
 
 }  // namespace sdk
@@ -23,6 +23,7 @@
 #include "sdk/document/document_get_auto_increment_id_task.h"
 #include "sdk/document/document_get_border_task.h"
 #include "sdk/document/document_get_index_metrics_task.h"
+#include "sdk/document/document_hybrid_search_task.h"
 #include "sdk/document/document_index_cache.h"
 #include "sdk/document/document_scan_query_task.h"
 #include "sdk/document/document_search_all_task.h"
@@ -99,6 +100,45 @@ Status DocumentClient::SearchAllByIndexName(int64_t schema_id, const std::string
   return task.Run();
 }
 
+Status DocumentClient::SearchAllPageByIndexId(int64_t index_id, const DocSearchParam& search_param,
+                                              const std::string& page_token, DocSearchResult& out_result,
+                                              std::string& next_page_token) {
+  DocumentSearchAllPageTask task(stub_, index_id, search_param, page_token, out_result, next_page_token);
+  return task.Run();
+}
+
+Status DocumentClient::SearchAllPageByIndexName(int64_t schema_id, const std::string& index_name,
+                                                const DocSearchParam& search_param, const std::string& page_token,
+                                                DocSearchResult& out_result, std::string& next_page_token) {
+  int64_t index_id{0};
+  DINGO_RETURN_NOT_OK(
+      stub_.GetDocumentIndexCache()->GetIndexIdByKey(EncodeDocumentIndexCacheKey(schema_id, index_name), index_id));
+  CHECK_GT(index_id, 0);
+  DocumentSearchAllPageTask task(stub_, index_id, search_param, page_token, out_result, next_page_token);
+  return task.Run();
+}
+
+Status DocumentClient::HybridSearchByIndexId(int64_t index_id, const DocSearchParam& doc_param, int64_t vector_index_id,
+                                             const SearchParam& vector_param, const VectorWithId& target_vector,
+                                             const HybridSearchParam& hybrid_param, HybridSearchResult& out_result) {
+  DocumentHybridSearchTask task(stub_, index_id, doc_param, vector_index_id, vector_param, target_vector, hybrid_param,
+                                out_result);
+  return task.Run();
+}
+
+Status DocumentClient::HybridSearchByIndexName(int64_t schema_id, const std::string& index_name,
+                                               const DocSearchParam& doc_param, int64_t vector_index_id,
+                                               const SearchParam& vector_param, const VectorWithId& target_vector,
+                                               const HybridSearchParam& hybrid_param, HybridSearchResult& out_result) {
+  int64_t index_id{0};
+  DINGO_RETURN_NOT_OK(
+      stub_.GetDocumentIndexCache()->GetIndexIdByKey(EncodeDocumentIndexCacheKey(schema_id, index_name), index_id));
+  CHECK_GT(index_id, 0);
+  DocumentHybridSearchTask task(stub_, index_id, doc_param, vector_index_id, vector_param, target_vector, hybrid_param,
+                                out_result);
+  return task.Run();
+}
+
 Status DocumentClient::DeleteByIndexId(int64_t index_id, const std::vector<int64_t>& doc_ids,
                                        std::vector<DocDeleteResult>& out_result) {
   DocumentDeleteTask task(stub_, index_id, doc_ids, out_result);
@@ -163,6 +203,24 @@ Status DocumentClient::ScanQueryByIndexName(int64_t schema_id, const std::string
   return task.Run();
 }
 
+Status DocumentClient::ScanQueryPageByIndexId(int64_t index_id, const DocScanQueryParam& query_param,
+                                              const std::string& page_token, DocScanQueryResult& out_result,
+                                              std::string& next_page_token) {
+  DocumentScanQueryPageTask task(stub_, index_id, query_param, page_token, out_result, next_page_token);
+  return task.Run();
+}
+
+Status DocumentClient::ScanQueryPageByIndexName(int64_t schema_id, const std::string& index_name,
+                                                const DocScanQueryParam& query_param, const std::string& page_token,
+                                                DocScanQueryResult& out_result, std::string& next_page_token) {
+  int64_t index_id{0};
+  DINGO_RETURN_NOT_OK(
+      stub_.GetDocumentIndexCache()->GetIndexIdByKey(EncodeDocumentIndexCacheKey(schema_id, index_name), index_id));
+  CHECK_GT(index_id, 0);
+  DocumentScanQueryPageTask task(stub_, index_id, query_param, page_token, out_result, next_page_token);
+  return task.Run();
+}
+
 Status DocumentClient::GetIndexMetricsByIndexId(int64_t index_id, DocIndexMetricsResult& out_result) {
   DocumentGetIndexMetricsTask task(stub_, index_id, out_result);
   return task.Run();
@@ -20,6 +20,7 @@
 #include "common/logging.h"
 #include "glog/logging.h"
 #include "sdk/utils/codec.h"
+#include "sdk/utils/key_codec.h"
 #include "serial/schema/long_schema.h"
 
 namespace dingodb {
@@ -45,18 +46,20 @@ static void EncodeDocumentKey(char prefix, int64_t partition_id, int64_t doc_id,
   CHECK(prefix != 0) << "Encode Document key failed, prefix is 0, partition_id:[" << partition_id << "], doc_id:["
                      << doc_id << "]";
 
-  // Buf buf(17);
-  Buf buf(kDocumentKeyMaxLenWithPrefix);
-  buf.Write(prefix);
-  buf.WriteLong(partition_id);
-  DingoSchema<std::optional<int64_t>>::InternalEncodeKey(&buf, doc_id);
-  buf.GetBytes(result);
+  result.resize(kDocumentKeyMaxLenWithPrefix);
+  key_codec::EncodeIdKey(prefix, partition_id, doc_id, result.data());
+}
+
+// encode keys of count ids in the partition back to back into keys, without allocation per key
+static void EncodeDocumentKeys(char prefix, int64_t partition_id, const int64_t* ids, size_t count,
+                              key_codec::IdKeyBuffer& keys) {
+  CHECK(prefix != 0) << "Encode Document keys failed, prefix is 0, partition_id:[" << partition_id << "]";
+  keys.Append(prefix, partition_id, ids, count);
 }
 
 static int64_t DecodeDocumentId(const std::string& value) {
-  Buf buf(value);
   if (value.size() >= kDocumentKeyMaxLenWithPrefix) {
-    buf.Skip(9);
+    return key_codec::DecodeIdKey(value.data());
   } else if (value.size() == kDocumentKeyMinLenWithPrefix) {
     return 0;
   } else {
@@ -64,8 +67,6 @@ static int64_t DecodeDocumentId(const std::string& value) {
                      << codec::BytesToHexString(value) << "]";
     return 0;
   }
-
-  return DingoSchema<std::optional<int64_t>>::InternalDecodeKey(&buf);
 }
 
 static int64_t DecodePartitionId(const std::string& value) {
@@ -58,21 +58,38 @@ void DocumentDeleteTask::DoAsync() {
 
   auto meta_cache = stub.GetMetaCache();
 
-  for (const auto& id : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(document_helper::DocumentIdToRangeKey(*doc_index_, id), tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    };
-
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
+  // sorted ids are routed by the id intervals of the index, meta cache is only asked for uncached ranges
+  std::vector<int64_t> ids(next_batch.begin(), next_batch.end());
+
+  std::vector<std::shared_ptr<Region>> regions;
+  Status s = doc_index_->GetIdRegionMap().Route(*meta_cache, ids, regions);
+
+  for (size_t i = 0; i < ids.size(); i++) {
+    int64_t id = ids[i];
+    const auto& region = regions[i];
+    if (region == nullptr) {
+      // keep the id pending and route the others, it is resent in next round
+      DINGO_LOG(WARNING) << "lookup region fail, id: " << id << ", status: " << s.ToString();
+      Status lookup_status = RegionLookupStatus(s);
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      if (status_.ok() || (IsRetryError(status_) && !IsRetryError(lookup_status))) {
+        status_ = lookup_status;
+      }
+      continue;
     }
 
-    region_vectors_to_ids[tmp->RegionId()].push_back(id);
+    region_id_to_region.try_emplace(region->RegionId(), region);
+    region_vectors_to_ids[region->RegionId()].push_back(id);
+  }
+
+  if (region_vectors_to_ids.empty()) {
+    Status tmp;
+    {
+      std::shared_lock<std::shared_mutex> r(rw_lock_);
+      tmp = status_;
+    }
+    DoAsyncDone(tmp);
+    return;
   }
 
   controllers_.clear();
@@ -117,8 +134,8 @@ void DocumentDeleteTask::DocumentDeleteRpcCallback(const Status& status, Documen
                        << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    if (status_.ok()) {
-      // only return first fail status
+    if (status_.ok() || (IsRetryError(status_) && !IsRetryError(status))) {
+      // return first fail status, a fatal one wins over errors which only need resend
       status_ = status;
     }
   } else {
@@ -127,6 +144,8 @@ void DocumentDeleteTask::DocumentDeleteRpcCallback(const Status& status, Documen
     for (auto i = 0; i < rpc->Response()->key_states_size(); i++) {
       int64_t id = rpc->Request()->ids(i);
       out_result_.push_back({id, rpc->Response()->key_states(i)});
+      // acked ids are not resent when other regions need retry
+      next_doc_ids_.erase(id);
     }
   }
 
@@ -0,0 +1,113 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/document/document_hybrid_fusion.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+
+// min-max normalize to [0, 1], all equal values are 1
+class MinMax {
+ public:
+  void Add(double value) {
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+
+  double Normalize(double value) const { return max_ > min_ ? (value - min_) / (max_ - min_) : 1.0; }
+
+ private:
+  double min_{std::numeric_limits<double>::max()};
+  double max_{std::numeric_limits<double>::lowest()};
+};
+
+// store reports every metric as a distance, inner product and cosine included, smaller is nearer
+double VectorSimilarity(const VectorWithDistance& candidate) { return -candidate.distance; }
+
+}  // namespace
+
+std::vector<HybridSearchHit> FuseHybridCandidates(const HybridSearchParam& param,
+                                                  const std::vector<DocWithStore>& text_candidates,
+                                                  const std::vector<VectorWithDistance>& vector_candidates) {
+  std::vector<HybridSearchHit> hits;
+  hits.reserve(text_candidates.size() + vector_candidates.size());
+  std::unordered_map<int64_t, int64_t> id_to_idx;
+  id_to_idx.reserve(hits.capacity());
+
+  auto hit_of = [&](int64_t id) -> HybridSearchHit& {
+    auto [iter, inserted] = id_to_idx.try_emplace(id, hits.size());
+    if (inserted) {
+      hits.emplace_back();
+      hits.back().id = id;
+      hits.back().doc.id = id;
+    }
+    return hits[iter->second];
+  };
+
+  MinMax text_range;
+  for (const auto& candidate : text_candidates) {
+    text_range.Add(candidate.score);
+  }
+  MinMax vector_range;
+  for (const auto& candidate : vector_candidates) {
+    vector_range.Add(VectorSimilarity(candidate));
+  }
+
+  bool rrf = param.fusion_type == kReciprocalRankFusion;
+  for (int32_t i = 0; i < text_candidates.size(); i++) {
+    const auto& candidate = text_candidates[i];
+    auto& hit = hit_of(candidate.doc_with_id.id);
+    if (hit.text_rank != 0) {
+      continue;
+    }
+    hit.text_rank = i + 1;
+    hit.text_score = candidate.score;
+    hit.score +=
+        param.text_weight * (rrf ? 1.0 / (param.rrf_k + hit.text_rank) : text_range.Normalize(candidate.score));
+  }
+
+  for (int32_t i = 0; i < vector_candidates.size(); i++) {
+    const auto& candidate = vector_candidates[i];
+    auto& hit = hit_of(candidate.vector_data.id);
+    if (hit.vector_rank != 0) {
+      continue;
+    }
+    hit.vector_rank = i + 1;
+    hit.vector_distance = candidate.distance;
+    hit.score += param.vector_weight *
+                 (rrf ? 1.0 / (param.rrf_k + hit.vector_rank) : vector_range.Normalize(VectorSimilarity(candidate)));
+  }
+
+  auto better = [](const HybridSearchHit& a, const HybridSearchHit& b) {
+    return a.score > b.score || (a.score == b.score && a.id < b.id);
+  };
+  if (param.top_k > 0 && param.top_k < hits.size()) {
+    std::partial_sort(hits.begin(), hits.begin() + param.top_k, hits.end(), better);
+    hits.resize(param.top_k);
+  } else {
+    std::sort(hits.begin(), hits.end(), better);
+  }
+
+  return hits;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
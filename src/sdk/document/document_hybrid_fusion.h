@@ -12,28 +12,24 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#ifndef DINGODB_SDK_DOCUMENT_DOC_VALUE_INTERNAL_DATA_H_
-#define DINGODB_SDK_DOCUMENT_DOC_VALUE_INTERNAL_DATA_H_
+#ifndef DINGODB_SDK_DOCUMENT_HYBRID_FUSION_H_
+#define DINGODB_SDK_DOCUMENT_HYBRID_FUSION_H_
+
+#include <vector>
 
 #include "dingosdk/document.h"
-#include "dingosdk/types.h"
+#include "dingosdk/vector.h"
 
 namespace dingodb {
 namespace sdk {
 
-class DocValue::Data {
- public:
-  Type type{Type::kTypeEnd};
-
-  union {
-    int64_t int_val;
-    double double_val;
-    bool bool_val;
-  };
-  std::string string_val;
-};
+// Fuse full text and vector candidates by id, both lists are best first. Fused hits are sorted by score and equal
+// scores rank the smaller id first, at most top_k of them are returned. Documents of the hits are not filled.
+std::vector<HybridSearchHit> FuseHybridCandidates(const HybridSearchParam& param,
+                                                  const std::vector<DocWithStore>& text_candidates,
+                                                  const std::vector<VectorWithDistance>& vector_candidates);
 
 }  // namespace sdk
 }  // namespace dingodb
 
-#endif  // DINGODB_SDK_DOCUMENT_DOC_VALUE_INTERNAL_DATA_H_
\ No newline at end of file
+#endif  // DINGODB_SDK_DOCUMENT_HYBRID_FUSION_H_
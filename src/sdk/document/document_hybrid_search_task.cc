@@ -0,0 +1,164 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/document/document_hybrid_search_task.h"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include "common/logging.h"
+#include "glog/logging.h"
+#include "sdk/document/document_hybrid_fusion.h"
+
+namespace dingodb {
+namespace sdk {
+
+// SearchParam is move only, copy the fields of the candidate search and leave the payload out
+static void FillCandidateSearchParam(const SearchParam& from, SearchParam& to) {
+  to.topk = from.topk;
+  // client rerank computes exact distance from the returned vectors
+  to.with_vector_data = from.client_rerank;
+  to.with_scalar_data = false;
+  to.with_table_data = false;
+  to.enable_range_search = from.enable_range_search;
+  to.radius = from.radius;
+  to.filter_source = from.filter_source;
+  to.filter_type = from.filter_type;
+  to.is_negation = from.is_negation;
+  to.is_sorted = from.is_sorted;
+  to.vector_ids = from.vector_ids;
+  to.use_brute_force = from.use_brute_force;
+  to.extra_params = from.extra_params;
+  to.langchain_expr_json = from.langchain_expr_json;
+  to.langchain_expr_params = from.langchain_expr_params;
+  to.beamwidth = from.beamwidth;
+  to.client_rerank = from.client_rerank;
+}
+
+Status DocumentHybridSearchTask::Init() {
+  if (vector_index_id_ <= 0) {
+    return Status::InvalidArgument("vector_index_id must be greater than 0");
+  }
+
+  if (hybrid_param_.top_k < 0) {
+    return Status::InvalidArgument("top_k must be greater than or equal to 0");
+  }
+
+  if (hybrid_param_.rrf_k < 0) {
+    return Status::InvalidArgument("rrf_k must be greater than or equal to 0");
+  }
+
+  if (hybrid_param_.text_weight < 0 || hybrid_param_.vector_weight < 0) {
+    return Status::InvalidArgument("fusion weight must be greater than or equal to 0");
+  }
+
+  text_candidate_param_ = doc_param_;
+  text_candidate_param_.with_scalar_data = false;
+  text_candidate_param_.selected_keys.clear();
+  FillCandidateSearchParam(vector_param_, vector_candidate_param_);
+
+  return Status::OK();
+}
+
+void DocumentHybridSearchTask::DoAsync() {
+  {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    text_result_.doc_sores.clear();
+    vector_result_.clear();
+    status_ = Status::OK();
+  }
+
+  text_task_ = std::make_unique<DocumentSearchTask>(stub, index_id_, text_candidate_param_, text_result_);
+  vector_task_ = std::make_unique<VectorSearchTask>(stub, vector_index_id_, vector_candidate_param_, target_vectors_,
+                                                    vector_result_);
+
+  sub_tasks_count_.store(2);
+
+  text_task_->AsyncRun([this](auto&& s) { SubTaskCallback(std::forward<decltype(s)>(s)); });
+  vector_task_->AsyncRun([this](auto&& s) { SubTaskCallback(std::forward<decltype(s)>(s)); });
+}
+
+void DocumentHybridSearchTask::SubTaskCallback(const Status& status) {
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << "task: " << Name() << " candidate search fail: " << status.ToString();
+
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    if (status_.ok()) {
+      // only return first fail status
+      status_ = status;
+    }
+  }
+
+  if (sub_tasks_count_.fetch_sub(1) == 1) {
+    Status tmp;
+    {
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      tmp = status_;
+      if (tmp.ok()) {
+        static const std::vector<VectorWithDistance> kEmpty;
+        const auto& vector_candidates = vector_result_.empty() ? kEmpty : vector_result_[0].vector_datas;
+        out_result_.hits = FuseHybridCandidates(hybrid_param_, text_result_.doc_sores, vector_candidates);
+      }
+    }
+
+    if (!tmp.ok() || !hybrid_param_.with_scalar_data || out_result_.hits.empty()) {
+      DoAsyncDone(tmp);
+    } else {
+      FetchDocuments();
+    }
+  }
+}
+
+void DocumentHybridSearchTask::FetchDocuments() {
+  query_param_.doc_ids.clear();
+  query_param_.doc_ids.reserve(out_result_.hits.size());
+  for (const auto& hit : out_result_.hits) {
+    query_param_.doc_ids.push_back(hit.id);
+  }
+  query_param_.with_scalar_data = true;
+  query_param_.selected_keys = hybrid_param_.selected_keys;
+  query_result_.docs.clear();
+
+  query_task_ = std::make_unique<DocumentBatchQueryTask>(stub, index_id_, query_param_, query_result_);
+  query_task_->AsyncRun([this](auto&& s) { FetchDocumentsCallback(std::forward<decltype(s)>(s)); });
+}
+
+void DocumentHybridSearchTask::FetchDocumentsCallback(const Status& status) {
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << "task: " << Name() << " fetch documents fail: " << status.ToString();
+    DoAsyncDone(status);
+    return;
+  }
+
+  std::unordered_map<int64_t, DocWithId*> id_to_doc;
+  id_to_doc.reserve(query_result_.docs.size());
+  for (auto& doc : query_result_.docs) {
+    id_to_doc.emplace(doc.id, &doc);
+  }
+
+  // hits only found by vector search may have no document, they keep the id only
+  for (auto& hit : out_result_.hits) {
+    auto iter = id_to_doc.find(hit.id);
+    if (iter != id_to_doc.end()) {
+      hit.doc = std::move(*iter->second);
+    }
+  }
+
+  DoAsyncDone(Status::OK());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,100 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_DOCUMENT_HYBRID_SEARCH_TASK_H_
+#define DINGODB_SDK_DOCUMENT_HYBRID_SEARCH_TASK_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+#include "dingosdk/document.h"
+#include "dingosdk/status.h"
+#include "dingosdk/vector.h"
+#include "fmt/core.h"
+#include "sdk/client_stub.h"
+#include "sdk/document/document_batch_query_task.h"
+#include "sdk/document/document_search_task.h"
+#include "sdk/document/document_task.h"
+#include "sdk/vector/vector_search_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Run the full text search and the vector search concurrently without payload, fuse their candidates, then fetch
+// documents of the fused hits with one batch query, so payload is transferred only for the final hits.
+class DocumentHybridSearchTask : public DocumentTask {
+ public:
+  DocumentHybridSearchTask(const ClientStub& stub, int64_t index_id, const DocSearchParam& doc_param,
+                           int64_t vector_index_id, const SearchParam& vector_param,
+                           const VectorWithId& target_vector, const HybridSearchParam& hybrid_param,
+                           HybridSearchResult& out_result)
+      : DocumentTask(stub),
+        index_id_(index_id),
+        doc_param_(doc_param),
+        vector_index_id_(vector_index_id),
+        vector_param_(vector_param),
+        target_vectors_({target_vector}),
+        hybrid_param_(hybrid_param),
+        out_result_(out_result) {}
+
+  ~DocumentHybridSearchTask() override = default;
+
+ private:
+  Status Init() override;
+  void DoAsync() override;
+
+  std::string Name() const override {
+    return fmt::format("DocumentHybridSearchTask-{}-{}", index_id_, vector_index_id_);
+  }
+
+  void SubTaskCallback(const Status& status);
+
+  void FetchDocuments();
+
+  void FetchDocumentsCallback(const Status& status);
+
+  const int64_t index_id_;
+  const DocSearchParam& doc_param_;
+  const int64_t vector_index_id_;
+  const SearchParam& vector_param_;
+  const std::vector<VectorWithId> target_vectors_;
+  const HybridSearchParam& hybrid_param_;
+  HybridSearchResult& out_result_;
+
+  // candidate search params, same as the caller ones without payload
+  DocSearchParam text_candidate_param_;
+  SearchParam vector_candidate_param_;
+
+  std::unique_ptr<DocumentSearchTask> text_task_;
+  std::unique_ptr<VectorSearchTask> vector_task_;
+  DocSearchResult text_result_;
+  std::vector<SearchResult> vector_result_;
+
+  DocQueryParam query_param_;
+  std::unique_ptr<DocumentBatchQueryTask> query_task_;
+  DocQueryResult query_result_;
+
+  std::shared_mutex rw_lock_;
+  Status status_;
+
+  std::atomic<int> sub_tasks_count_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_DOCUMENT_HYBRID_SEARCH_TASK_H_
@@ -15,6 +15,7 @@
 #include "sdk/document/document_index.h"
 
 #include <cstdint>
+#include <memory>
 #include <sstream>
 
 #include "fmt/core.h"
@@ -40,6 +41,7 @@ DocumentIndex::DocumentIndex(pb::meta::IndexDefinitionWithId index_def_with_id)
     CHECK(start_key_to_part_id_.insert({start_id, part_id}).second);
     CHECK(part_id_to_range_.insert({part_id, partition.range()}).second);
   }
+  id_region_map_ = std::make_unique<IdRegionMap>(kDocumentPrefix, start_key_to_part_id_);
   GenerateScalarSchema();
   VLOG(kSdkVlogLevel) << "Init:" << ToString();
 }
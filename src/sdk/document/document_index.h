@@ -22,6 +22,7 @@
 #include "proto/meta.pb.h"
 #include "dingosdk/document.h"
 #include "dingosdk/types.h"
+#include "sdk/id_region_map.h"
 
 namespace dingodb {
 
@@ -61,6 +62,9 @@ class DocumentIndex {
 
   const pb::meta::IndexDefinitionWithId& GetIndexDefWithId() const { return index_def_with_id_; }
 
+  // routes ids of the index to regions by id intervals, lives as long as this index version
+  IdRegionMap& GetIdRegionMap() const { return *id_region_map_; }
+
   std::string ToString(bool verbose = false) const;
 
  private:
@@ -81,6 +85,7 @@ class DocumentIndex {
   // start_key is 0 or valid vector id
   std::map<int64_t, int64_t> start_key_to_part_id_;
   std::map<int64_t, pb::common::Range> part_id_to_range_;
+  std::unique_ptr<IdRegionMap> id_region_map_;
 
   std::unordered_map<std::string, Type> schema_;
 
@@ -18,109 +18,104 @@
 
 #include <memory>
 #include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
 
 #include "dingosdk/document.h"
 #include "dingosdk/types.h"
-#include "sdk/document/document_doc_value_internal.h"
 
 namespace dingodb {
 namespace sdk {
 
-DocValue::DocValue(const DocValue& other) : data_(new Data(*other.data_)) {}
-
-DocValue& DocValue::operator=(const DocValue& other) {
-  if (this != &other) {
-    data_ = std::make_unique<Data>(*other.data_);
-  }
-  return *this;
-}
-
-DocValue::DocValue() { data_ = std::make_unique<DocValue::Data>(); }
-
-DocValue::~DocValue() = default;
-
-DocValue::DocValue(DocValue&& other) noexcept : data_(std::move(other.data_)) {}
-
-DocValue& DocValue::operator=(DocValue&& other) noexcept {
-  if (this != &other) {
-    data_ = std::move(other.data_);
-  }
-  return *this;
-}
-
 DocValue DocValue::FromInt(int64_t val) {
   DocValue value;
-  value.data_->type = Type::kINT64;
-  value.data_->int_val = val;
+  value.type_ = Type::kINT64;
+  value.value_ = val;
   return value;
 }
 
 DocValue DocValue::FromDouble(double val) {
   DocValue value;
-  value.data_->type = Type::kDOUBLE;
-  value.data_->double_val = val;
+  value.type_ = Type::kDOUBLE;
+  value.value_ = val;
   return value;
 }
 
-DocValue DocValue::FromString(const std::string& val) {
+DocValue DocValue::FromString(std::string val) {
   DocValue value;
-  value.data_->type = Type::kSTRING;
-  value.data_->string_val = val;
+  value.type_ = Type::kSTRING;
+  value.value_ = std::move(val);
   return value;
 }
 
-DocValue DocValue::FromBytes(const std::string& val) {
+DocValue DocValue::FromBytes(std::string val) {
   DocValue value;
-  value.data_->type = Type::kBYTES;
-  value.data_->string_val = val;
+  value.type_ = Type::kBYTES;
+  value.value_ = std::move(val);
   return value;
 }
 
 DocValue DocValue::FromBool(bool val) {
   DocValue value;
-  value.data_->type = Type::kBOOL;
-  value.data_->bool_val = val;
+  value.type_ = Type::kBOOL;
+  value.value_ = val;
   return value;
 }
 
-DocValue DocValue::FromDatetime(const std::string& val) {
+DocValue DocValue::FromDatetime(std::string val) {
   DocValue value;
-  value.data_->type = Type::kDATETIME;
-  value.data_->string_val = val;
+  value.type_ = Type::kDATETIME;
+  value.value_ = std::move(val);
   return value;
 }
 
-Type DocValue::GetType() const { return data_->type; }
+int64_t DocValue::IntValue() const {
+  const auto* val = std::get_if<int64_t>(&value_);
+  return val != nullptr ? *val : 0;
+}
 
-int64_t DocValue::IntValue() const { return data_->int_val; }
+double DocValue::DoubleValue() const {
+  const auto* val = std::get_if<double>(&value_);
+  return val != nullptr ? *val : 0;
+}
 
-double DocValue::DoubleValue() const { return data_->double_val; }
+static const std::string kEmptyString;
 
-std::string DocValue::StringValue() const { return data_->string_val; }
+const std::string& DocValue::StringValue() const {
+  const auto* val = std::get_if<std::string>(&value_);
+  return val != nullptr ? *val : kEmptyString;
+}
 
-std::string DocValue::BytesValue() const { return data_->string_val; }
+const std::string& DocValue::BytesValue() const { return StringValue(); }
 
-bool DocValue::BoolValue() const { return data_->bool_val; }
+bool DocValue::BoolValue() const {
+  const auto* val = std::get_if<bool>(&value_);
+  return val != nullptr && *val;
+}
 
-std::string DocValue::DatetimeValue() const { return data_->string_val; }
+const std::string& DocValue::DatetimeValue() const { return StringValue(); }
 
 std::string DocValue::ToString() const {
   std::stringstream ss;
-  ss << "DocValue { type: " << TypeToString(data_->type) << ", value: ";
+  ss << "DocValue { type: " << TypeToString(type_) << ", value: ";
 
-  switch (data_->type) {
+  switch (type_) {
     case Type::kINT64:
-      ss << std::to_string(data_->int_val);
+      ss << std::to_string(IntValue());
+      break;
     case Type::kDOUBLE:
-      ss << std::to_string(data_->double_val);
+      ss << std::to_string(DoubleValue());
+      break;
     case Type::kSTRING:
-      ss << data_->string_val;
     case Type::kBYTES:
-      ss << data_->string_val;
-    case Type::kBOOL:
-      ss << data_->bool_val;
     case Type::kDATETIME:
-      ss << data_->string_val;
+      ss << StringValue();
+      break;
+    case Type::kBOOL:
+      ss << BoolValue();
+      break;
     default:
       ss << "";
   }
@@ -130,9 +125,30 @@ std::string DocValue::ToString() const {
   return ss.str();
 }
 
-void Document::AddField(const std::string& key, const DocValue& value) { fields_.emplace(key, value); }
+void Document::AddField(const std::string& key, const DocValue& value) {
+  if (GetField(key) == nullptr) {
+    fields_.emplace_back(key, value);
+  }
+}
 
-std::unordered_map<std::string, DocValue> Document::GetFields() const { return fields_; }
+void Document::AddField(std::string&& key, DocValue&& value) {
+  if (GetField(key) == nullptr) {
+    fields_.emplace_back(std::move(key), std::move(value));
+  }
+}
+
+const DocValue* Document::GetField(std::string_view key) const {
+  for (const auto& [field_key, value] : fields_) {
+    if (field_key == key) {
+      return &value;
+    }
+  }
+  return nullptr;
+}
+
+std::unordered_map<std::string, DocValue> Document::GetFields() const {
+  return std::unordered_map<std::string, DocValue>(fields_.begin(), fields_.end());
+}
 
 std::string Document::ToString() const {
   std::string result = "Document {";
@@ -181,6 +197,27 @@ std::string DocSearchResult::ToString() const {
   return oss.str();
 }
 
+std::string HybridSearchHit::ToString() const {
+  std::ostringstream oss;
+  oss << "HybridSearchHit{id: " << id << ", score: " << score << ", text_rank: " << text_rank
+      << ", vector_rank: " << vector_rank << ", text_score: " << text_score << ", vector_distance: " << vector_distance
+      << ", doc: " << doc.ToString() << "}";
+  return oss.str();
+}
+
+std::string HybridSearchResult::ToString() const {
+  std::ostringstream oss;
+  oss << "HybridSearchResult{hits: [";
+  for (auto it = hits.begin(); it != hits.end(); ++it) {
+    if (it != hits.begin()) {
+      oss << ", ";
+    }
+    oss << it->ToString();
+  }
+  oss << "]}";
+  return oss.str();
+}
+
 std::string DocDeleteResult::ToString() const {
   std::ostringstream oss;
   oss << "DocDeleteResult{doc_id: " << doc_id << ", deleted: " << (deleted ? "true" : "false") << "}";
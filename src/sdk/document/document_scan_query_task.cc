@@ -14,8 +14,13 @@
 
 #include "sdk/document/document_scan_query_task.h"
 
+#include <algorithm>
+
 #include "glog/logging.h"
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
+#include "sdk/common/scan_cursor.h"
+#include "sdk/document/document_helper.h"
 #include "sdk/document/document_translater.h"
 #include "dingosdk/status.h"
 #include "sdk/utils/scoped_cleanup.h"
@@ -23,33 +28,53 @@
 namespace dingodb {
 namespace sdk {
 
-Status DocumentScanQueryTask::Init() {
-  if (scan_query_param_.max_scan_count < 0) {
+static Status CheckScanQueryParam(const DocScanQueryParam& scan_query_param) {
+  if (scan_query_param.max_scan_count < 0) {
     return Status::InvalidArgument("max_scan_count must be greater than or equal to 0");
   }
 
-  if (scan_query_param_.doc_id_start < 0) {
+  if (scan_query_param.doc_id_start < 0) {
     return Status::InvalidArgument("doc_id_start must be greater than or equal to 0");
   }
 
-  if (scan_query_param_.doc_id_end < 0) {
+  if (scan_query_param.doc_id_end < 0) {
     return Status::InvalidArgument("doc_id_end must be greater than or equal to 0");
   }
 
-  if (scan_query_param_.is_reverse) {
-    if (!(scan_query_param_.doc_id_end < scan_query_param_.doc_id_start)) {
+  if (scan_query_param.is_reverse) {
+    if (!(scan_query_param.doc_id_end < scan_query_param.doc_id_start)) {
       return Status::InvalidArgument("doc_id_end must be less than doc_id_start in reverse scan");
     }
   } else {
-    if (scan_query_param_.doc_id_end != 0 && !(scan_query_param_.doc_id_start < scan_query_param_.doc_id_end)) {
+    if (scan_query_param.doc_id_end != 0 && !(scan_query_param.doc_id_start < scan_query_param.doc_id_end)) {
       return Status::InvalidArgument("doc_id_end must be greater than doc_id_start in forward scan");
     }
   }
 
-  if (scan_query_param_.max_scan_count <= 0) {
+  if (scan_query_param.max_scan_count <= 0) {
     return Status::InvalidArgument("max_scan_count must bigger than 0");
   }
 
+  return Status::OK();
+}
+
+static void FillScanQueryRequest(pb::document::DocumentScanQueryRequest* request,
+                                 const DocScanQueryParam& scan_query_param) {
+  request->set_document_id_start(scan_query_param.doc_id_start);
+  request->set_is_reverse_scan(scan_query_param.is_reverse);
+  request->set_max_scan_count(scan_query_param.max_scan_count);
+  request->set_document_id_end(scan_query_param.doc_id_end);
+  request->set_without_scalar_data(!scan_query_param.with_scalar_data);
+  if (scan_query_param.with_scalar_data) {
+    for (const auto& key : scan_query_param.selected_keys) {
+      request->add_selected_keys(key);
+    }
+  }
+}
+
+Status DocumentScanQueryTask::Init() {
+  DINGO_RETURN_NOT_OK(CheckScanQueryParam(scan_query_param_));
+
   std::shared_ptr<DocumentIndex> tmp;
   DINGO_RETURN_NOT_OK(stub.GetDocumentIndexCache()->GetDocumentIndexById(index_id_, tmp));
   DCHECK_NOTNULL(tmp);
@@ -179,17 +204,7 @@ void DocumentScanQueryPartTask::DoAsync() {
 void DocumentScanQueryPartTask::FillDocumentScanQueryRpcRequest(pb::document::DocumentScanQueryRequest* request,
                                                                 const std::shared_ptr<Region>& region) {
   FillRpcContext(*request->mutable_context(), region->RegionId(), region->Epoch());
-
-  request->set_document_id_start(scan_query_param_.doc_id_start);
-  request->set_is_reverse_scan(scan_query_param_.is_reverse);
-  request->set_max_scan_count(scan_query_param_.max_scan_count);
-  request->set_document_id_end(scan_query_param_.doc_id_end);
-  request->set_without_scalar_data(!scan_query_param_.with_scalar_data);
-  if (scan_query_param_.with_scalar_data) {
-    for (const auto& key : scan_query_param_.selected_keys) {
-      request->add_selected_keys(key);
-    }
-  }
+  FillScanQueryRequest(request, scan_query_param_);
 }
 
 void DocumentScanQueryPartTask::DocumentScanQueryRpcCallback(Status status, DocumentScanQueryRpc* rpc) {
@@ -221,5 +236,156 @@ void DocumentScanQueryPartTask::DocumentScanQueryRpcCallback(Status status, Docu
   }
 }
 
+Status DocumentScanQueryPageTask::Init() {
+  DINGO_RETURN_NOT_OK(CheckScanQueryParam(scan_query_param_));
+
+  if (page_token_.empty()) {
+    start_id_ = std::max<int64_t>(scan_query_param_.doc_id_start, 1);
+  } else {
+    DINGO_RETURN_NOT_OK(scan_cursor::DecodeToken(page_token_, start_id_));
+  }
+
+  std::shared_ptr<DocumentIndex> tmp;
+  DINGO_RETURN_NOT_OK(stub.GetDocumentIndexCache()->GetDocumentIndexById(index_id_, tmp));
+  DCHECK_NOTNULL(tmp);
+  doc_index_ = std::move(tmp);
+
+  return Status::OK();
+}
+
+void DocumentScanQueryPageTask::DoAsync() {
+  {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    result_docs_.clear();
+    status_ = Status::OK();
+  }
+
+  cursor_id_ = start_id_;
+  regions_.clear();
+  next_region_idx_ = 0;
+
+  Status s = scan_cursor::OrderedRegions(stub, *doc_index_, cursor_id_, scan_query_param_.is_reverse,
+                                         document_helper::DocumentIdToRangeKey, regions_);
+  if (!s.ok()) {
+    DoAsyncDone(s);
+    return;
+  }
+
+  if (regions_.empty()) {
+    Done(Status::OK());
+    return;
+  }
+
+  SendNextRegions();
+}
+
+void DocumentScanQueryPageTask::SendNextRegions() {
+  int64_t count = std::min<int64_t>(std::max<int64_t>(FLAGS_scan_query_page_parallel_regions, 1),
+                                    regions_.size() - next_region_idx_);
+  // one row more than the page is asked for, it tells whether rows are left after the page
+  int64_t missing_count = scan_query_param_.max_scan_count + 1 - result_docs_.size();
+
+  controllers_.clear();
+  rpcs_.clear();
+  region_docs_.assign(count, {});
+
+  for (int64_t i = 0; i < count; i++) {
+    const auto& region = regions_[next_region_idx_ + i];
+
+    auto rpc = std::make_unique<DocumentScanQueryRpc>();
+    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
+    FillScanQueryRequest(rpc->MutableRequest(), scan_query_param_);
+    rpc->MutableRequest()->set_document_id_start(cursor_id_);
+    rpc->MutableRequest()->set_max_scan_count(missing_count);
+
+    controllers_.emplace_back(stub, *rpc, region);
+    rpcs_.push_back(std::move(rpc));
+  }
+
+  sub_tasks_count_.store(count);
+
+  for (int64_t i = 0; i < count; i++) {
+    controllers_[i].AsyncCall([this, rpc = rpcs_[i].get(), i](auto&& s) {
+      DocumentScanQueryRpcCallback(std::forward<decltype(s)>(s), rpc, i);
+    });
+  }
+}
+
+void DocumentScanQueryPageTask::DocumentScanQueryRpcCallback(const Status& status, DocumentScanQueryRpc* rpc,
+                                                             int64_t idx) {
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
+                       << " fail: " << status.ToString();
+
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    if (status_.ok()) {
+      // only return first fail status
+      status_ = status;
+    }
+  } else {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    auto& docs = region_docs_[idx];
+    docs.reserve(rpc->Response()->documents_size());
+    for (const auto& doc_with_id : rpc->Response()->documents()) {
+      docs.emplace_back(DocumentTranslater::InternalDocumentWithIdPB2DocWithId(doc_with_id));
+    }
+  }
+
+  if (sub_tasks_count_.fetch_sub(1) == 1) {
+    Status tmp;
+    bool finished = false;
+    {
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      tmp = status_;
+      if (tmp.ok()) {
+        finished = CollectResultUnlocked();
+      }
+    }
+
+    if (!tmp.ok()) {
+      DoAsyncDone(tmp);
+    } else if (finished) {
+      Done(tmp);
+    } else {
+      // the next round clears controllers and rpcs, one of them is still firing this callback
+      stub.GetActuator()->Execute([this] { SendNextRegions(); });
+    }
+  }
+}
+
+bool DocumentScanQueryPageTask::CollectResultUnlocked() {
+  auto limit = scan_query_param_.max_scan_count + 1;
+  for (auto& docs : region_docs_) {
+    if (scan_query_param_.is_reverse) {
+      std::sort(docs.begin(), docs.end(), [](const DocWithId& a, const DocWithId& b) { return a.id > b.id; });
+    } else {
+      std::sort(docs.begin(), docs.end(), [](const DocWithId& a, const DocWithId& b) { return a.id < b.id; });
+    }
+
+    // a region returns less than asked only when it has no more documents after cursor, so the next region follows
+    for (auto& doc : docs) {
+      if (result_docs_.size() >= limit) {
+        return true;
+      }
+      result_docs_.push_back(std::move(doc));
+    }
+  }
+
+  next_region_idx_ += region_docs_.size();
+  return result_docs_.size() >= limit || next_region_idx_ >= regions_.size();
+}
+
+void DocumentScanQueryPageTask::Done(const Status& status) {
+  // the look-ahead document is where the next page starts, without it the scan is finished
+  next_page_token_.clear();
+  if (result_docs_.size() > scan_query_param_.max_scan_count) {
+    next_page_token_ = scan_cursor::EncodeToken(result_docs_[scan_query_param_.max_scan_count].id);
+    result_docs_.resize(scan_query_param_.max_scan_count);
+  }
+
+  out_result_.docs = std::move(result_docs_);
+  DoAsyncDone(status);
+}
+
 }  // namespace sdk
-}  // namespace dingodb
\ No newline at end of file
+}  // namespace dingodb
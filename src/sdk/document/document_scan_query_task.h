@@ -16,6 +16,8 @@
 #define DINGODB_SDK_DOCUMENT_SCAN_QUERY_TATSK_H_
 
 #include <cstdint>
+#include <string>
+#include <vector>
 
 #include "dingosdk/document.h"
 #include "sdk/client_stub.h"
@@ -103,6 +105,64 @@ class DocumentScanQueryPartTask : public DocumentTask {
   std::atomic<int> sub_tasks_count_{0};
 };
 
+// Scan one page of at most max_scan_count documents in id order, resuming from page_token. Regions are scanned in
+// order, scan_query_page_parallel_regions at a time, each asked for the vectors still missing in the page, so memory
+// is bounded by the page size instead of the whole id range.
+class DocumentScanQueryPageTask : public DocumentTask {
+ public:
+  DocumentScanQueryPageTask(const ClientStub& stub, int64_t index_id, const DocScanQueryParam& query_param,
+                            const std::string& page_token, DocScanQueryResult& out_result,
+                            std::string& next_page_token)
+      : DocumentTask(stub),
+        index_id_(index_id),
+        scan_query_param_(query_param),
+        page_token_(page_token),
+        out_result_(out_result),
+        next_page_token_(next_page_token) {}
+
+  ~DocumentScanQueryPageTask() override = default;
+
+ private:
+  Status Init() override;
+  void DoAsync() override;
+
+  std::string Name() const override { return fmt::format("DocumentScanQueryPageTask-{}", index_id_); }
+
+  void SendNextRegions();
+
+  void DocumentScanQueryRpcCallback(const Status& status, DocumentScanQueryRpc* rpc, int64_t idx);
+
+  // collect results of the regions scanned in order, return true when the page and its look-ahead row are full or no
+  // row is left
+  bool CollectResultUnlocked();
+
+  void Done(const Status& status);
+
+  const int64_t index_id_;
+  const DocScanQueryParam& scan_query_param_;
+  const std::string& page_token_;
+  DocScanQueryResult& out_result_;
+  std::string& next_page_token_;
+
+  std::shared_ptr<DocumentIndex> doc_index_;
+  // id the page starts from, cursor_id_ moves forward while the page is filled and is reset to it on retry
+  int64_t start_id_{0};
+  int64_t cursor_id_{0};
+
+  std::vector<std::shared_ptr<Region>> regions_;
+  int64_t next_region_idx_{0};
+
+  std::vector<StoreRpcController> controllers_;
+  std::vector<std::unique_ptr<DocumentScanQueryRpc>> rpcs_;
+
+  std::shared_mutex rw_lock_;
+  std::vector<std::vector<DocWithId>> region_docs_;
+  std::vector<DocWithId> result_docs_;
+  Status status_;
+
+  std::atomic<int> sub_tasks_count_{0};
+};
+
 }  // namespace sdk
 }  // namespace dingodb
 
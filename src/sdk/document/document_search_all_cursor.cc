@@ -0,0 +1,272 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/document/document_search_all_cursor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+
+constexpr uint8_t kTokenVersion = 2;
+
+bool WorseThan(const DocumentSearchAllCursor::Hit& a, const DocumentSearchAllCursor::Hit& b) {
+  return a.score < b.score || (a.score == b.score && a.id > b.id);
+}
+
+template <class T>
+void PutFixed(std::string& buf, T value) {
+  buf.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void PutString(std::string& buf, const std::string& value) {
+  PutFixed<uint32_t>(buf, value.size());
+  buf.append(value);
+}
+
+class Reader {
+ public:
+  explicit Reader(const std::string& buf) : buf_(buf) {}
+
+  template <class T>
+  bool GetFixed(T& value) {
+    if (buf_.size() - pos_ < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, buf_.data() + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return true;
+  }
+
+  bool GetString(std::string& value) {
+    uint32_t size = 0;
+    if (!GetFixed(size) || buf_.size() - pos_ < size) {
+      return false;
+    }
+    value.assign(buf_.data() + pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+  bool End() const { return pos_ == buf_.size(); }
+
+ private:
+  const std::string& buf_;
+  size_t pos_{0};
+};
+
+std::string ToHex(const std::string& buf) {
+  static const char* kDigits = "0123456789abcdef";
+  std::string hex;
+  hex.reserve(buf.size() * 2);
+  for (unsigned char c : buf) {
+    hex.push_back(kDigits[c >> 4]);
+    hex.push_back(kDigits[c & 0xf]);
+  }
+  return hex;
+}
+
+int HexDigit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  return -1;
+}
+
+bool FromHex(const std::string& hex, std::string& buf) {
+  if (hex.size() % 2 != 0) {
+    return false;
+  }
+  buf.clear();
+  buf.reserve(hex.size() / 2);
+  for (size_t i = 0; i < hex.size(); i += 2) {
+    int high = HexDigit(hex[i]);
+    int low = HexDigit(hex[i + 1]);
+    if (high < 0 || low < 0) {
+      return false;
+    }
+    buf.push_back(static_cast<char>((high << 4) | low));
+  }
+  return true;
+}
+
+}  // namespace
+
+std::string DocumentSearchAllCursor::EncodeToken() const {
+  // regions with buffered hits start a new stream on the next page, so the token does not grow with the buffer
+  std::vector<bool> restart(regions_.size(), false);
+  for (const auto& hit : buffer_) {
+    restart[hit.region_idx] = true;
+  }
+
+  std::string buf;
+  PutFixed<uint8_t>(buf, kTokenVersion);
+
+  PutFixed<uint32_t>(buf, regions_.size());
+  for (int64_t i = 0; i < regions_.size(); i++) {
+    const auto& region = regions_[i];
+    PutFixed<int64_t>(buf, region.region_id);
+    if (restart[i]) {
+      PutString(buf, "");
+      PutFixed<float>(buf, 0.0);
+      PutFixed<uint8_t>(buf, 0);
+    } else {
+      PutString(buf, region.stream_id);
+      PutFixed<float>(buf, region.last_score);
+      PutFixed<uint8_t>(buf, (region.started ? 1 : 0) | (region.done ? 2 : 0));
+    }
+  }
+
+  PutFixed<uint8_t>(buf, has_bound_ ? 1 : 0);
+  PutFixed<float>(buf, bound_score_);
+  PutFixed<int64_t>(buf, bound_id_);
+
+  return ToHex(buf);
+}
+
+Status DocumentSearchAllCursor::DecodeToken(const std::string& token) {
+  std::string buf;
+  if (!FromHex(token, buf)) {
+    return Status::InvalidArgument("invalid page token");
+  }
+
+  Reader reader(buf);
+  uint8_t version = 0;
+  uint32_t region_count = 0;
+  if (!reader.GetFixed(version) || version != kTokenVersion || !reader.GetFixed(region_count)) {
+    return Status::InvalidArgument("invalid page token");
+  }
+
+  std::vector<RegionCursor> regions(region_count);
+  for (auto& region : regions) {
+    uint8_t flags = 0;
+    if (!reader.GetFixed(region.region_id) || !reader.GetString(region.stream_id) ||
+        !reader.GetFixed(region.last_score) || !reader.GetFixed(flags)) {
+      return Status::InvalidArgument("invalid page token");
+    }
+    region.started = (flags & 1) != 0;
+    region.done = (flags & 2) != 0;
+  }
+
+  uint8_t has_bound = 0;
+  float bound_score = 0.0;
+  int64_t bound_id = 0;
+  if (!reader.GetFixed(has_bound) || !reader.GetFixed(bound_score) || !reader.GetFixed(bound_id) || !reader.End()) {
+    return Status::InvalidArgument("invalid page token");
+  }
+
+  regions_ = std::move(regions);
+  buffer_.clear();
+  has_bound_ = has_bound != 0;
+  bound_score_ = bound_score;
+  bound_id_ = bound_id;
+  return Status::OK();
+}
+
+void DocumentSearchAllCursor::AddRegion(int64_t region_id) {
+  RegionCursor region;
+  region.region_id = region_id;
+  regions_.push_back(std::move(region));
+}
+
+bool DocumentSearchAllCursor::Finished() const {
+  return buffer_.empty() &&
+         std::all_of(regions_.begin(), regions_.end(), [](const RegionCursor& region) { return region.done; });
+}
+
+bool DocumentSearchAllCursor::HasFrontier(float& frontier) const {
+  bool found = false;
+  frontier = -std::numeric_limits<float>::infinity();
+  for (const auto& region : regions_) {
+    if (region.done) {
+      continue;
+    }
+    found = true;
+    frontier = std::max(frontier, region.started ? region.last_score : std::numeric_limits<float>::infinity());
+  }
+  return found;
+}
+
+std::vector<int64_t> DocumentSearchAllCursor::RegionsToFetch() const {
+  std::vector<int64_t> idxs;
+  for (int64_t i = 0; i < regions_.size(); i++) {
+    const auto& region = regions_[i];
+    if (region.done) {
+      continue;
+    }
+    if (buffer_.empty() || !region.started || region.last_score >= buffer_.front().score) {
+      idxs.push_back(i);
+    }
+  }
+  return idxs;
+}
+
+bool DocumentSearchAllCursor::AfterBound(const Hit& hit) const {
+  if (!has_bound_) {
+    return true;
+  }
+  Hit bound;
+  bound.score = bound_score_;
+  bound.id = bound_id_;
+  return WorseThan(hit, bound);
+}
+
+void DocumentSearchAllCursor::OnBatch(int64_t idx, const std::string& stream_id, bool has_more,
+                                      std::vector<Hit>&& hits) {
+  auto& region = regions_[idx];
+  for (auto& hit : hits) {
+    region.last_score = region.started ? std::min(region.last_score, hit.score) : hit.score;
+    region.started = true;
+
+    if (!AfterBound(hit)) {
+      continue;
+    }
+    hit.region_idx = idx;
+    buffer_.push_back(std::move(hit));
+    std::push_heap(buffer_.begin(), buffer_.end(), WorseThan);
+  }
+
+  region.stream_id = stream_id;
+  region.done = stream_id.empty() || !has_more;
+}
+
+void DocumentSearchAllCursor::PopReady(int64_t limit, std::vector<Hit>& out_hits) {
+  float frontier = 0.0;
+  bool has_frontier = HasFrontier(frontier);
+
+  for (int64_t i = 0; i < limit && !buffer_.empty(); i++) {
+    // a region may still send a hit of the frontier score with a smaller id
+    if (has_frontier && buffer_.front().score <= frontier) {
+      break;
+    }
+
+    std::pop_heap(buffer_.begin(), buffer_.end(), WorseThan);
+    has_bound_ = true;
+    bound_score_ = buffer_.back().score;
+    bound_id_ = buffer_.back().id;
+    out_hits.push_back(std::move(buffer_.back()));
+    buffer_.pop_back();
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
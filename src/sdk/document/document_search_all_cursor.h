@@ -0,0 +1,101 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_DOCUMENT_SEARCH_ALL_CURSOR_H_
+#define DINGODB_SDK_DOCUMENT_SEARCH_ALL_CURSOR_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "dingosdk/status.h"
+
+namespace dingodb {
+namespace sdk {
+
+// State of a paged search all between two pages: the stream cursor of every region and the hits received but not
+// returned yet. Regions stream hits in descending score order, so a buffered hit can be returned once no region
+// still streaming can produce a better or equal one, the lowest score a region has sent bounds the score of its later
+// hits. Hits are returned in descending score then ascending id order and kept as serialized store documents, only
+// the returned ones are translated.
+//
+// The page token only holds the region cursors and the last returned hit. Buffered hits are dropped from it, their
+// regions open a new stream on the next page and skip the hits ordered before the last returned one.
+class DocumentSearchAllCursor {
+ public:
+  struct RegionCursor {
+    int64_t region_id{0};
+    std::string stream_id;
+    // lowest score received from the region, meaningless before the first batch
+    float last_score{0.0};
+    bool started{false};
+    bool done{false};
+  };
+
+  struct Hit {
+    float score{0.0};
+    int64_t id{0};
+    std::string doc;
+    // index of the region which sends the hit
+    int64_t region_idx{0};
+  };
+
+  DocumentSearchAllCursor() = default;
+
+  ~DocumentSearchAllCursor() = default;
+
+  // page token is the hex of the encoded cursor, so it is printable
+  std::string EncodeToken() const;
+  Status DecodeToken(const std::string& token);
+
+  void AddRegion(int64_t region_id);
+
+  const std::vector<RegionCursor>& Regions() const { return regions_; }
+
+  int64_t BufferSize() const { return buffer_.size(); }
+
+  // all regions are drained and all hits are returned
+  bool Finished() const;
+
+  // index of the regions which may still send a hit better than every buffered one
+  std::vector<int64_t> RegionsToFetch() const;
+
+  // one stream batch of the region at idx, the region is done when has_more is false or no stream id is returned.
+  // hits already returned are skipped
+  void OnBatch(int64_t idx, const std::string& stream_id, bool has_more, std::vector<Hit>&& hits);
+
+  // move at most limit hits which no region can beat anymore to out_hits, best first
+  void PopReady(int64_t limit, std::vector<Hit>& out_hits);
+
+ private:
+  // best score a region still streaming may send, the highest one of all regions
+  bool HasFrontier(float& frontier) const;
+
+  // the hit is ordered after the last returned one, hits of a new stream not after it were returned by earlier pages
+  bool AfterBound(const Hit& hit) const;
+
+  std::vector<RegionCursor> regions_;
+  // heap with the best hit on top
+  std::vector<Hit> buffer_;
+
+  // the last returned hit
+  bool has_bound_{false};
+  float bound_score_{0.0};
+  int64_t bound_id_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_DOCUMENT_SEARCH_ALL_CURSOR_H_
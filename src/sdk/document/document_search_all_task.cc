@@ -14,8 +14,8 @@
 
 #include "sdk/document/document_search_all_task.h"
 
+#include <algorithm>
 #include <cstdint>
-#include <iterator>
 #include <memory>
 
 #include "common/logging.h"
@@ -25,6 +25,7 @@
 #include "proto/common.pb.h"
 #include "proto/document.pb.h"
 #include "sdk/common/common.h"
+#include "sdk/document/document_topn.h"
 #include "sdk/document/document_translater.h"
 #include "sdk/utils/scoped_cleanup.h"
 
@@ -82,8 +83,9 @@ void DocumentSearchAllTask::SubTaskCallback(Status status, DocumentSearchAllPart
     }
   } else {
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    std::vector<DocWithStore> sub_results = sub_task->GetDocSearchResult();
-    std::move(sub_results.begin(), sub_results.end(), std::back_inserter(out_result_.doc_sores));
+    for (auto& result : sub_task->GetDocSearchResult()) {
+      top_n_.Push(std::move(result));
+    }
     next_part_ids_.erase(sub_task->part_id_);
   }
 
@@ -91,14 +93,10 @@ void DocumentSearchAllTask::SubTaskCallback(Status status, DocumentSearchAllPart
     Status tmp;
     {
       std::unique_lock<std::shared_mutex> w(rw_lock_);
-
-      std::sort(out_result_.doc_sores.begin(), out_result_.doc_sores.end(),
-                [](const DocWithStore& a, const DocWithStore& b) { return a.score > b.score; });
-
-      if (search_param_.top_n > 0 && search_param_.top_n < out_result_.doc_sores.size()) {
-        out_result_.doc_sores.resize(search_param_.top_n);
+      // a failed round is retried on the failed partitions only, keep the merged hits of the others until then
+      if (status_.ok()) {
+        out_result_.doc_sores = top_n_.Finish();
       }
-
       tmp = status_;
     }
 
@@ -217,5 +215,199 @@ void DocumentSearchAllPartTask::DocumentSearchStream(DocumentSearchAllRpc* rpc)
       [this, rpc = sub_rpc.get()](auto&& s) { DocumentSearchAllRpcCallback(std::forward<decltype(s)>(s), rpc); });
 }
 
+Status DocumentSearchAllPageTask::Init() {
+  if (search_param_.page_size <= 0) {
+    return Status::InvalidArgument("page_size must be greater than 0");
+  }
+
+  if (!page_token_.empty()) {
+    DINGO_RETURN_NOT_OK(cursor_.DecodeToken(page_token_));
+  }
+
+  std::shared_ptr<DocumentIndex> tmp;
+  DINGO_RETURN_NOT_OK(stub.GetDocumentIndexCache()->GetDocumentIndexById(index_id_, tmp));
+  DCHECK_NOTNULL(tmp);
+  doc_index_ = std::move(tmp);
+
+  return Status::OK();
+}
+
+Status DocumentSearchAllPageTask::ListRegionIds(std::vector<int64_t>& region_ids) {
+  for (const auto& part_id : doc_index_->GetPartitionIds()) {
+    const auto& range = doc_index_->GetPartitionRange(part_id);
+    std::vector<std::shared_ptr<Region>> regions;
+    DINGO_RETURN_NOT_OK(
+        stub.GetMetaCache()->ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), regions));
+    for (const auto& region : regions) {
+      region_ids.push_back(region->RegionId());
+    }
+  }
+
+  return Status::OK();
+}
+
+Status DocumentSearchAllPageTask::InitRegions() {
+  std::vector<int64_t> region_ids;
+  DINGO_RETURN_NOT_OK(ListRegionIds(region_ids));
+  for (const auto& region_id : region_ids) {
+    cursor_.AddRegion(region_id);
+  }
+
+  return Status::OK();
+}
+
+Status DocumentSearchAllPageTask::CheckRegions() {
+  std::vector<int64_t> region_ids;
+  DINGO_RETURN_NOT_OK(ListRegionIds(region_ids));
+
+  std::vector<int64_t> cursor_region_ids;
+  for (const auto& region : cursor_.Regions()) {
+    cursor_region_ids.push_back(region.region_id);
+  }
+
+  std::sort(region_ids.begin(), region_ids.end());
+  std::sort(cursor_region_ids.begin(), cursor_region_ids.end());
+  if (region_ids != cursor_region_ids) {
+    return Status::Aborted(
+        fmt::format("regions of index {} are split or merged since the search started, search again without page token",
+                    index_id_));
+  }
+
+  return Status::OK();
+}
+
+void DocumentSearchAllPageTask::DoAsync() {
+  {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    status_ = Status::OK();
+  }
+
+  // a retry keeps the streams and hits already received, regions are listed again only when no stream is opened yet
+  const auto& regions = cursor_.Regions();
+  bool started = std::any_of(regions.begin(), regions.end(),
+                             [](const DocumentSearchAllCursor::RegionCursor& region) { return region.started; });
+  if (page_token_.empty() && !started) {
+    cursor_ = DocumentSearchAllCursor();
+    Status s = InitRegions();
+    if (!s.ok()) {
+      DoAsyncDone(s);
+      return;
+    }
+  } else {
+    // a split region would miss the hits of its new sibling, so the search can not go on
+    Status s = CheckRegions();
+    if (!s.ok()) {
+      DoAsyncDone(s);
+      return;
+    }
+  }
+
+  NextRound();
+}
+
+void DocumentSearchAllPageTask::NextRound() {
+  cursor_.PopReady(search_param_.page_size - static_cast<int64_t>(page_hits_.size()), page_hits_);
+  if (page_hits_.size() >= search_param_.page_size || cursor_.Finished()) {
+    Done(Status::OK());
+    return;
+  }
+
+  std::vector<int64_t> idxs = cursor_.RegionsToFetch();
+  DCHECK(!idxs.empty());
+
+  controllers_.clear();
+  rpcs_.clear();
+
+  for (const auto& idx : idxs) {
+    const auto& region_cursor = cursor_.Regions()[idx];
+    std::shared_ptr<Region> region;
+    Status s = stub.GetMetaCache()->LookupRegionByRegionId(region_cursor.region_id, region);
+    if (!s.ok()) {
+      DoAsyncDone(s);
+      return;
+    }
+
+    auto rpc = std::make_unique<DocumentSearchAllRpc>();
+    auto* request = rpc->MutableRequest();
+    FillRpcContext(*request->mutable_context(), region->RegionId(), region->Epoch());
+    DocumentTranslater::FillInternalDocSearchAllParams(request->mutable_parameter(), search_param_);
+    request->mutable_stream_meta()->set_limit(search_param_.page_size);
+    if (!region_cursor.stream_id.empty()) {
+      request->mutable_stream_meta()->set_stream_id(region_cursor.stream_id);
+    }
+
+    controllers_.emplace_back(stub, *rpc, region);
+    rpcs_.push_back(std::move(rpc));
+  }
+
+  sub_tasks_count_.store(idxs.size());
+
+  for (int64_t i = 0; i < idxs.size(); i++) {
+    controllers_[i].AsyncCall([this, rpc = rpcs_[i].get(), idx = idxs[i]](auto&& s) {
+      DocumentSearchAllRpcCallback(std::forward<decltype(s)>(s), rpc, idx);
+    });
+  }
+}
+
+void DocumentSearchAllPageTask::DocumentSearchAllRpcCallback(const Status& status, DocumentSearchAllRpc* rpc,
+                                                             int64_t idx) {
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
+                       << " fail: " << status.ToString();
+
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    if (status_.ok()) {
+      // only return first fail status
+      status_ = status;
+    }
+  } else {
+    const auto& response = *rpc->Response();
+    std::vector<DocumentSearchAllCursor::Hit> hits;
+    hits.reserve(response.document_with_scores_size());
+    for (const auto& doc_with_score : response.document_with_scores()) {
+      DocumentSearchAllCursor::Hit hit;
+      hit.score = doc_with_score.score();
+      hit.id = doc_with_score.document_with_id().id();
+      doc_with_score.SerializeToString(&hit.doc);
+      hits.push_back(std::move(hit));
+    }
+
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    cursor_.OnBatch(idx, response.stream_meta().stream_id(), response.stream_meta().has_more(), std::move(hits));
+  }
+
+  if (sub_tasks_count_.fetch_sub(1) == 1) {
+    Status tmp;
+    {
+      std::shared_lock<std::shared_mutex> r(rw_lock_);
+      tmp = status_;
+    }
+
+    if (!tmp.ok()) {
+      DoAsyncDone(tmp);
+    } else {
+      // the next round clears controllers and rpcs, one of them is still firing this callback
+      stub.GetActuator()->Execute([this] { NextRound(); });
+    }
+  }
+}
+
+void DocumentSearchAllPageTask::Done(const Status& status) {
+  // only the returned hits are translated, the buffered ones are dropped and searched again by the next page
+  out_result_.doc_sores.clear();
+  out_result_.doc_sores.reserve(page_hits_.size());
+  for (const auto& hit : page_hits_) {
+    pb::common::DocumentWithScore doc_with_score;
+    if (!doc_with_score.ParseFromString(hit.doc)) {
+      DoAsyncDone(Status::Corruption(fmt::format("parse document {} fail", hit.id)));
+      return;
+    }
+    out_result_.doc_sores.push_back(DocumentTranslater::InternalDocumentWithScore2DocWithStore(doc_with_score));
+  }
+
+  next_page_token_ = cursor_.Finished() ? "" : cursor_.EncodeToken();
+  DoAsyncDone(status);
+}
+
 }  // namespace sdk
 }  // namespace dingodb
\ No newline at end of file
@@ -17,13 +17,17 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "dingosdk/document.h"
 #include "fmt/core.h"
 #include "sdk/client_stub.h"
 #include "sdk/document/document_index.h"
+#include "sdk/document/document_search_all_cursor.h"
 #include "sdk/document/document_task.h"
+#include "sdk/document/document_topn.h"
 #include "sdk/region.h"
 #include "sdk/rpc/document_service_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
@@ -36,7 +40,11 @@ class DocumentSearchAllTask : public DocumentTask {
  public:
   DocumentSearchAllTask(const ClientStub& stub, int64_t index_id, const DocSearchParam& search_param,
                         DocSearchResult& out_result)
-      : DocumentTask(stub), index_id_(index_id), search_param_(search_param), out_result_(out_result) {}
+      : DocumentTask(stub),
+        index_id_(index_id),
+        search_param_(search_param),
+        out_result_(out_result),
+        top_n_(search_param.top_n) {}
 
   ~DocumentSearchAllTask() override = default;
 
@@ -58,6 +66,8 @@ class DocumentSearchAllTask : public DocumentTask {
   std::shared_mutex rw_lock_;
   std::set<int64_t> next_part_ids_;
   Status status_;
+  // best results of the finished partitions
+  DocumentTopN top_n_;
 
   std::atomic<int> sub_tasks_count_{0};
 };
@@ -112,6 +122,61 @@ class DocumentSearchAllPartTask : public DocumentTask {
   std::atomic<int> sub_tasks_count_{0};
 };
 
+// Search all one page of at most page_size hits in score order, resuming from page_token. Regions of all partitions
+// are streamed page_size hits per rpc, only the regions which may still send a hit better than the buffered ones are
+// asked for the next batch, so memory is bounded by region count times page size instead of the whole result.
+class DocumentSearchAllPageTask : public DocumentTask {
+ public:
+  DocumentSearchAllPageTask(const ClientStub& stub, int64_t index_id, const DocSearchParam& search_param,
+                            const std::string& page_token, DocSearchResult& out_result, std::string& next_page_token)
+      : DocumentTask(stub),
+        index_id_(index_id),
+        search_param_(search_param),
+        page_token_(page_token),
+        out_result_(out_result),
+        next_page_token_(next_page_token) {}
+
+  ~DocumentSearchAllPageTask() override = default;
+
+ private:
+  Status Init() override;
+  void DoAsync() override;
+
+  std::string Name() const override { return fmt::format("DocumentSearchAllPageTask-{}", index_id_); }
+
+  Status ListRegionIds(std::vector<int64_t>& region_ids);
+
+  Status InitRegions();
+
+  // regions of the cursor must be the regions of the index, fail when they are split or merged
+  Status CheckRegions();
+
+  // return the ready hits and finish the page, or fetch the regions blocking the buffered hits
+  void NextRound();
+
+  void DocumentSearchAllRpcCallback(const Status& status, DocumentSearchAllRpc* rpc, int64_t idx);
+
+  void Done(const Status& status);
+
+  const int64_t index_id_;
+  const DocSearchParam& search_param_;
+  const std::string& page_token_;
+  DocSearchResult& out_result_;
+  std::string& next_page_token_;
+
+  std::shared_ptr<DocumentIndex> doc_index_;
+
+  std::vector<StoreRpcController> controllers_;
+  std::vector<std::unique_ptr<DocumentSearchAllRpc>> rpcs_;
+
+  std::shared_mutex rw_lock_;
+  DocumentSearchAllCursor cursor_;
+  std::vector<DocumentSearchAllCursor::Hit> page_hits_;
+  Status status_;
+
+  std::atomic<int> sub_tasks_count_{0};
+};
+
 }  // namespace sdk
 }  // namespace dingodb
 
@@ -15,7 +15,6 @@
 #include "sdk/document/document_search_task.h"
 
 #include <cstdint>
-#include <iterator>
 #include <memory>
 
 #include "common/logging.h"
@@ -25,6 +24,7 @@
 #include "sdk/common/common.h"
 #include "sdk/common/param_config.h"
 #include "dingosdk/document.h"
+#include "sdk/document/document_topn.h"
 #include "sdk/document/document_translater.h"
 #include "dingosdk/status.h"
 #include "sdk/utils/scoped_cleanup.h"
@@ -85,8 +85,7 @@ void DocumentSearchTask::SubTaskCallback(Status status, DocumentSearchPartTask*
     }
   } else {
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    std::vector<DocWithStore> sub_results = sub_task->GetDocSearchResult();
-    std::move(sub_results.begin(), sub_results.end(), std::back_inserter(out_result_.doc_sores));
+    top_n_.Merge(sub_task->TakeDocSearchResult());
     next_part_ids_.erase(sub_task->part_id_);
   }
 
@@ -94,14 +93,10 @@ void DocumentSearchTask::SubTaskCallback(Status status, DocumentSearchPartTask*
     Status tmp;
     {
       std::unique_lock<std::shared_mutex> w(rw_lock_);
-
-      std::sort(out_result_.doc_sores.begin(), out_result_.doc_sores.end(),
-                [](const DocWithStore& a, const DocWithStore& b) { return a.score > b.score; });
-
-      if (search_param_.top_n > 0 && search_param_.top_n < out_result_.doc_sores.size()) {
-        out_result_.doc_sores.resize(search_param_.top_n);
+      // a failed round is retried on the failed partitions only, keep the merged hits of the others until then
+      if (status_.ok()) {
+        out_result_.doc_sores = top_n_.Finish();
       }
-
       tmp = status_;
     }
 
@@ -129,7 +124,7 @@ void DocumentSearchPartTask::DoAsync() {
 
   {
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    search_result_.clear();
+    search_result_ = DocumentTopN(search_parameter_.top_n());
     status_ = Status::OK();
   }
 
@@ -179,8 +174,10 @@ void DocumentSearchPartTask::DocumentSearchRpcCallback(const Status& status, Doc
     {
       std::unique_lock<std::shared_mutex> w(rw_lock_);
       for (const auto& doc_with_score : rpc->Response()->document_with_scores()) {
-        DocWithStore distance = DocumentTranslater::InternalDocumentWithScore2DocWithStore(doc_with_score);
-        search_result_.push_back(std::move(distance));
+        // hits out of the top n are dropped before translating their documents
+        if (search_result_.Accept(doc_with_score.score(), doc_with_score.document_with_id().id())) {
+          search_result_.Push(DocumentTranslater::InternalDocumentWithScore2DocWithStore(doc_with_score));
+        }
       }
     }
   }
@@ -24,6 +24,7 @@
 #include "sdk/client_stub.h"
 #include "sdk/document/document_index.h"
 #include "sdk/document/document_task.h"
+#include "sdk/document/document_topn.h"
 #include "sdk/rpc/document_service_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
 
@@ -35,7 +36,11 @@ class DocumentSearchTask : public DocumentTask {
  public:
   DocumentSearchTask(const ClientStub& stub, int64_t index_id, const DocSearchParam& search_param,
                      DocSearchResult& out_result)
-      : DocumentTask(stub), index_id_(index_id), search_param_(search_param), out_result_(out_result) {}
+      : DocumentTask(stub),
+        index_id_(index_id),
+        search_param_(search_param),
+        out_result_(out_result),
+        top_n_(search_param.top_n) {}
 
   ~DocumentSearchTask() override = default;
 
@@ -58,6 +63,8 @@ class DocumentSearchTask : public DocumentTask {
   std::shared_mutex rw_lock_;
   std::set<int64_t> next_part_ids_;
   Status status_;
+  // best results of the finished partitions
+  DocumentTopN top_n_;
 
   std::atomic<int> sub_tasks_count_{0};
 };
@@ -70,8 +77,8 @@ class DocumentSearchPartTask : public DocumentTask {
 
   ~DocumentSearchPartTask() override = default;
 
-  std::vector<DocWithStore> GetDocSearchResult() {
-    std::shared_lock<std::shared_mutex> r(rw_lock_);
+  DocumentTopN TakeDocSearchResult() {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
     return std::move(search_result_);
   }
 
@@ -101,7 +108,7 @@ class DocumentSearchPartTask : public DocumentTask {
 
   std::shared_mutex rw_lock_;
   Status status_;
-  std::vector<DocWithStore> search_result_;
+  DocumentTopN search_result_;
 
   std::atomic<int> sub_tasks_count_{0};
 };
@@ -44,6 +44,12 @@ class DocumentTask {
 
   const ClientStub& stub;
 
+  // error fixed by re-route and resend the affected items, the task retry only the items still pending
+  static bool IsRetryError(const Status& status);
+
+  // status of an item whose region lookup failed, only a missing region is fixed by retry
+  static Status RegionLookupStatus(const Status& status);
+
  private:
   void FailOrRetry();
   bool NeedRetry();
@@ -0,0 +1,89 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/document/document_topn.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+
+struct BetterThan {
+  bool operator()(float a_score, int64_t a_id, float b_score, int64_t b_id) const {
+    return a_score > b_score || (a_score == b_score && a_id < b_id);
+  }
+
+  bool operator()(const DocWithStore& a, const DocWithStore& b) const {
+    return (*this)(a.score, a.doc_with_id.id, b.score, b.doc_with_id.id);
+  }
+};
+
+}  // namespace
+
+bool DocumentTopN::Accept(float score, int64_t id) const {
+  if (!Bounded() || Size() < top_n_) {
+    return true;
+  }
+
+  const auto& worst = heap_.front();
+  return BetterThan()(score, id, worst.score, worst.doc_with_id.id);
+}
+
+void DocumentTopN::Push(DocWithStore&& result) {
+  if (!Bounded()) {
+    heap_.push_back(std::move(result));
+    return;
+  }
+
+  BetterThan better;
+  if (Size() < top_n_) {
+    heap_.push_back(std::move(result));
+    std::push_heap(heap_.begin(), heap_.end(), better);
+  } else if (better(result, heap_.front())) {
+    std::pop_heap(heap_.begin(), heap_.end(), better);
+    heap_.back() = std::move(result);
+    std::push_heap(heap_.begin(), heap_.end(), better);
+  }
+}
+
+void DocumentTopN::Merge(DocumentTopN&& other) {
+  if (heap_.empty() && top_n_ == other.top_n_) {
+    heap_.swap(other.heap_);
+    return;
+  }
+
+  for (auto& result : other.heap_) {
+    Push(std::move(result));
+  }
+  other.heap_.clear();
+}
+
+std::vector<DocWithStore> DocumentTopN::Finish() {
+  BetterThan better;
+  if (Bounded()) {
+    std::sort_heap(heap_.begin(), heap_.end(), better);
+  } else {
+    std::sort(heap_.begin(), heap_.end(), better);
+  }
+
+  std::vector<DocWithStore> results;
+  results.swap(heap_);
+  return results;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,58 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_DOCUMENT_TOPN_H_
+#define DINGODB_SDK_DOCUMENT_TOPN_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "dingosdk/document.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Bounded best-n collector of a document search, higher score is better and equal scores rank the smaller id first
+// so the merged order does not depend on which region answered first. Results of regions and partitions are pushed
+// as they arrive, check Accept before translating a hit to skip the ones that can not make the top n.
+// top_n <= 0 keeps all results.
+class DocumentTopN {
+ public:
+  explicit DocumentTopN(int64_t top_n = 0) : top_n_(top_n) {}
+
+  ~DocumentTopN() = default;
+
+  bool Accept(float score, int64_t id) const;
+
+  void Push(DocWithStore&& result);
+
+  void Merge(DocumentTopN&& other);
+
+  int64_t Size() const { return heap_.size(); }
+
+  // return kept results sorted from best to worst, the collector is empty after
+  std::vector<DocWithStore> Finish();
+
+ private:
+  bool Bounded() const { return top_n_ > 0; }
+
+  int64_t top_n_;
+  // when bounded it is a heap with the worst kept result on top
+  std::vector<DocWithStore> heap_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_DOCUMENT_TOPN_H_
@@ -23,7 +23,6 @@
 #include "proto/common.pb.h"
 #include "proto/meta.pb.h"
 #include "sdk/document/document_codec.h"
-#include "sdk/document/document_doc_value_internal.h"
 #include "sdk/types_util.h"
 
 namespace dingodb {
@@ -70,30 +69,30 @@ class DocumentTranslater {
 
   static pb::common::DocumentValue DocValue2InternalDocumentValuePB(const DocValue& doc_value) {
     pb::common::DocumentValue result;
-    result.set_field_type(Type2InternalScalarFieldTypePB(doc_value.data_->type));
+    result.set_field_type(Type2InternalScalarFieldTypePB(doc_value.GetType()));
 
     auto* pb_field = result.mutable_field_value();
-    switch (doc_value.data_->type) {
+    switch (doc_value.GetType()) {
       case kINT64:
-        pb_field->set_long_data(doc_value.data_->int_val);
+        pb_field->set_long_data(doc_value.IntValue());
         break;
       case kDOUBLE:
-        pb_field->set_double_data(doc_value.data_->double_val);
+        pb_field->set_double_data(doc_value.DoubleValue());
         break;
       case kSTRING:
-        pb_field->set_string_data(doc_value.data_->string_val);
+        pb_field->set_string_data(doc_value.StringValue());
         break;
       case kBYTES:
-        pb_field->set_bytes_data(doc_value.data_->string_val);
+        pb_field->set_bytes_data(doc_value.BytesValue());
         break;
       case kBOOL:
-        pb_field->set_bool_data(doc_value.data_->bool_val);
+        pb_field->set_bool_data(doc_value.BoolValue());
         break;
       case kDATETIME:
-        pb_field->set_datetime_data(doc_value.data_->string_val);
+        pb_field->set_datetime_data(doc_value.DatetimeValue());
         break;
       default:
-        CHECK(false) << "unsupported doc value type:" << TypeToString(doc_value.data_->type);
+        CHECK(false) << "unsupported doc value type:" << TypeToString(doc_value.GetType());
     }
 
     return result;
@@ -136,9 +135,12 @@ class DocumentTranslater {
     DocWithId to_return;
     to_return.id = pb.id();
 
+    // keys of the pb map are unique, the fields are appended without lookup
     const auto& doc_pb = pb.document();
+    auto& fields = to_return.doc.fields_;
+    fields.reserve(doc_pb.document_data().size());
     for (const auto& [key, doc_value_pb] : doc_pb.document_data()) {
-      to_return.doc.AddField(key, InternalDocumentValuePb2DocValue(doc_value_pb));
+      fields.emplace_back(key, InternalDocumentValuePb2DocValue(doc_value_pb));
     }
 
     return std::move(to_return);
@@ -14,12 +14,14 @@
 
 #include "sdk/document/document_update_task.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <unordered_map>
 
 #include "glog/logging.h"
 #include "sdk/auto_increment_manager.h"
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
 #include "sdk/document/document_helper.h"
 #include "sdk/document/document_index.h"
 #include "sdk/document/document_translater.h"
@@ -76,21 +78,43 @@ void DocumentUpdateTask::DoAsync() {
 
   auto meta_cache = stub.GetMetaCache();
 
+  // sorted ids are routed by the id intervals of the index, meta cache is only asked for uncached ranges
+  std::vector<int64_t> ids;
+  ids.reserve(next_batch.size());
   for (const auto& [id, idx] : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(document_helper::DocumentIdToRangeKey(*doc_index_, id), tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    };
-
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
+    ids.push_back(id);
+  }
+  std::sort(ids.begin(), ids.end());
+
+  std::vector<std::shared_ptr<Region>> regions;
+  Status s = doc_index_->GetIdRegionMap().Route(*meta_cache, ids, regions);
+
+  for (size_t i = 0; i < ids.size(); i++) {
+    int64_t id = ids[i];
+    const auto& region = regions[i];
+    if (region == nullptr) {
+      // keep the id pending and route the others, it is resent in next round
+      DINGO_LOG(WARNING) << "lookup region fail, id: " << id << ", status: " << s.ToString();
+      Status lookup_status = RegionLookupStatus(s);
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      if (status_.ok() || (IsRetryError(status_) && !IsRetryError(lookup_status))) {
+        status_ = lookup_status;
+      }
+      continue;
     }
 
-    region_docs_to_ids[tmp->RegionId()].push_back(id);
+    region_id_to_region.try_emplace(region->RegionId(), region);
+    region_docs_to_ids[region->RegionId()].push_back(id);
+  }
+
+  if (region_docs_to_ids.empty()) {
+    Status tmp;
+    {
+      std::shared_lock<std::shared_mutex> r(rw_lock_);
+      tmp = status_;
+    }
+    DoAsyncDone(tmp);
+    return;
   }
 
   controllers_.clear();
@@ -103,31 +127,37 @@ void DocumentUpdateTask::DoAsync() {
     CHECK(iter != region_id_to_region.end());
     auto region = iter->second;
 
-    auto rpc = std::make_unique<DocumentAddRpc>();
-    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
-
+    // split items of one region into multiple rpc bounded by count and bytes
+    RpcChunker chunker(FLAGS_index_rpc_max_batch_count, FLAGS_index_rpc_max_batch_bytes);
+    std::unique_ptr<DocumentAddRpc> rpc;
     for (const auto& id : entry.second) {
+      if (rpc == nullptr) {
+        rpc = std::make_unique<DocumentAddRpc>();
+        FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
+      }
+
       int64_t idx = doc_id_to_idx_[id];
-      DocumentTranslater::FillDocumentWithIdPB(rpc->MutableRequest()->add_documents(), docs_[idx]);
-    }
+      auto* doc_pb = rpc->MutableRequest()->add_documents();
+      DocumentTranslater::FillDocumentWithIdPB(doc_pb, docs_[idx]);
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+      if (chunker.Add(doc_pb->ByteSizeLong())) {
+        controllers_.emplace_back(stub, *rpc, region);
+        rpcs_.push_back(std::move(rpc));
+      }
+    }
 
-    rpcs_.push_back(std::move(rpc));
+    if (rpc != nullptr) {
+      controllers_.emplace_back(stub, *rpc, region);
+      rpcs_.push_back(std::move(rpc));
+    }
   }
 
-  DCHECK_EQ(rpcs_.size(), region_docs_to_ids.size());
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_docs_to_ids.size());
-
-  for (auto i = 0; i < region_docs_to_ids.size(); i++) {
-    auto& controller = controllers_[i];
-
-    controller.AsyncCall(
+  window_.Start(rpcs_.size(), FLAGS_index_rpc_max_in_flight, [this](int64_t i) {
+    controllers_[i].AsyncCall(
         [this, rpc = rpcs_[i].get()](auto&& s) { DocumentAddRpcCallback(std::forward<decltype(s)>(s), rpc); });
-  }
+  });
 }
 
 void DocumentUpdateTask::DocumentAddRpcCallback(const Status& status, DocumentAddRpc* rpc) {
@@ -136,8 +166,8 @@ void DocumentUpdateTask::DocumentAddRpcCallback(const Status& status, DocumentAd
                        << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    if (status_.ok()) {
-      // only return first fail status
+    if (status_.ok() || (IsRetryError(status_) && !IsRetryError(status))) {
+      // return first fail status, a fatal one wins over errors which only need resend
       status_ = status;
     }
   } else {
@@ -147,7 +177,7 @@ void DocumentUpdateTask::DocumentAddRpcCallback(const Status& status, DocumentAd
     }
   }
 
-  if (sub_tasks_count_.fetch_sub(1) == 1) {
+  if (window_.Done()) {
     Status tmp;
     {
       std::shared_lock<std::shared_mutex> r(rw_lock_);
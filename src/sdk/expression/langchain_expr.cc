@@ -121,6 +121,10 @@ std::string Val::ToString() const {
   std::ostringstream oss;
 
   oss << "Val(Type: " << TypeToString(type) << ", Name: " + name;
+  if (IsParam()) {
+    oss << ", Param: " << param << ")";
+    return oss.str();
+  }
   switch (type) {
     case kBOOL:
       oss << ", Value: " << std::any_cast<TypeOf<kBOOL>>(value);
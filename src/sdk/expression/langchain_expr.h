@@ -178,13 +178,22 @@ class Val : public Var {
  public:
   Val(std::string name, Type type, std::any value) : Var(std::move(name), type), value(value) {}
 
+  // placeholder of a bound parameter, value is given when the filter is bound,
+  // param_type is the value_type declared in json, type may be remapped to the schema type
+  Val(std::string name, Type type, std::string param, Type param_type)
+      : Var(std::move(name), type), param(std::move(param)), param_type(param_type) {}
+
   ~Val() override = default;
 
   std::any Accept(LangchainExprVisitor* visitor, void* target) override;
 
   std::string ToString() const override;
 
+  bool IsParam() const { return !param.empty(); }
+
   std::any value;
+  std::string param;
+  Type param_type{kTypeEnd};
 };
 
 }  // namespace expression
@@ -58,6 +58,7 @@ pb::common::CoprocessorV2 LangChainExprEncoder::EncodeToCoprocessor(LangchainExp
 }
 
 std::string LangChainExprEncoder::EncodeToFilter(LangchainExpr* expr) {
+  param_slots_.clear();
   std::string encode;
   encode.append(sizeof(FILTER), FILTER);
   Visit(expr, &encode);
@@ -240,28 +241,35 @@ static void Encode(int64_t value, std::string* dst) {
   }
 }
 
-std::any LangChainExprEncoder::VisitVal(Val* expr, void* target) {
-  std::string* dst = static_cast<std::string*>(target);
-  switch (expr->type) {
+void LangChainExprEncoder::EncodeValue(Type type, const std::any& value, std::string* dst) {
+  switch (type) {
     case kSTRING: {
-      std::string v = std::any_cast<TypeOf<kSTRING>>(expr->value);
-      Encode(v, dst);
+      Encode(std::any_cast<const TypeOf<kSTRING>&>(value), dst);
       break;
     }
     case kDOUBLE: {
-      Encode(std::any_cast<TypeOf<kDOUBLE>>(expr->value), dst);
+      Encode(std::any_cast<TypeOf<kDOUBLE>>(value), dst);
       break;
     }
     case kBOOL: {
-      Encode(std::any_cast<TypeOf<kBOOL>>(expr->value), dst);
+      Encode(std::any_cast<TypeOf<kBOOL>>(value), dst);
       break;
     }
     case kINT64: {
-      Encode(std::any_cast<TypeOf<kINT64>>(expr->value), dst);
+      Encode(std::any_cast<TypeOf<kINT64>>(value), dst);
       break;
     }
     default:
-      CHECK(false) << "unknown type: " << static_cast<int>(expr->type);
+      CHECK(false) << "unknown type: " << static_cast<int>(type);
+  }
+}
+
+std::any LangChainExprEncoder::VisitVal(Val* expr, void* target) {
+  std::string* dst = static_cast<std::string*>(target);
+  if (expr->IsParam()) {
+    param_slots_.push_back(ParamSlot{dst->size(), expr->param, expr->param_type, expr->type});
+  } else {
+    EncodeValue(expr->type, expr->value, dst);
   }
 
   return 0;
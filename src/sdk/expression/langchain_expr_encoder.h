@@ -16,8 +16,10 @@
 #define DINGODB_SDK_EXPRESSION_LANGCHAIN_EXPR_ENCODER_H_
 
 #include <cstdint>
+#include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "sdk/expression/langchain_expr.h"
 #include "sdk/expression/langchain_expr_visitor.h"
@@ -30,6 +32,15 @@ namespace expression {
 
 class LangChainExprEncoder : public LangchainExprVisitor {
  public:
+  // a bound parameter is not encoded, its encoded value is inserted at offset of the filter when bound
+  struct ParamSlot {
+    size_t offset;
+    std::string name;
+    // type declared in json and type of the encoded value
+    Type param_type;
+    Type type;
+  };
+
   LangChainExprEncoder() = default;
   ~LangChainExprEncoder() override = default;
 
@@ -59,6 +70,12 @@ class LangChainExprEncoder : public LangchainExprVisitor {
 
   std::any VisitVal(Val* expr, void* target) override;
 
+  // slots of the bound parameters in the last encoded filter, ordered by offset
+  const std::vector<ParamSlot>& GetParamSlots() const { return param_slots_; }
+
+  // value must hold TypeOf<type>
+  static void EncodeValue(Type type, const std::any& value, std::string* dst);
+
  private:
   struct AtrributeInfo {
     Type type;
@@ -67,6 +84,7 @@ class LangChainExprEncoder : public LangchainExprVisitor {
 
   std::unordered_map<std::string, AtrributeInfo> attributes_info_;
   std::vector<std::string> attribute_names_;
+  std::vector<ParamSlot> param_slots_;
 };
 
 }  // namespace expression
@@ -0,0 +1,175 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/expression/langchain_expr_evaluator.h"
+
+#include <any>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "glog/logging.h"
+#include "sdk/expression/langchain_prepared_filter.h"
+
+namespace dingodb {
+namespace sdk {
+namespace expression {
+
+using ScalarData = std::map<std::string, ScalarValue>;
+
+template <typename T>
+static int ThreeWayCompare(const T& a, const T& b) {
+  if (a < b) {
+    return -1;
+  }
+  return (b < a) ? 1 : 0;
+}
+
+bool LangChainExprEvaluator::Evaluate(LangchainExpr* expr, const std::map<std::string, ScalarValue>& scalar_data) {
+  return std::any_cast<bool>(Visit(expr, const_cast<ScalarData*>(&scalar_data)));
+}
+
+std::any LangChainExprEvaluator::VisitAndOperatorExpr(AndOperatorExpr* expr, void* target) {
+  for (const auto& arg : expr->args) {
+    if (!std::any_cast<bool>(Visit(arg.get(), target))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::any LangChainExprEvaluator::VisitOrOperatorExpr(OrOperatorExpr* expr, void* target) {
+  for (const auto& arg : expr->args) {
+    if (std::any_cast<bool>(Visit(arg.get(), target))) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::any LangChainExprEvaluator::VisitNotOperatorExpr(NotOperatorExpr* expr, void* target) {
+  CHECK_EQ(expr->args.size(), 1);
+  return !std::any_cast<bool>(Visit(expr->args[0].get(), target));
+}
+
+std::any LangChainExprEvaluator::VisitEqComparatorExpr(EqComparatorExpr* expr, void* target) {
+  int result = 0;
+  return Compare(expr, target, result) && result == 0;
+}
+
+std::any LangChainExprEvaluator::VisitNeComparatorExpr(NeComparatorExpr* expr, void* target) {
+  int result = 0;
+  return Compare(expr, target, result) && result != 0;
+}
+
+std::any LangChainExprEvaluator::VisitGteComparatorExpr(GteComparatorExpr* expr, void* target) {
+  int result = 0;
+  return Compare(expr, target, result) && result >= 0;
+}
+
+std::any LangChainExprEvaluator::VisitGtComparatorExpr(GtComparatorExpr* expr, void* target) {
+  int result = 0;
+  return Compare(expr, target, result) && result > 0;
+}
+
+std::any LangChainExprEvaluator::VisitLteComparatorExpr(LteComparatorExpr* expr, void* target) {
+  int result = 0;
+  return Compare(expr, target, result) && result <= 0;
+}
+
+std::any LangChainExprEvaluator::VisitLtComparatorExpr(LtComparatorExpr* expr, void* target) {
+  int result = 0;
+  return Compare(expr, target, result) && result < 0;
+}
+
+std::any LangChainExprEvaluator::VisitVar(Var* expr, void* target) {
+  const auto* scalar_data = static_cast<const ScalarData*>(target);
+  auto iter = scalar_data->find(expr->name);
+  if (iter == scalar_data->end() || iter->second.fields.empty()) {
+    return {};
+  }
+
+  return &iter->second;
+}
+
+std::any LangChainExprEvaluator::VisitVal(Val* expr, void* target) {
+  (void)target;
+  if (!expr->IsParam()) {
+    return expr->value;
+  }
+
+  if (params_ == nullptr) {
+    return {};
+  }
+
+  auto iter = params_->find(expr->param);
+  if (iter == params_->end()) {
+    return {};
+  }
+
+  return BindParamValue(expr->type, expr->param_type, iter->second);
+}
+
+bool LangChainExprEvaluator::Compare(ComparatorExpr* expr, void* target, int& result) {
+  std::any var = Visit(expr->var.get(), target);
+  std::any val = Visit(expr->val.get(), target);
+  if (!var.has_value() || !val.has_value()) {
+    return false;
+  }
+
+  const ScalarValue& scalar = *std::any_cast<const ScalarValue*>(var);
+  const ScalarField& field = scalar.fields[0];
+  Type val_type = expr->val->type;
+
+  switch (scalar.type) {
+    case kBOOL:
+      if (val_type != kBOOL) {
+        return false;
+      }
+      result = ThreeWayCompare(field.bool_data, std::any_cast<TypeOf<kBOOL>>(val));
+      return true;
+    case kINT64:
+      if (val_type == kINT64) {
+        result = ThreeWayCompare(field.long_data, std::any_cast<TypeOf<kINT64>>(val));
+        return true;
+      } else if (val_type == kDOUBLE) {
+        result = ThreeWayCompare(static_cast<TypeOf<kDOUBLE>>(field.long_data), std::any_cast<TypeOf<kDOUBLE>>(val));
+        return true;
+      }
+      return false;
+    case kDOUBLE:
+      if (val_type == kDOUBLE) {
+        result = ThreeWayCompare(field.double_data, std::any_cast<TypeOf<kDOUBLE>>(val));
+        return true;
+      } else if (val_type == kINT64) {
+        result = ThreeWayCompare(field.double_data, static_cast<TypeOf<kDOUBLE>>(std::any_cast<TypeOf<kINT64>>(val)));
+        return true;
+      }
+      return false;
+    case kSTRING:
+      if (val_type != kSTRING) {
+        return false;
+      }
+      result = ThreeWayCompare(field.string_data, std::any_cast<const TypeOf<kSTRING>&>(val));
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace expression
+}  // namespace sdk
+}  // namespace dingodb
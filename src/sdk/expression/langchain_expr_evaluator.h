@@ -0,0 +1,74 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_EXPRESSION_LANGCHAIN_EXPR_EVALUATOR_H_
+#define DINGODB_SDK_EXPRESSION_LANGCHAIN_EXPR_EVALUATOR_H_
+
+#include <any>
+#include <map>
+#include <string>
+
+#include "dingosdk/vector.h"
+#include "sdk/expression/langchain_expr.h"
+#include "sdk/expression/langchain_expr_visitor.h"
+
+namespace dingodb {
+namespace sdk {
+namespace expression {
+
+// Evaluate langchain expr on the scalar data of one vector at client, used to estimate filter selectivity on sampled
+// vectors. A comparator on a missing attribute, an unbound param or not comparable types is false.
+class LangChainExprEvaluator : public LangchainExprVisitor {
+ public:
+  // params binds the {"param": "<name>"} values, may be nullptr when expr has no param
+  explicit LangChainExprEvaluator(const std::map<std::string, ScalarField>* params = nullptr) : params_(params) {}
+  ~LangChainExprEvaluator() override = default;
+
+  bool Evaluate(LangchainExpr* expr, const std::map<std::string, ScalarValue>& scalar_data);
+
+  std::any VisitAndOperatorExpr(AndOperatorExpr* expr, void* target) override;
+
+  std::any VisitOrOperatorExpr(OrOperatorExpr* expr, void* target) override;
+
+  std::any VisitNotOperatorExpr(NotOperatorExpr* expr, void* target) override;
+
+  std::any VisitEqComparatorExpr(EqComparatorExpr* expr, void* target) override;
+
+  std::any VisitNeComparatorExpr(NeComparatorExpr* expr, void* target) override;
+
+  std::any VisitGteComparatorExpr(GteComparatorExpr* expr, void* target) override;
+
+  std::any VisitGtComparatorExpr(GtComparatorExpr* expr, void* target) override;
+
+  std::any VisitLteComparatorExpr(LteComparatorExpr* expr, void* target) override;
+
+  std::any VisitLtComparatorExpr(LtComparatorExpr* expr, void* target) override;
+
+  std::any VisitVar(Var* expr, void* target) override;
+
+  // return the literal or bound value, empty when the param is not bound
+  std::any VisitVal(Val* expr, void* target) override;
+
+ private:
+  // three way compare attribute of the vector with the value, return false when not comparable
+  bool Compare(ComparatorExpr* expr, void* target, int& result);
+
+  const std::map<std::string, ScalarField>* params_;
+};
+
+}  // namespace expression
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_EXPRESSION_LANGCHAIN_EXPR_EVALUATOR_H_
@@ -93,24 +93,38 @@ Status CreateComparatorExpr(LangchainExprFactory* expr_factory, const nlohmann::
     return Status::InvalidArgument("Unknown value type: " + value_type);
   }
 
+  Type declared_type = type;
   DINGO_RETURN_NOT_OK(expr_factory->MaybeRemapType(name, type));
 
+  // "value": {"param": "<name>"} is a placeholder bound per query
+  const nlohmann::json& value = j.at("value");
+  if (value.is_object()) {
+    std::string param = value.at("param");
+    if (param.empty()) {
+      return Status::InvalidArgument("param name is empty, attribute: " + name);
+    }
+    tmp->var = std::make_shared<Var>(name, type);
+    tmp->val = std::make_shared<Val>(name, type, std::move(param), declared_type);
+    expr = std::move(tmp);
+    return Status::OK();
+  }
+
   switch (type) {
     case kBOOL:
       tmp->var = std::make_shared<Var>(name, kBOOL);
-      tmp->val = std::make_shared<Val>(name, kBOOL, j.at("value").get<TypeOf<kBOOL>>());
+      tmp->val = std::make_shared<Val>(name, kBOOL, value.get<TypeOf<kBOOL>>());
       break;
     case kINT64:
       tmp->var = std::make_shared<Var>(name, kINT64);
-      tmp->val = std::make_shared<Val>(name, kINT64, j.at("value").get<TypeOf<kINT64>>());
+      tmp->val = std::make_shared<Val>(name, kINT64, value.get<TypeOf<kINT64>>());
       break;
     case kDOUBLE:
       tmp->var = std::make_shared<Var>(name, kDOUBLE);
-      tmp->val = std::make_shared<Val>(name, kDOUBLE, j.at("value").get<TypeOf<kDOUBLE>>());
+      tmp->val = std::make_shared<Val>(name, kDOUBLE, value.get<TypeOf<kDOUBLE>>());
       break;
     case kSTRING:
       tmp->var = std::make_shared<Var>(name, kSTRING);
-      tmp->val = std::make_shared<Val>(name, kSTRING, j.at("value").get<TypeOf<kSTRING>>());
+      tmp->val = std::make_shared<Val>(name, kSTRING, value.get<TypeOf<kSTRING>>());
       break;
     default:
       CHECK(false) << "Unknown value type: " << value_type;
@@ -0,0 +1,159 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/expression/langchain_prepared_filter.h"
+
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <utility>
+
+#include "dingosdk/status.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/common/param_config.h"
+#include "sdk/expression/langchain_expr.h"
+#include "sdk/expression/langchain_expr_factory.h"
+
+namespace dingodb {
+namespace sdk {
+namespace expression {
+
+std::any BindParamValue(Type type, Type param_type, const ScalarField& field) {
+  switch (type) {
+    case kBOOL:
+      return TypeOf<kBOOL>(field.bool_data);
+    case kINT64:
+      return TypeOf<kINT64>(field.long_data);
+    case kDOUBLE:
+      // int64 value of a double attribute is remapped by schema
+      return (param_type == kINT64) ? static_cast<TypeOf<kDOUBLE>>(field.long_data) : field.double_data;
+    case kSTRING:
+      return field.string_data;
+    default:
+      CHECK(false) << "unknown type: " << static_cast<int>(type);
+  }
+  return {};
+}
+
+Status PreparedFilter::Compile(const std::string& expr_json, const std::unordered_map<std::string, Type>* schema,
+                               std::shared_ptr<const PreparedFilter>& out) {
+  std::unique_ptr<LangchainExprFactory> factory;
+  if (schema != nullptr && !schema->empty()) {
+    factory = std::make_unique<SchemaLangchainExprFactory>(*schema);
+  } else {
+    factory = std::make_unique<LangchainExprFactory>();
+  }
+
+  std::shared_ptr<LangchainExpr> expr;
+  try {
+    DINGO_RETURN_NOT_OK(factory->CreateExpr(expr_json, expr));
+  } catch (const nlohmann::json::exception& e) {
+    return Status::InvalidArgument(fmt::format("invalid langchain expr json: {}, error: {}", expr_json, e.what()));
+  }
+
+  LangChainExprEncoder encoder;
+  std::shared_ptr<PreparedFilter> filter(new PreparedFilter());
+  filter->coprocessor_ = encoder.EncodeToCoprocessor(expr.get());
+  filter->rel_expr_ = std::move(*filter->coprocessor_.mutable_rel_expr());
+  filter->coprocessor_.clear_rel_expr();
+  filter->param_slots_ = encoder.GetParamSlots();
+  filter->expr_ = std::move(expr);
+
+  out = std::move(filter);
+  return Status::OK();
+}
+
+Status PreparedFilter::Bind(const std::map<std::string, ScalarField>& params, pb::common::CoprocessorV2& out) const {
+  out = coprocessor_;
+  if (param_slots_.empty()) {
+    out.set_rel_expr(rel_expr_);
+    return Status::OK();
+  }
+
+  std::string* rel_expr = out.mutable_rel_expr();
+  rel_expr->reserve(rel_expr_.size() + param_slots_.size() * 16);
+
+  size_t pos = 0;
+  for (const auto& slot : param_slots_) {
+    auto iter = params.find(slot.name);
+    if (iter == params.end()) {
+      return Status::InvalidArgument("langchain expr param not bound: " + slot.name);
+    }
+
+    rel_expr->append(rel_expr_, pos, slot.offset - pos);
+    pos = slot.offset;
+    LangChainExprEncoder::EncodeValue(slot.type, BindParamValue(slot.type, slot.param_type, iter->second), rel_expr);
+  }
+  rel_expr->append(rel_expr_, pos, std::string::npos);
+
+  return Status::OK();
+}
+
+Status PreparedFilterCache::Get(const std::string& expr_json, std::shared_ptr<const PreparedFilter>& out) {
+  std::shared_ptr<const PreparedFilter> filter = Lookup(expr_json);
+  if (filter != nullptr) {
+    out = std::move(filter);
+    return Status::OK();
+  }
+
+  // keys of json object are sorted when dump, so the same expr with other key order or spaces shares the filter
+  std::string normalized;
+  try {
+    normalized = nlohmann::json::parse(expr_json).dump();
+  } catch (const nlohmann::json::exception& e) {
+    return Status::InvalidArgument(fmt::format("invalid langchain expr json: {}, error: {}", expr_json, e.what()));
+  }
+
+  filter = Lookup(normalized);
+  if (filter == nullptr) {
+    DINGO_RETURN_NOT_OK(PreparedFilter::Compile(normalized, &schema_, filter));
+    Insert(normalized, filter);
+  }
+
+  if (normalized != expr_json) {
+    Insert(expr_json, filter);
+  }
+
+  out = std::move(filter);
+  return Status::OK();
+}
+
+int64_t PreparedFilterCache::Size() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return filters_.size();
+}
+
+std::shared_ptr<const PreparedFilter> PreparedFilterCache::Lookup(const std::string& key) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = filters_.find(key);
+  return iter != filters_.end() ? iter->second : nullptr;
+}
+
+void PreparedFilterCache::Insert(const std::string& key, const std::shared_ptr<const PreparedFilter>& filter) {
+  if (FLAGS_langchain_filter_cache_capacity <= 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (static_cast<int64_t>(filters_.size()) >= FLAGS_langchain_filter_cache_capacity) {
+    VLOG(kSdkVlogLevel) << "langchain filter cache is full, clear " << filters_.size() << " filters";
+    filters_.clear();
+  }
+  filters_[key] = filter;
+}
+
+}  // namespace expression
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,102 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_EXPRESSION_LANGCHAIN_PREPARED_FILTER_H_
+#define DINGODB_SDK_EXPRESSION_LANGCHAIN_PREPARED_FILTER_H_
+
+#include <any>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dingosdk/status.h"
+#include "dingosdk/types.h"
+#include "dingosdk/vector.h"
+#include "proto/common.pb.h"
+#include "sdk/expression/langchain_expr.h"
+#include "sdk/expression/langchain_expr_encoder.h"
+
+namespace dingodb {
+namespace sdk {
+namespace expression {
+
+// value of a bound param as TypeOf<type>, param_type is the value_type declared in json
+std::any BindParamValue(Type type, Type param_type, const ScalarField& field);
+
+// langchain expr json compiled to coprocessor once, immutable and shared by queries.
+// values written as {"param": "<name>"} are bound per query by splicing their encoding into the filter.
+class PreparedFilter {
+ public:
+  PreparedFilter(const PreparedFilter&) = delete;
+  const PreparedFilter& operator=(const PreparedFilter&) = delete;
+
+  ~PreparedFilter() = default;
+
+  // schema may be nullptr, then the value types in json are used as is
+  static Status Compile(const std::string& expr_json, const std::unordered_map<std::string, Type>* schema,
+                        std::shared_ptr<const PreparedFilter>& out);
+
+  bool HasParams() const { return !param_slots_.empty(); }
+
+  // expr tree of the filter, must not be modified
+  LangchainExpr* GetExpr() const { return expr_.get(); }
+
+  // every param of the filter must be given, params not in the filter are ignored
+  Status Bind(const std::map<std::string, ScalarField>& params, pb::common::CoprocessorV2& out) const;
+
+ private:
+  PreparedFilter() = default;
+
+  std::shared_ptr<LangchainExpr> expr_;
+  // coprocessor without rel_expr
+  pb::common::CoprocessorV2 coprocessor_;
+  // encoded filter with the bound params left out
+  std::string rel_expr_;
+  std::vector<LangChainExprEncoder::ParamSlot> param_slots_;
+};
+
+// compiled filters of one vector index version, keyed by expr json and its normalized form
+class PreparedFilterCache {
+ public:
+  PreparedFilterCache(const PreparedFilterCache&) = delete;
+  const PreparedFilterCache& operator=(const PreparedFilterCache&) = delete;
+
+  // schema must outlive the cache
+  explicit PreparedFilterCache(const std::unordered_map<std::string, Type>& schema) : schema_(schema) {}
+
+  ~PreparedFilterCache() = default;
+
+  Status Get(const std::string& expr_json, std::shared_ptr<const PreparedFilter>& out);
+
+  int64_t Size();
+
+ private:
+  std::shared_ptr<const PreparedFilter> Lookup(const std::string& key);
+  void Insert(const std::string& key, const std::shared_ptr<const PreparedFilter>& filter);
+
+  const std::unordered_map<std::string, Type>& schema_;
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<const PreparedFilter>> filters_;
+};
+
+}  // namespace expression
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_EXPRESSION_LANGCHAIN_PREPARED_FILTER_H_
@@ -0,0 +1,182 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "sdk/id_region_map.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+#include "common/logging.h"
+#include "dingosdk/status.h"
+#include "glog/logging.h"
+#include "sdk/meta_cache.h"
+#include "sdk/utils/key_codec.h"
+
+namespace dingodb {
+namespace sdk {
+
+IdRegionMap::IdRegionMap(char prefix, std::map<int64_t, int64_t> start_id_to_part_id)
+    : prefix_(prefix), start_id_to_part_id_(std::move(start_id_to_part_id)) {
+  CHECK(!start_id_to_part_id_.empty());
+}
+
+Status IdRegionMap::Route(MetaCache& meta_cache, const std::vector<int64_t>& ids,
+                          std::vector<std::shared_ptr<Region>>& out_regions) {
+  out_regions.assign(ids.size(), nullptr);
+
+  // walk the sorted ids along the intervals, only the ids out of all cached intervals need meta cache
+  std::vector<size_t> misses;
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    const Interval* current = nullptr;
+    for (size_t i = 0; i < ids.size(); i++) {
+      if (current == nullptr || !current->Contains(ids[i])) {
+        current = FindUnlocked(ids[i]);
+      }
+
+      if (current != nullptr) {
+        out_regions[i] = current->region;
+      } else {
+        misses.push_back(i);
+      }
+    }
+  }
+
+  if (misses.empty()) {
+    return Status::OK();
+  }
+
+  // lookup keys of the misses are encoded in one buffer, each run of misses in one partition by the batch codec
+  std::vector<int64_t> miss_ids;
+  miss_ids.reserve(misses.size());
+  for (size_t i : misses) {
+    miss_ids.push_back(ids[i]);
+  }
+
+  key_codec::IdKeyBuffer keys;
+  keys.Reserve(miss_ids.size());
+  size_t run_start = 0;
+  while (run_start < miss_ids.size()) {
+    Partition part = FindPartition(miss_ids[run_start]);
+    size_t run_end = run_start + 1;
+    while (run_end < miss_ids.size() && part.start_id <= miss_ids[run_end] && miss_ids[run_end] < part.end_id) {
+      run_end++;
+    }
+
+    keys.Append(prefix_, part.part_id, miss_ids.data() + run_start, run_end - run_start);
+    run_start = run_end;
+  }
+
+  Status status;
+  Interval fetched;
+  for (size_t k = 0; k < misses.size(); k++) {
+    size_t i = misses[k];
+    int64_t id = ids[i];
+    if (fetched.region == nullptr || !fetched.Contains(id)) {
+      Status s = Fetch(meta_cache, id, keys.Key(k), fetched);
+      if (!s.ok()) {
+        DINGO_LOG(WARNING) << "lookup region fail, id: " << id << ", status: " << s.ToString();
+        fetched.region = nullptr;
+        status = s;
+        continue;
+      }
+    }
+
+    out_regions[i] = fetched.region;
+  }
+
+  return status;
+}
+
+Status IdRegionMap::Route(MetaCache& meta_cache, int64_t id, std::shared_ptr<Region>& region) {
+  {
+    std::shared_lock<std::shared_mutex> r(rw_lock_);
+    const Interval* interval = FindUnlocked(id);
+    if (interval != nullptr) {
+      region = interval->region;
+      return Status::OK();
+    }
+  }
+
+  char key[key_codec::kIdKeyLen];
+  key_codec::EncodeIdKey(prefix_, FindPartition(id).part_id, id, key);
+  Interval fetched;
+  DINGO_RETURN_NOT_OK(Fetch(meta_cache, id, std::string_view(key, key_codec::kIdKeyLen), fetched));
+  region = std::move(fetched.region);
+  return Status::OK();
+}
+
+size_t IdRegionMap::Size() const {
+  std::shared_lock<std::shared_mutex> r(rw_lock_);
+  return intervals_.size();
+}
+
+const IdRegionMap::Interval* IdRegionMap::FindUnlocked(int64_t id) const {
+  auto iter = intervals_.upper_bound(id);
+  if (iter == intervals_.begin()) {
+    return nullptr;
+  }
+
+  --iter;
+  return iter->second.Contains(id) ? &iter->second : nullptr;
+}
+
+IdRegionMap::Partition IdRegionMap::FindPartition(int64_t id) const {
+  auto part_iter = start_id_to_part_id_.upper_bound(id);
+  CHECK(part_iter != start_id_to_part_id_.begin()) << "id is before all partitions, id: " << id;
+  Partition part;
+  part.end_id = (part_iter == start_id_to_part_id_.end()) ? std::numeric_limits<int64_t>::max() : part_iter->first;
+  --part_iter;
+  part.start_id = part_iter->first;
+  part.part_id = part_iter->second;
+  return part;
+}
+
+Status IdRegionMap::Fetch(MetaCache& meta_cache, int64_t id, std::string_view key, Interval& interval) {
+  Partition part = FindPartition(id);
+  std::shared_ptr<Region> region;
+  DINGO_RETURN_NOT_OK(meta_cache.LookupRegionByKey(key, region));
+
+  const auto& range = region->Range();
+  interval.start_id = std::max(part.start_id, key_codec::IdLowerBound(range.start_key(), prefix_, part.part_id));
+  interval.end_id = std::min(part.end_id, key_codec::IdLowerBound(range.end_key(), prefix_, part.part_id));
+  interval.region = std::move(region);
+
+  if (!interval.Contains(id)) {
+    // the region is removed meanwhile, or id is the max id which no interval contains, do not cache it
+    return Status::OK();
+  }
+
+  std::unique_lock<std::shared_mutex> w(rw_lock_);
+  // intervals overlapping the new one belong to stale regions, or to an older epoch of the same range
+  auto iter = intervals_.lower_bound(interval.start_id);
+  if (iter != intervals_.begin() && std::prev(iter)->second.end_id > interval.start_id) {
+    --iter;
+  }
+  while (iter != intervals_.end() && iter->first < interval.end_id) {
+    iter = intervals_.erase(iter);
+  }
+  intervals_.emplace(interval.start_id, interval);
+
+  return Status::OK();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,95 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DINGODB_SDK_ID_REGION_MAP_H_
+#define DINGODB_SDK_ID_REGION_MAP_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <vector>
+
+#include "dingosdk/status.h"
+#include "sdk/region.h"
+
+namespace dingodb {
+namespace sdk {
+
+class MetaCache;
+
+// Routes the integer ids of a vector or document index to regions without encoding keys.
+// Every cached region is kept as the id interval it covers, clipped to its partition, so intervals never overlap
+// and a sorted batch of ids is routed by walking the intervals. The map is filled from MetaCache on miss, and an
+// interval is dropped once its region is marked stale, which MetaCache does whenever it removes or replaces the
+// region by a newer epoch, so the map never routes to a region MetaCache has given up.
+class IdRegionMap {
+ public:
+  IdRegionMap(const IdRegionMap&) = delete;
+  const IdRegionMap& operator=(const IdRegionMap&) = delete;
+
+  // start_id_to_part_id is the partitions of the index, key prefix of the index is prefix
+  IdRegionMap(char prefix, std::map<int64_t, int64_t> start_id_to_part_id);
+
+  ~IdRegionMap() = default;
+
+  // out_regions[i] is the region of ids[i], or nullptr when its lookup failed; return the last lookup failure.
+  // ids in any order are routed right, ascending ids are the fastest as the neighbours share an interval.
+  Status Route(MetaCache& meta_cache, const std::vector<int64_t>& ids,
+               std::vector<std::shared_ptr<Region>>& out_regions);
+
+  Status Route(MetaCache& meta_cache, int64_t id, std::shared_ptr<Region>& region);
+
+  // number of cached intervals, for tests
+  size_t Size() const;
+
+ private:
+  struct Interval {
+    // [start_id, end_id)
+    int64_t start_id{0};
+    int64_t end_id{0};
+    std::shared_ptr<Region> region;
+
+    bool Contains(int64_t id) const { return start_id <= id && id < end_id && !region->IsStale(); }
+  };
+
+  struct Partition {
+    // [start_id, end_id)
+    int64_t start_id{0};
+    int64_t end_id{0};
+    int64_t part_id{0};
+  };
+
+  const Interval* FindUnlocked(int64_t id) const;
+
+  Partition FindPartition(int64_t id) const;
+
+  // lookup region of id by its encoded key from meta cache and cache its interval
+  Status Fetch(MetaCache& meta_cache, int64_t id, std::string_view key, Interval& interval);
+
+  const char prefix_;
+  // partition start id -> partition id
+  const std::map<int64_t, int64_t> start_id_to_part_id_;
+
+  mutable std::shared_mutex rw_lock_;
+  // interval start id -> interval
+  std::map<int64_t, Interval> intervals_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_ID_REGION_MAP_H_
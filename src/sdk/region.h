@@ -52,6 +52,11 @@ class Region {
 
   const pb::common::Range& Range() const { return range_; }
 
+  // whether key is in [start_key, end_key), the key is compared in place without copy
+  bool ContainsKey(std::string_view key) const {
+    return key >= std::string_view(range_.start_key()) && key < std::string_view(range_.end_key());
+  }
+
   const pb::common::RegionEpoch& Epoch() const { return epoch_; }
 
   pb::common::RegionType RegionType() const { return region_type_; }
@@ -0,0 +1,68 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "sdk/rpc/rpc_batch.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+#include "glog/logging.h"
+
+namespace dingodb {
+namespace sdk {
+
+RpcChunker::RpcChunker(int64_t max_count, int64_t max_bytes) : max_count_(max_count), max_bytes_(max_bytes) {}
+
+bool RpcChunker::Add(int64_t bytes) {
+  count_++;
+  bytes_ += bytes;
+  if ((max_count_ > 0 && count_ >= max_count_) || (max_bytes_ > 0 && bytes_ >= max_bytes_)) {
+    count_ = 0;
+    bytes_ = 0;
+    return true;
+  }
+
+  return false;
+}
+
+void RpcWindow::Start(int64_t total, int64_t max_in_flight, std::function<void(int64_t)> send) {
+  CHECK_GT(total, 0);
+  total_ = total;
+  send_ = std::move(send);
+  done_.store(0);
+
+  // claim the first window up front, callback may finish the whole group before this loop end
+  int64_t count = std::min(total, std::max(max_in_flight, static_cast<int64_t>(1)));
+  next_.store(count);
+  for (int64_t i = 0; i < count; i++) {
+    send_(i);
+  }
+}
+
+bool RpcWindow::Done() {
+  SendNext();
+  return done_.fetch_add(1) + 1 == total_;
+}
+
+void RpcWindow::SendNext() {
+  int64_t i = next_.fetch_add(1);
+  if (i < total_) {
+    send_(i);
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
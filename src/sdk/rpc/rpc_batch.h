@@ -0,0 +1,69 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DINGODB_SDK_RPC_BATCH_H_
+#define DINGODB_SDK_RPC_BATCH_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace dingodb {
+namespace sdk {
+
+// Bound one rpc request built from a large batch by item count and encoded bytes.
+// Usage: call Add with the encoded size of every item appended to current request,
+// when it return true the request is full and the next item should go to a new request.
+class RpcChunker {
+ public:
+  RpcChunker(int64_t max_count, int64_t max_bytes);
+
+  ~RpcChunker() = default;
+
+  bool Add(int64_t bytes);
+
+ private:
+  const int64_t max_count_;
+  const int64_t max_bytes_;
+  int64_t count_{0};
+  int64_t bytes_{0};
+};
+
+// Send a group of rpc with at most max_in_flight rpc outstanding, rpc are sent in index order.
+// send(i) must start the i-th rpc, and the rpc callback must call Done once.
+class RpcWindow {
+ public:
+  RpcWindow() = default;
+
+  ~RpcWindow() = default;
+
+  void Start(int64_t total, int64_t max_in_flight, std::function<void(int64_t)> send);
+
+  // send the next rpc if any, return true when this is the last completed rpc
+  bool Done();
+
+ private:
+  void SendNext();
+
+  int64_t total_{0};
+  std::function<void(int64_t)> send_;
+  std::atomic<int64_t> next_{0};
+  std::atomic<int64_t> done_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_RPC_BATCH_H_
@@ -16,6 +16,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -41,9 +42,21 @@ namespace dingodb {
 namespace sdk {
 
 Transaction::TxnImpl::TxnImpl(const ClientStub& stub, const TransactionOptions& options)
-    : stub_(stub), options_(options), state_(kInit), buffer_(new TxnBuffer()) {}
+    : stub_(stub), options_(options), state_(kInit), buffer_(options.read_only ? nullptr : new TxnBuffer()) {}
 
 Status Transaction::TxnImpl::Begin() {
+  if (options_.snapshot_ts > 0) {
+    if (!options_.read_only) {
+      return Status::InvalidArgument("snapshot_ts is only for read only txn");
+    }
+
+    // stale read, no need to get tso
+    start_tso_ = Timestamp2Tso(options_.snapshot_ts);
+    start_ts_ = options_.snapshot_ts;
+    state_ = kActive;
+    return Status::OK();
+  }
+
   pb::meta::TsoTimestamp tso;
   Status ret = stub_.GetAdminTool()->GetCurrentTsoTimeStamp(tso);
   if (ret.ok()) {
@@ -116,6 +129,10 @@ Status Transaction::TxnImpl::DoTxnGet(const std::string& key, std::string& value
 }
 
 Status Transaction::TxnImpl::Get(const std::string& key, std::string& value) {
+  if (IsReadOnly()) {
+    return DoTxnGet(key, value);
+  }
+
   TxnMutation mutation;
   Status ret = buffer_->Get(key, mutation);
   if (ret.ok()) {
@@ -267,6 +284,10 @@ Status Transaction::TxnImpl::DoTxnBatchGet(const std::vector<std::string>& keys,
 }
 
 Status Transaction::TxnImpl::BatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& kvs) {
+  if (IsReadOnly()) {
+    return DoTxnBatchGet(keys, kvs);
+  }
+
   std::vector<std::string> not_found;
   std::vector<KVPair> to_return;
   Status ret;
@@ -305,19 +326,42 @@ Status Transaction::TxnImpl::BatchGet(const std::vector<std::string>& keys, std:
   return ret;
 }
 
-Status Transaction::TxnImpl::Put(const std::string& key, const std::string& value) { return buffer_->Put(key, value); }
+Status Transaction::TxnImpl::CheckWritable() const {
+  if (IsReadOnly()) {
+    return Status::IllegalState("forbid write in read only txn");
+  }
+  return Status::OK();
+}
+
+Status Transaction::TxnImpl::Put(const std::string& key, const std::string& value) {
+  DINGO_RETURN_NOT_OK(CheckWritable());
+  return buffer_->Put(key, value);
+}
 
-Status Transaction::TxnImpl::BatchPut(const std::vector<KVPair>& kvs) { return buffer_->BatchPut(kvs); }
+Status Transaction::TxnImpl::BatchPut(const std::vector<KVPair>& kvs) {
+  DINGO_RETURN_NOT_OK(CheckWritable());
+  return buffer_->BatchPut(kvs);
+}
 
 Status Transaction::TxnImpl::PutIfAbsent(const std::string& key, const std::string& value) {
+  DINGO_RETURN_NOT_OK(CheckWritable());
   return buffer_->PutIfAbsent(key, value);
 }
 
-Status Transaction::TxnImpl::BatchPutIfAbsent(const std::vector<KVPair>& kvs) { return buffer_->BatchPutIfAbsent(kvs); }
+Status Transaction::TxnImpl::BatchPutIfAbsent(const std::vector<KVPair>& kvs) {
+  DINGO_RETURN_NOT_OK(CheckWritable());
+  return buffer_->BatchPutIfAbsent(kvs);
+}
 
-Status Transaction::TxnImpl::Delete(const std::string& key) { return buffer_->Delete(key); }
+Status Transaction::TxnImpl::Delete(const std::string& key) {
+  DINGO_RETURN_NOT_OK(CheckWritable());
+  return buffer_->Delete(key);
+}
 
-Status Transaction::TxnImpl::BatchDelete(const std::vector<std::string>& keys) { return buffer_->BatchDelete(keys); }
+Status Transaction::TxnImpl::BatchDelete(const std::vector<std::string>& keys) {
+  DINGO_RETURN_NOT_OK(CheckWritable());
+  return buffer_->BatchDelete(keys);
+}
 
 Status Transaction::TxnImpl::ProcessScanState(ScanState& scan_state, uint64_t limit, std::vector<KVPair>& out_kvs) {
   int mutations_offset = 0;
@@ -386,6 +430,11 @@ Status Transaction::TxnImpl::Scan(const std::string& start_key, const std::strin
 
   DINGO_LOG(INFO) << fmt::format("scan range [{}, {}), limit:{}", StringToHex(start_key), StringToHex(end_key), limit);
 
+  // no local mutations to merge, scan all regions at once
+  if (IsReadOnly() && limit == 0) {
+    return DoParallelScan(start_key, end_key, out_kvs);
+  }
+
   auto meta_cache = stub_.GetMetaCache();
   // check whether region exist
   std::shared_ptr<Region> region;
@@ -401,7 +450,9 @@ Status Transaction::TxnImpl::Scan(const std::string& start_key, const std::strin
   auto it = scan_states_.find(state_key);
   if (it == scan_states_.end()) {
     ScanState scan_state = {.next_key = start_key};
-    CHECK(buffer_->Range(start_key, end_key, scan_state.local_mutations).ok());
+    if (!IsReadOnly()) {
+      CHECK(buffer_->Range(start_key, end_key, scan_state.local_mutations).ok());
+    }
 
     scan_states_.emplace(std::make_pair(state_key, std::move(scan_state)));
     it = scan_states_.find(state_key);
@@ -491,6 +542,86 @@ Status Transaction::TxnImpl::Scan(const std::string& start_key, const std::strin
   return Status::OK();
 }
 
+Status Transaction::TxnImpl::DoParallelScan(const std::string& start_key, const std::string& end_key,
+                                            std::vector<KVPair>& out_kvs) {
+  struct RegionScanTask {
+    RegionPtr region;
+    std::string start_key;
+    std::string end_key;
+    Status status;
+    std::vector<KVPair> kvs;
+  };
+
+  auto meta_cache = stub_.GetMetaCache();
+
+  // regions are in key order
+  std::vector<RegionScanTask> tasks;
+  std::string next_key = start_key;
+  while (next_key < end_key) {
+    RegionPtr region;
+    Status status = meta_cache->LookupRegionBetweenRange(next_key, end_key, region);
+    if (status.IsNotFound()) {
+      break;
+    } else if (!status.IsOK()) {
+      DINGO_LOG(WARNING) << fmt::format("lookup region fail, range[{}, {}) {}.", StringToHex(next_key),
+                                        StringToHex(end_key), status.ToString());
+      return status;
+    }
+
+    RegionScanTask task;
+    task.start_key = next_key <= region->Range().start_key() ? region->Range().start_key() : next_key;
+    task.end_key = end_key <= region->Range().end_key() ? end_key : region->Range().end_key();
+    next_key = region->Range().end_key();
+    task.region = std::move(region);
+    tasks.push_back(std::move(task));
+  }
+
+  DINGO_LOG(INFO) << fmt::format("parallel scan range [{}, {}), region count:{}", StringToHex(start_key),
+                                 StringToHex(end_key), tasks.size());
+
+  uint32_t max_parallel = std::max(FLAGS_txn_parallel_scan_regions, int64_t{1});
+  ParallelExecutor::ExecuteWithLimit(tasks.size(), max_parallel, [&tasks, this](uint32_t i) {
+    auto& task = tasks[i];
+
+    std::shared_ptr<RegionScanner> scanner;
+    ScannerOptions scan_options(stub_, task.region, task.start_key, task.end_key, options_, start_ts_);
+    task.status = stub_.GetTxnRegionScannerFactory()->NewRegionScanner(scan_options, scanner);
+    if (!task.status.IsOK()) {
+      return;
+    }
+    task.status = scanner->Open();
+    if (!task.status.IsOK()) {
+      return;
+    }
+
+    while (scanner->HasMore()) {
+      std::vector<KVPair> scan_kvs;
+      task.status = scanner->NextBatch(scan_kvs);
+      if (!task.status.IsOK() || scan_kvs.empty()) {
+        break;
+      }
+
+      task.kvs.insert(task.kvs.end(), std::make_move_iterator(scan_kvs.begin()),
+                      std::make_move_iterator(scan_kvs.end()));
+    }
+
+    scanner->Close();
+  });
+
+  for (auto& task : tasks) {
+    if (!task.status.IsOK()) {
+      DINGO_LOG(WARNING) << fmt::format("scan region:{} fail, {}.", task.region->RegionId(), task.status.ToString());
+      return task.status;
+    }
+  }
+
+  for (auto& task : tasks) {
+    out_kvs.insert(out_kvs.end(), std::make_move_iterator(task.kvs.begin()), std::make_move_iterator(task.kvs.end()));
+  }
+
+  return Status::OK();
+}
+
 std::unique_ptr<TxnPrewriteRpc> Transaction::TxnImpl::PrepareTxnPrewriteRpc(
     const std::shared_ptr<Region>& region) const {
   auto rpc = std::make_unique<TxnPrewriteRpc>();
@@ -528,18 +659,14 @@ void Transaction::TxnImpl::CheckAndLogPreCommitPrimaryKeyResponse(
 Status Transaction::TxnImpl::TryResolveTxnPrewriteLockConflict(const pb::store::TxnPrewriteResponse* response) const {
   Status ret;
   std::string pk = buffer_->GetPrimaryKey();
+  std::vector<pb::store::LockInfo> lock_infos;
   for (const auto& txn_result : response->txn_result()) {
     ret = CheckTxnResultInfo(txn_result);
 
     if (ret.ok()) {
       continue;
     } else if (ret.IsTxnLockConflict()) {
-      Status resolve = stub_.GetTxnLockResolver()->ResolveLock(txn_result.locked(), start_ts_);
-      if (!resolve.ok()) {
-        DINGO_LOG(WARNING) << "fail resolve lock pk:" << StringToHex(pk) << ", status:" << ret.ToString()
-                           << " txn_result:" << txn_result.ShortDebugString();
-        ret = resolve;
-      }
+      lock_infos.push_back(txn_result.locked());
     } else if (ret.IsTxnWriteConflict()) {
       DINGO_LOG(WARNING) << "write conflict pk:" << StringToHex(pk) << ", status:" << ret.ToString()
                          << " txn_result:" << txn_result.ShortDebugString();
@@ -550,6 +677,16 @@ Status Transaction::TxnImpl::TryResolveTxnPrewriteLockConflict(const pb::store::
     }
   }
 
+  // locks of one response are resolved together
+  if (!lock_infos.empty()) {
+    Status resolve = stub_.GetTxnLockResolver()->ResolveLocks(lock_infos, start_ts_);
+    if (!resolve.ok()) {
+      DINGO_LOG(WARNING) << "fail resolve " << lock_infos.size() << " locks pk:" << StringToHex(pk)
+                         << ", status:" << resolve.ToString();
+      ret = resolve;
+    }
+  }
+
   return ret;
 }
 
@@ -669,7 +806,7 @@ Status Transaction::TxnImpl::PreCommit() {
 
   state_ = kPreCommitting;
 
-  if (buffer_->IsEmpty()) {
+  if (IsReadOnly() || buffer_->IsEmpty()) {
     state_ = kPreCommitted;
     return Status::OK();
   }
@@ -853,7 +990,7 @@ Status Transaction::TxnImpl::Commit() {
                                             TransactionState2Str(kPreCommitted)));
   }
 
-  if (buffer_->IsEmpty()) {
+  if (IsReadOnly() || buffer_->IsEmpty()) {
     state_ = kCommitted;
     return Status::OK();
   }
@@ -1010,6 +1147,11 @@ Status Transaction::TxnImpl::Rollback() {
     return Status::IllegalState(fmt::format("forbid rollback, txn state is:{}", TransactionState2Str(state_)));
   }
 
+  if (IsReadOnly()) {
+    state_ = kRollbackted;
+    return Status::OK();
+  }
+
   auto meta_cache = stub_.GetMetaCache();
   std::string pk = buffer_->GetPrimaryKey();
 
@@ -64,7 +64,7 @@ static const char* TransactionState2Str(TransactionState state) {
   }
 }
 
-// TODO: support read only txn
+// Read only txn reads the snapshot of start_ts, it has no buffer, rejects write ops and commits without any rpc.
 class Transaction::TxnImpl {
  public:
   TxnImpl(const TxnImpl&) = delete;
@@ -103,6 +103,8 @@ class Transaction::TxnImpl {
 
   bool IsOnePc() const { return is_one_pc_; }
 
+  bool IsReadOnly() const { return options_.read_only; }
+
   TransactionState TEST_GetTransactionState() { return state_; }         // NOLINT
   int64_t TEST_GetStartTs() { return start_ts_; }                        // NOLINT
   int64_t TEST_GetCommitTs() { return commit_ts_; }                      // NOLINT
@@ -136,6 +138,11 @@ class Transaction::TxnImpl {
   void ProcessTxnBatchGetSubTask(TxnSubTask* sub_task);
   Status DoTxnBatchGet(const std::vector<std::string>& keys, std::vector<KVPair>& kvs);
 
+  // scan all regions of [start_key, end_key) in parallel, used by read only txn
+  Status DoParallelScan(const std::string& start_key, const std::string& end_key, std::vector<KVPair>& out_kvs);
+
+  Status CheckWritable() const;
+
   // txn commit
   std::unique_ptr<TxnPrewriteRpc> PrepareTxnPrewriteRpc(const std::shared_ptr<Region>& region) const;
   void CheckAndLogPreCommitPrimaryKeyResponse(const pb::store::TxnPrewriteResponse* response) const;
@@ -14,71 +14,156 @@
 
 #include "sdk/transaction/txn_lock_resolver.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "common/logging.h"
+#include "fmt/core.h"
 #include "glog/logging.h"
 #include "sdk/client_stub.h"
 #include "sdk/common/common.h"
+#include "sdk/common/helper.h"
+#include "sdk/common/param_config.h"
 #include "sdk/region.h"
 #include "sdk/rpc/store_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
+#include "sdk/utils/async_util.h"
 #include "dingosdk/status.h"
 
 namespace dingodb {
 namespace sdk {
 
+struct TxnLockResolver::TxnLocks {
+  int64_t lock_ts{0};
+  std::string primary_key;
+  // locked keys except primary key
+  std::set<std::string> keys;
+  TxnStatus txn_status;
+  Status status;
+};
+
+// one task runs on caller thread, more tasks run by at most FLAGS_txn_lock_resolve_max_parallel workers
+static void ParallelRun(uint32_t num, const std::function<void(uint32_t)>& func) {
+  if (num == 1) {
+    func(0);
+  } else if (num > 1) {
+    ParallelExecutor::ExecuteWithLimit(num, std::max(FLAGS_txn_lock_resolve_max_parallel, int64_t{1}), func);
+  }
+}
+
 TxnLockResolver::TxnLockResolver(const ClientStub& stub) : stub_(stub) {}
 
 // TODO: maybe support retry
 Status TxnLockResolver::ResolveLock(const pb::store::LockInfo& lock_info, int64_t caller_start_ts) {
   DINGO_LOG(DEBUG) << "lock_info:" << lock_info.DebugString();
-  TxnStatus txn_status;
-  Status ret = CheckTxnStatus(lock_info.lock_ts(), lock_info.primary_lock(), caller_start_ts, txn_status);
-  if (!ret.ok()) {
-    if (ret.IsNotFound()) {
-      DINGO_LOG(DEBUG) << "txn not exist when check txn status, status:" << ret.ToString()
-                       << ", lock_info:" << lock_info.DebugString();
-      return Status::OK();
-    } else {
-      return ret;
+  return ResolveLocks({lock_info}, caller_start_ts);
+}
+
+Status TxnLockResolver::ResolveLocks(const std::vector<pb::store::LockInfo>& lock_infos, int64_t caller_start_ts) {
+  if (lock_infos.empty()) {
+    return Status::OK();
+  }
+
+  // locks left by one txn share start_ts and primary key
+  std::map<std::pair<int64_t, std::string>, TxnLocks> txn_locks;
+  for (const auto& lock_info : lock_infos) {
+    auto& txn = txn_locks[{lock_info.lock_ts(), lock_info.primary_lock()}];
+    txn.lock_ts = lock_info.lock_ts();
+    txn.primary_key = lock_info.primary_lock();
+    if (lock_info.key() != lock_info.primary_lock()) {
+      txn.keys.insert(lock_info.key());
     }
   }
 
-  if (txn_status.IsLocked()) {
-    return Status::TxnLockConflict(ret.ToString());
+  // final status of txns met before skips checking primary key
+  auto txn_status_cache = stub_.GetTxnStatusCache();
+  std::vector<TxnLocks*> txns;
+  std::vector<TxnLocks*> to_check;
+  txns.reserve(txn_locks.size());
+  for (auto& [_, txn] : txn_locks) {
+    txns.push_back(&txn);
+    if (!txn_status_cache->Get(txn.lock_ts, txn.txn_status)) {
+      to_check.push_back(&txn);
+    }
   }
 
-  CHECK(txn_status.IsCommitted() || txn_status.IsRollbacked()) << "unexpected txn_status:" << txn_status.ToString();
+  if (!to_check.empty()) {
+    int64_t current_ts;
+    DINGO_RETURN_NOT_OK(stub_.GetAdminTool()->GetCurrentTimeStamp(current_ts));
+
+    ParallelRun(to_check.size(), [&](uint32_t i) {
+      TxnLocks* txn = to_check[i];
+      txn->status = CheckTxnStatus(txn->lock_ts, txn->primary_key, caller_start_ts, current_ts, txn->txn_status);
+      if (txn->status.ok()) {
+        txn_status_cache->Put(txn->lock_ts, txn->txn_status);
+      }
+    });
+  }
+
+  Status result;
+  std::vector<TxnLocks*> to_resolve;
+  for (auto* txn : txns) {
+    if (!txn->status.ok()) {
+      if (txn->status.IsNotFound()) {
+        DINGO_LOG(DEBUG) << "txn not exist when check txn status, status:" << txn->status.ToString()
+                         << ", lock_ts:" << txn->lock_ts << ", primary_key:" << StringToHex(txn->primary_key);
+      } else if (result.ok()) {
+        result = txn->status;
+      }
+      continue;
+    }
+
+    if (txn->txn_status.IsLocked()) {
+      if (result.ok()) {
+        result = Status::TxnLockConflict(fmt::format("txn:{} is alive, txn_status:{}", txn->lock_ts,
+                                                     txn->txn_status.ToString()));
+      }
+      continue;
+    }
+
+    CHECK(txn->txn_status.IsCommitted() || txn->txn_status.IsRollbacked())
+        << "unexpected txn_status:" << txn->txn_status.ToString();
+    to_resolve.push_back(txn);
+  }
 
   // resolve primary key
-  ret = ResolveLockKey(lock_info.lock_ts(), lock_info.primary_lock(), txn_status.commit_ts);
-  if (!ret.IsOK()) {
-    DINGO_LOG(WARNING) << "resolve txn:" << lock_info.lock_ts() << " primary_key:" << lock_info.primary_lock()
-                       << " txn_status:" << txn_status.ToString() << " fail, status:" << ret.ToString();
-    return ret;
+  ResolveTxnKeys(to_resolve, true);
+
+  std::vector<TxnLocks*> to_resolve_keys;
+  for (auto* txn : to_resolve) {
+    if (!txn->status.ok()) {
+      if (result.ok()) {
+        result = txn->status;
+      }
+    } else if (!txn->keys.empty()) {
+      to_resolve_keys.push_back(txn);
+    }
   }
 
-  // resolve conflict key
-  ret = ResolveLockKey(lock_info.lock_ts(), lock_info.key(), txn_status.commit_ts);
-  if (!ret.IsOK()) {
-    DINGO_LOG(WARNING) << "resolve txn:" << lock_info.lock_ts() << " key:" << lock_info.key()
-                       << " txn_status:" << txn_status.ToString() << " fail, status:" << ret.ToString();
-    return ret;
+  // resolve conflict keys
+  ResolveTxnKeys(to_resolve_keys, false);
+
+  for (auto* txn : to_resolve_keys) {
+    if (!txn->status.ok() && result.ok()) {
+      result = txn->status;
+    }
   }
 
-  return Status::OK();
+  return result;
 }
 
-// TODO: use txn status cache
 Status TxnLockResolver::CheckTxnStatus(int64_t txn_start_ts, const std::string& txn_primary_key,
-                                       int64_t caller_start_ts, TxnStatus& txn_status) {
+                                       int64_t caller_start_ts, int64_t current_ts, TxnStatus& txn_status) {
   std::shared_ptr<Region> region;
   DINGO_RETURN_NOT_OK(stub_.GetMetaCache()->LookupRegionByKey(txn_primary_key, region));
 
-  int64_t current_ts;
-  DINGO_RETURN_NOT_OK(stub_.GetAdminTool()->GetCurrentTimeStamp(current_ts));
-
   TxnCheckTxnStatusRpc rpc;
 
   // NOTE: use randome isolation is ok?
@@ -117,21 +202,75 @@ Status TxnLockResolver::ProcessTxnCheckStatusResponse(const pb::store::TxnCheckT
   return Status::OK();
 }
 
-Status TxnLockResolver::ResolveLockKey(int64_t txn_start_ts, const std::string& key, int64_t commit_ts) {
-  std::shared_ptr<Region> region;
-  Status ret = stub_.GetMetaCache()->LookupRegionByKey(key, region);
-  if (!ret.IsOK()) {
-    return ret;
+void TxnLockResolver::ResolveTxnKeys(std::vector<TxnLocks*>& txns, bool primary) {
+  struct Batch {
+    TxnLocks* txn;
+    std::shared_ptr<Region> region;
+    std::vector<std::string> keys;
+    Status status;
+  };
+
+  // txn and region id to the keys resolved by one rpc
+  std::map<std::pair<TxnLocks*, int64_t>, Batch> batches;
+  for (auto* txn : txns) {
+    std::vector<std::string> keys;
+    if (primary) {
+      keys.push_back(txn->primary_key);
+    } else {
+      keys.assign(txn->keys.begin(), txn->keys.end());
+    }
+
+    for (auto& key : keys) {
+      std::shared_ptr<Region> region;
+      Status s = stub_.GetMetaCache()->LookupRegionByKey(key, region);
+      if (!s.ok()) {
+        txn->status = s;
+        break;
+      }
+
+      auto& batch = batches[{txn, region->RegionId()}];
+      batch.txn = txn;
+      batch.region = region;
+      batch.keys.push_back(std::move(key));
+    }
+  }
+
+  std::vector<Batch*> rpcs;
+  rpcs.reserve(batches.size());
+  for (auto& [_, batch] : batches) {
+    rpcs.push_back(&batch);
+  }
+
+  ParallelRun(rpcs.size(), [&](uint32_t i) {
+    Batch* batch = rpcs[i];
+    batch->status =
+        ResolveLockKeys(batch->txn->lock_ts, batch->region, batch->keys, batch->txn->txn_status.commit_ts);
+  });
+
+  for (auto* batch : rpcs) {
+    if (!batch->status.ok()) {
+      DINGO_LOG(WARNING) << "resolve txn:" << batch->txn->lock_ts << (primary ? " primary_key" : " keys")
+                         << " in region:" << batch->region->RegionId() << " count:" << batch->keys.size()
+                         << " txn_status:" << batch->txn->txn_status.ToString()
+                         << " fail, status:" << batch->status.ToString();
+      if (batch->txn->status.ok()) {
+        batch->txn->status = batch->status;
+      }
+    }
   }
+}
 
+Status TxnLockResolver::ResolveLockKeys(int64_t txn_start_ts, const std::shared_ptr<Region>& region,
+                                        const std::vector<std::string>& keys, int64_t commit_ts) {
   TxnResolveLockRpc rpc;
   // NOTE: use randome isolation is ok?
   FillRpcContext(*rpc.MutableRequest()->mutable_context(), region->RegionId(), region->Epoch(),
                  pb::store::IsolationLevel::SnapshotIsolation);
   rpc.MutableRequest()->set_start_ts(txn_start_ts);
   rpc.MutableRequest()->set_commit_ts(commit_ts);
-  auto* fill = rpc.MutableRequest()->add_keys();
-  *fill = key;
+  for (const auto& key : keys) {
+    *rpc.MutableRequest()->add_keys() = key;
+  }
 
   StoreRpcController controller(stub_, rpc, region);
   DINGO_RETURN_NOT_OK(controller.Call());
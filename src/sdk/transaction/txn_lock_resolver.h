@@ -16,32 +16,19 @@
 #define DINGODB_SDK_TRANSACTION_LOCK_RESOLVER_H_
 
 #include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "dingosdk/status.h"
-#include "fmt/core.h"
 #include "proto/store.pb.h"
+#include "sdk/transaction/txn_status_cache.h"
 
 namespace dingodb {
 namespace sdk {
 
 class ClientStub;
-
-struct TxnStatus {
-  int64_t lock_ttl;
-  int64_t commit_ts;
-
-  explicit TxnStatus() : lock_ttl(-1), commit_ts(-1) {}
-
-  explicit TxnStatus(int64_t p_lock_ttl, int64_t p_commit_ts) : lock_ttl(p_lock_ttl), commit_ts(p_commit_ts) {}
-
-  bool IsCommitted() const { return commit_ts > 0; }
-
-  bool IsRollbacked() const { return lock_ttl == 0 && commit_ts == 0; }
-
-  bool IsLocked() const { return lock_ttl > 0; }
-
-  std::string ToString() const { return fmt::format("(lock_ttl:{}, commit_ts:{})", lock_ttl, commit_ts); }
-};
+class Region;
 
 class TxnLockResolver {
  public:
@@ -51,14 +38,25 @@ class TxnLockResolver {
 
   virtual Status ResolveLock(const pb::store::LockInfo& lock_info, int64_t caller_start_ts);
 
+  // Resolve many locks together. Locks are deduped by txn, the status of every txn is checked once, then primary keys
+  // and the other keys are resolved in two rounds, keys of one txn in one region by one rpc, all in parallel.
+  // Keys of a txn whose primary key fails to resolve are left. Return TxnLockConflict when some txn is still alive.
+  virtual Status ResolveLocks(const std::vector<pb::store::LockInfo>& lock_infos, int64_t caller_start_ts);
+
  private:
+  struct TxnLocks;
+
   Status CheckTxnStatus(int64_t txn_start_ts, const std::string& txn_primary_key, int64_t caller_start_ts,
-                        TxnStatus& txn_status);
+                        int64_t current_ts, TxnStatus& txn_status);
 
   static Status ProcessTxnCheckStatusResponse(const pb::store::TxnCheckTxnStatusResponse& response,
                                               TxnStatus& txn_status);
 
-  Status ResolveLockKey(int64_t txn_start_ts, const std::string& key, int64_t commit_ts);
+  // resolve primary keys or the other keys of txns, fill resolve status of each txn
+  void ResolveTxnKeys(std::vector<TxnLocks*>& txns, bool primary);
+
+  Status ResolveLockKeys(int64_t txn_start_ts, const std::shared_ptr<Region>& region,
+                         const std::vector<std::string>& keys, int64_t commit_ts);
 
   static Status ProcessTxnResolveLockResponse(const pb::store::TxnResolveLockResponse& response);
 
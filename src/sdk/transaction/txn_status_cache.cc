@@ -0,0 +1,71 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/transaction/txn_status_cache.h"
+
+#include <cstdint>
+#include <mutex>
+
+namespace dingodb {
+namespace sdk {
+
+TxnStatusCache::TxnStatusCache(int64_t capacity) : capacity_(capacity) {}
+
+bool TxnStatusCache::Get(int64_t start_ts, TxnStatus& out_status) {
+  if (!Enabled()) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = entries_.find(start_ts);
+  if (iter == entries_.end()) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  lru_.splice(lru_.begin(), lru_, iter->second);
+  out_status = iter->second->status;
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void TxnStatusCache::Put(int64_t start_ts, const TxnStatus& status) {
+  if (!Enabled() || !(status.IsCommitted() || status.IsRollbacked())) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = entries_.find(start_ts);
+  if (iter != entries_.end()) {
+    iter->second->status = status;
+    lru_.splice(lru_.begin(), lru_, iter->second);
+    return;
+  }
+
+  lru_.push_front(Entry{start_ts, status});
+  entries_[start_ts] = lru_.begin();
+
+  while (static_cast<int64_t>(lru_.size()) > capacity_) {
+    entries_.erase(lru_.back().start_ts);
+    lru_.pop_back();
+  }
+}
+
+int64_t TxnStatusCache::Size() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return lru_.size();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,88 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_TRANSACTION_TXN_STATUS_CACHE_H_
+#define DINGODB_SDK_TRANSACTION_TXN_STATUS_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "fmt/core.h"
+
+namespace dingodb {
+namespace sdk {
+
+struct TxnStatus {
+  int64_t lock_ttl;
+  int64_t commit_ts;
+
+  explicit TxnStatus() : lock_ttl(-1), commit_ts(-1) {}
+
+  explicit TxnStatus(int64_t p_lock_ttl, int64_t p_commit_ts) : lock_ttl(p_lock_ttl), commit_ts(p_commit_ts) {}
+
+  bool IsCommitted() const { return commit_ts > 0; }
+
+  bool IsRollbacked() const { return lock_ttl == 0 && commit_ts == 0; }
+
+  bool IsLocked() const { return lock_ttl > 0; }
+
+  std::string ToString() const { return fmt::format("(lock_ttl:{}, commit_ts:{})", lock_ttl, commit_ts); }
+};
+
+// LRU cache of the final status of txns, keyed by txn start_ts. A committed or rollbacked txn never changes its status,
+// so the entries never go stale, readers meet the leftover locks of one txn can skip checking its primary key.
+class TxnStatusCache {
+ public:
+  explicit TxnStatusCache(int64_t capacity);
+
+  ~TxnStatusCache() = default;
+
+  bool Enabled() const { return capacity_ > 0; }
+
+  bool Get(int64_t start_ts, TxnStatus& out_status);
+
+  // only committed or rollbacked status is cached
+  void Put(int64_t start_ts, const TxnStatus& status);
+
+  int64_t Size() const;
+
+  int64_t Hits() const { return hits_.load(std::memory_order_relaxed); }
+
+  int64_t Misses() const { return misses_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Entry {
+    int64_t start_ts;
+    TxnStatus status;
+  };
+
+  const int64_t capacity_;
+
+  mutable std::mutex mutex_;
+  // front is the most recently used
+  std::list<Entry> lru_;
+  std::unordered_map<int64_t, std::list<Entry>::iterator> entries_;
+
+  std::atomic<int64_t> hits_{0};
+  std::atomic<int64_t> misses_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_TRANSACTION_TXN_STATUS_CACHE_H_
@@ -17,8 +17,11 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <functional>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -154,6 +157,21 @@ class ParallelExecutor {
     }
 #endif  // USE_GRPC
   }
+
+  // run task_num tasks by at most max_parallel workers, each worker takes the next task index until all done
+  static void ExecuteWithLimit(uint32_t task_num, uint32_t max_parallel, std::function<void(uint32_t)> func) {
+    uint32_t worker_num = std::min(task_num, std::max(max_parallel, 1u));
+    if (worker_num == 0) {
+      return;
+    }
+
+    std::atomic<uint32_t> next_index{0};
+    Execute(worker_num, [&](uint32_t) {
+      for (uint32_t i = next_index.fetch_add(1); i < task_num; i = next_index.fetch_add(1)) {
+        func(i);
+      }
+    });
+  }
 };
 
 }  // namespace sdk
@@ -0,0 +1,215 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "sdk/utils/key_codec.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ && defined(__x86_64__)
+#define DINGO_KEY_CODEC_X86
+#include <immintrin.h>
+#elif __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ && defined(__ARM_NEON)
+#define DINGO_KEY_CODEC_NEON
+#include <arm_neon.h>
+#endif
+
+namespace dingodb {
+namespace sdk {
+namespace key_codec {
+
+// ids are transformed in blocks through a small stack buffer, then copied into the 17 bytes slots
+static constexpr size_t kBlockSize = 64;
+
+namespace scalar {
+
+static void EncodeIds(const int64_t* ids, uint64_t* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = ToBigEndian(static_cast<uint64_t>(ids[i]) ^ kSignBit);
+  }
+}
+
+static void DecodeIds(const uint64_t* encoded, int64_t* ids, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    ids[i] = static_cast<int64_t>(FromBigEndian(encoded[i]) ^ kSignBit);
+  }
+}
+
+}  // namespace scalar
+
+#if defined(DINGO_KEY_CODEC_X86)
+
+// built with a function target attribute and only used when the cpu supports avx2
+namespace avx2 {
+
+__attribute__((target("avx2"))) static inline __m256i ByteSwapMask() {
+  return _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13,
+                          12, 11, 10, 9, 8);
+}
+
+__attribute__((target("avx2"))) static void EncodeIds(const int64_t* ids, uint64_t* out, size_t count) {
+  const __m256i mask = ByteSwapMask();
+  const __m256i sign = _mm256_set1_epi64x(static_cast<int64_t>(kSignBit));
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + i));
+    v = _mm256_shuffle_epi8(_mm256_xor_si256(v, sign), mask);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+  }
+  scalar::EncodeIds(ids + i, out + i, count - i);
+}
+
+__attribute__((target("avx2"))) static void DecodeIds(const uint64_t* encoded, int64_t* ids, size_t count) {
+  const __m256i mask = ByteSwapMask();
+  const __m256i sign = _mm256_set1_epi64x(static_cast<int64_t>(kSignBit));
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(encoded + i));
+    v = _mm256_xor_si256(_mm256_shuffle_epi8(v, mask), sign);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(ids + i), v);
+  }
+  scalar::DecodeIds(encoded + i, ids + i, count - i);
+}
+
+}  // namespace avx2
+
+static std::vector<IdTransform> DetectTransforms() {
+  std::vector<IdTransform> transforms = {{"scalar", scalar::EncodeIds, scalar::DecodeIds}};
+
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    transforms.push_back({"avx2", avx2::EncodeIds, avx2::DecodeIds});
+  }
+  return transforms;
+}
+
+#elif defined(DINGO_KEY_CODEC_NEON)
+
+// neon is part of the aarch64 baseline, no runtime check is needed
+namespace neon {
+
+static void EncodeIds(const int64_t* ids, uint64_t* out, size_t count) {
+  const uint64x2_t sign = vdupq_n_u64(kSignBit);
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    uint64x2_t v = veorq_u64(vld1q_u64(reinterpret_cast<const uint64_t*>(ids + i)), sign);
+    vst1q_u64(out + i, vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(v))));
+  }
+  scalar::EncodeIds(ids + i, out + i, count - i);
+}
+
+static void DecodeIds(const uint64_t* encoded, int64_t* ids, size_t count) {
+  const uint64x2_t sign = vdupq_n_u64(kSignBit);
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    uint64x2_t v = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(vld1q_u64(encoded + i))));
+    vst1q_u64(reinterpret_cast<uint64_t*>(ids + i), veorq_u64(v, sign));
+  }
+  scalar::DecodeIds(encoded + i, ids + i, count - i);
+}
+
+}  // namespace neon
+
+static std::vector<IdTransform> DetectTransforms() {
+  return {{"scalar", scalar::EncodeIds, scalar::DecodeIds}, {"neon", neon::EncodeIds, neon::DecodeIds}};
+}
+
+#else
+
+static std::vector<IdTransform> DetectTransforms() { return {{"scalar", scalar::EncodeIds, scalar::DecodeIds}}; }
+
+#endif
+
+const std::vector<IdTransform>& SupportedTransforms() {
+  static const std::vector<IdTransform> kTransforms = DetectTransforms();
+  return kTransforms;
+}
+
+static const IdTransform& ActiveTransform() {
+  static const IdTransform& kActive = SupportedTransforms().back();
+  return kActive;
+}
+
+const char* SimdName() { return ActiveTransform().name; }
+
+static void EncodeIds(const int64_t* ids, uint64_t* out, size_t count) { ActiveTransform().encode(ids, out, count); }
+
+static void DecodeIds(const uint64_t* encoded, int64_t* ids, size_t count) {
+  ActiveTransform().decode(encoded, ids, count);
+}
+
+void EncodeIdKeys(char prefix, int64_t partition_id, const int64_t* ids, size_t count, char* out) {
+  char header[kIdKeyHeaderLen];
+  uint64_t part = ToBigEndian(static_cast<uint64_t>(partition_id));
+  header[0] = prefix;
+  memcpy(header + 1, &part, sizeof(part));
+
+  uint64_t block[kBlockSize];
+  for (size_t begin = 0; begin < count; begin += kBlockSize) {
+    size_t n = std::min(kBlockSize, count - begin);
+    EncodeIds(ids + begin, block, n);
+
+    char* key = out + begin * kIdKeyLen;
+    for (size_t i = 0; i < n; i++, key += kIdKeyLen) {
+      memcpy(key, header, kIdKeyHeaderLen);
+      memcpy(key + kIdKeyHeaderLen, &block[i], sizeof(uint64_t));
+    }
+  }
+}
+
+int64_t IdLowerBound(std::string_view key, char prefix, int64_t partition_id) {
+  char header[kIdKeyHeaderLen];
+  uint64_t part = ToBigEndian(static_cast<uint64_t>(partition_id));
+  header[0] = prefix;
+  memcpy(header + 1, &part, sizeof(part));
+
+  int cmp = memcmp(key.data(), header, std::min(key.size(), kIdKeyHeaderLen));
+  if (cmp < 0 || (cmp == 0 && key.size() <= kIdKeyHeaderLen)) {
+    return std::numeric_limits<int64_t>::min();
+  }
+  if (cmp > 0) {
+    return std::numeric_limits<int64_t>::max();
+  }
+
+  // a shorter id part is padded by zero, the padded key is the smallest id key not less than it
+  char padded[kIdKeyLen] = {0};
+  memcpy(padded, key.data(), std::min(key.size(), kIdKeyLen));
+  int64_t id = DecodeIdKey(padded);
+  if (key.size() > kIdKeyLen && id != std::numeric_limits<int64_t>::max()) {
+    // key of id is a prefix of the longer key, so it is less than the key
+    id++;
+  }
+  return id;
+}
+
+void DecodeIdKeys(const char* keys, size_t count, int64_t* ids) {
+  uint64_t block[kBlockSize];
+  for (size_t begin = 0; begin < count; begin += kBlockSize) {
+    size_t n = std::min(kBlockSize, count - begin);
+
+    const char* key = keys + begin * kIdKeyLen;
+    for (size_t i = 0; i < n; i++, key += kIdKeyLen) {
+      memcpy(&block[i], key + kIdKeyHeaderLen, sizeof(uint64_t));
+    }
+    DecodeIds(block, ids + begin, n);
+  }
+}
+
+}  // namespace key_codec
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,133 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DINGODB_SDK_KEY_CODEC_H_
+#define DINGODB_SDK_KEY_CODEC_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dingodb {
+namespace sdk {
+namespace key_codec {
+
+// Fixed length key of a vector or document id: prefix(1) + partition id(8, big endian) + id(8, big endian with
+// the sign bit flipped). Same bytes as vector_codec::EncodeVectorKey and document_codec::EncodeDocumentKey, so
+// keys of one partition sort as their ids.
+static constexpr size_t kIdKeyLen = 17;
+static constexpr size_t kIdKeyHeaderLen = 9;
+static constexpr uint64_t kSignBit = static_cast<uint64_t>(1) << 63;
+
+inline uint64_t ToBigEndian(uint64_t value) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  return __builtin_bswap64(value);
+#else
+  return value;
+#endif
+}
+
+inline uint64_t FromBigEndian(uint64_t value) { return ToBigEndian(value); }
+
+inline void EncodeIdKey(char prefix, int64_t partition_id, int64_t id, char* out) {
+  uint64_t part = ToBigEndian(static_cast<uint64_t>(partition_id));
+  uint64_t encoded = ToBigEndian(static_cast<uint64_t>(id) ^ kSignBit);
+  out[0] = prefix;
+  memcpy(out + 1, &part, sizeof(part));
+  memcpy(out + kIdKeyHeaderLen, &encoded, sizeof(encoded));
+}
+
+inline int64_t DecodeIdKey(const char* key) {
+  uint64_t encoded;
+  memcpy(&encoded, key + kIdKeyHeaderLen, sizeof(encoded));
+  return static_cast<int64_t>(FromBigEndian(encoded) ^ kSignBit);
+}
+
+inline int64_t DecodeIdKeyPartitionId(const char* key) {
+  uint64_t part;
+  memcpy(&part, key + 1, sizeof(part));
+  return static_cast<int64_t>(FromBigEndian(part));
+}
+
+// The smallest id of the partition whose key is not less than key, so the ids whose keys are in region range
+// [start_key, end_key) are [IdLowerBound(start_key), IdLowerBound(end_key)). Keys before the partition give
+// INT64_MIN and keys after it give INT64_MAX.
+int64_t IdLowerBound(std::string_view key, char prefix, int64_t partition_id);
+
+// Encode keys of count ids of one partition into out, which must hold count * kIdKeyLen bytes.
+void EncodeIdKeys(char prefix, int64_t partition_id, const int64_t* ids, size_t count, char* out);
+
+// Decode ids of count keys laid out back to back in keys.
+void DecodeIdKeys(const char* keys, size_t count, int64_t* ids);
+
+// Name of the instruction set used by the batch transform, for logging and tests.
+const char* SimdName();
+
+// Batch transform of ids to big endian sign flipped words and back, with one instruction set.
+struct IdTransform {
+  const char* name;
+  void (*encode)(const int64_t* ids, uint64_t* out, size_t count);
+  void (*decode)(const uint64_t* encoded, int64_t* ids, size_t count);
+};
+
+// Transforms built and supported by the running cpu, from scalar to the widest. The last one is used, avx2 is
+// picked at runtime on x86-64 and neon is always used on aarch64.
+const std::vector<IdTransform>& SupportedTransforms();
+
+// Keys of a batch of ids in one contiguous buffer, Key(i) views the i-th key without copying it.
+// Clear keeps the capacity, so a buffer reused across batches does not allocate per key.
+class IdKeyBuffer {
+ public:
+  IdKeyBuffer() = default;
+  ~IdKeyBuffer() = default;
+
+  void Clear() { buf_.clear(); }
+
+  void Reserve(size_t count) { buf_.reserve(count * kIdKeyLen); }
+
+  void Append(char prefix, int64_t partition_id, int64_t id) {
+    size_t offset = buf_.size();
+    buf_.resize(offset + kIdKeyLen);
+    EncodeIdKey(prefix, partition_id, id, buf_.data() + offset);
+  }
+
+  void Append(char prefix, int64_t partition_id, const int64_t* ids, size_t count) {
+    size_t offset = buf_.size();
+    buf_.resize(offset + count * kIdKeyLen);
+    EncodeIdKeys(prefix, partition_id, ids, count, buf_.data() + offset);
+  }
+
+  size_t Size() const { return buf_.size() / kIdKeyLen; }
+
+  bool Empty() const { return buf_.empty(); }
+
+  std::string_view Key(size_t i) const { return std::string_view(buf_.data() + i * kIdKeyLen, kIdKeyLen); }
+
+  int64_t Id(size_t i) const { return DecodeIdKey(buf_.data() + i * kIdKeyLen); }
+
+  const char* Data() const { return buf_.data(); }
+
+ private:
+  std::string buf_;
+};
+
+}  // namespace key_codec
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_KEY_CODEC_H_
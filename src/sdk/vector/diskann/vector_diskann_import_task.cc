@@ -8,6 +8,7 @@
 #include "glog/logging.h"
 #include "sdk/auto_increment_manager.h"
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
 #include "sdk/rpc/index_service_rpc.h"
 #include "dingosdk/status.h"
 #include "sdk/vector/vector_common.h"
@@ -18,10 +19,12 @@ namespace dingodb {
 namespace sdk {
 
 Status VectorImportAddTask::Init() {
-  if (vectors_.empty()) {
+  if (vectors_.Empty()) {
     return Status::InvalidArgument("vectors is empty, no need add vector");
   }
 
+  DINGO_RETURN_NOT_OK(vectors_.Check());
+
   std::shared_ptr<VectorIndex> tmp;
   DINGO_RETURN_NOT_OK(stub.GetVectorIndexCache()->GetVectorIndexById(index_id_, tmp));
   DCHECK_NOTNULL(tmp);
@@ -34,18 +37,16 @@ Status VectorImportAddTask::Init() {
   if (vector_index_->HasAutoIncrement()) {
     auto incrementer = stub.GetAutoIncrementerManager()->GetOrCreateVectorIndexIncrementer(vector_index_);
     std::vector<int64_t> ids;
-    int64_t id_count = vectors_.size();
+    int64_t id_count = vectors_.Size();
     ids.reserve(id_count);
 
     DINGO_RETURN_NOT_OK(incrementer->GetNextIds(ids, id_count));
     CHECK_EQ(ids.size(), id_count);
 
-    for (auto i = 0; i < id_count; i++) {
-      vectors_[i].id = ids[i];
-    }
+    vectors_.SetIds(ids);
   } else {
-    for (auto& vector : vectors_) {
-      int64_t id = vector.id;
+    for (int64_t i = 0; i < vectors_.Size(); i++) {
+      int64_t id = vectors_.GetId(i);
       if (id <= 0) {
         return Status::InvalidArgument("vector id must be positive");
       }
@@ -55,8 +56,8 @@ Status VectorImportAddTask::Init() {
   std::unique_lock<std::shared_mutex> w(rw_lock_);
   vector_id_to_idx_.clear();
 
-  for (int64_t i = 0; i < vectors_.size(); i++) {
-    int64_t id = vectors_[i].id;
+  for (int64_t i = 0; i < vectors_.Size(); i++) {
+    int64_t id = vectors_.GetId(i);
     if (!vector_id_to_idx_.insert(std::make_pair(id, i)).second) {
       return Status::InvalidArgument("duplicate vector id: " + std::to_string(id));
     }
@@ -87,10 +88,15 @@ void VectorImportAddTask::DoAsync() {
     std::shared_ptr<Region> tmp;
     Status s = meta_cache->LookupRegionByKey(vector_helper::VectorIdToRangeKey(*vector_index_, id), tmp);
     if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    };
+      // keep the id pending and route the others, it is resent in next round
+      DINGO_LOG(WARNING) << "lookup region fail, id: " << id << ", status: " << s.ToString();
+      Status lookup_status = RegionLookupStatus(s);
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      if (status_.ok() || (IsRetryError(status_) && !IsRetryError(lookup_status))) {
+        status_ = lookup_status;
+      }
+      continue;
+    }
 
     auto iter = region_id_to_region.find(tmp->RegionId());
     if (iter == region_id_to_region.end()) {
@@ -100,6 +106,16 @@ void VectorImportAddTask::DoAsync() {
     region_vectors_to_ids[tmp->RegionId()].push_back(id);
   }
 
+  if (region_vectors_to_ids.empty()) {
+    Status tmp;
+    {
+      std::shared_lock<std::shared_mutex> r(rw_lock_);
+      tmp = status_;
+    }
+    DoAsyncDone(tmp);
+    return;
+  }
+
   controllers_.clear();
   rpcs_.clear();
 
@@ -110,30 +126,37 @@ void VectorImportAddTask::DoAsync() {
     CHECK(iter != region_id_to_region.end());
     auto region = iter->second;
 
-    auto rpc = std::make_unique<VectorImportRpc>();
-    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
-
+    // split vectors of one region into multiple rpc bounded by count and bytes
+    RpcChunker chunker(FLAGS_index_rpc_max_batch_count, FLAGS_index_rpc_max_batch_bytes);
+    std::unique_ptr<VectorImportRpc> rpc;
     for (const auto& id : entry.second) {
+      if (rpc == nullptr) {
+        rpc = std::make_unique<VectorImportRpc>();
+        FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
+      }
+
       int64_t idx = vector_id_to_idx_[id];
-      FillVectorWithIdPB(rpc->MutableRequest()->add_vectors(), vectors_[idx]);
+      auto* vector_pb = rpc->MutableRequest()->add_vectors();
+      vectors_.FillVectorWithIdPB(vector_pb, idx);
+
+      if (chunker.Add(vector_pb->ByteSizeLong())) {
+        controllers_.emplace_back(stub, *rpc, region);
+        rpcs_.push_back(std::move(rpc));
+      }
     }
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
 
-    rpcs_.push_back(std::move(rpc));
+    if (rpc != nullptr) {
+      controllers_.emplace_back(stub, *rpc, region);
+      rpcs_.push_back(std::move(rpc));
+    }
   }
 
-  DCHECK_EQ(rpcs_.size(), region_vectors_to_ids.size());
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_vectors_to_ids.size());
-
-  for (auto i = 0; i < region_vectors_to_ids.size(); i++) {
-    auto& controller = controllers_[i];
-
-    controller.AsyncCall(
+  window_.Start(rpcs_.size(), FLAGS_index_rpc_max_in_flight, [this](int64_t i) {
+    controllers_[i].AsyncCall(
         [this, rpc = rpcs_[i].get()](auto&& s) { VectorImportAddRpcCallback(std::forward<decltype(s)>(s), rpc); });
-  }
+  });
 }
 
 void VectorImportAddTask::VectorImportAddRpcCallback(const Status& status, VectorImportRpc* rpc) {
@@ -142,8 +165,8 @@ void VectorImportAddTask::VectorImportAddRpcCallback(const Status& status, Vecto
                        << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    if (status_.ok()) {
-      // only return first fail status
+    if (status_.ok() || (IsRetryError(status_) && !IsRetryError(status))) {
+      // return first fail status, a fatal one wins over errors which only need resend
       status_ = status;
     }
   } else {
@@ -155,7 +178,7 @@ void VectorImportAddTask::VectorImportAddRpcCallback(const Status& status, Vecto
     }
   }
 
-  if (sub_tasks_count_.fetch_sub(1) == 1) {
+  if (window_.Done()) {
     Status tmp;
     {
       std::shared_lock<std::shared_mutex> r(rw_lock_);
@@ -210,10 +233,15 @@ void VectorImportDeleteTask::DoAsync() {
     std::shared_ptr<Region> tmp;
     Status s = meta_cache->LookupRegionByKey(vector_helper::VectorIdToRangeKey(*vector_index_, id), tmp);
     if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    };
+      // keep the id pending and route the others, it is resent in next round
+      DINGO_LOG(WARNING) << "lookup region fail, id: " << id << ", status: " << s.ToString();
+      Status lookup_status = RegionLookupStatus(s);
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      if (status_.ok() || (IsRetryError(status_) && !IsRetryError(lookup_status))) {
+        status_ = lookup_status;
+      }
+      continue;
+    }
 
     auto iter = region_id_to_region.find(tmp->RegionId());
     if (iter == region_id_to_region.end()) {
@@ -223,6 +251,16 @@ void VectorImportDeleteTask::DoAsync() {
     region_vectors_to_ids[tmp->RegionId()].push_back(id);
   }
 
+  if (region_vectors_to_ids.empty()) {
+    Status tmp;
+    {
+      std::shared_lock<std::shared_mutex> r(rw_lock_);
+      tmp = status_;
+    }
+    DoAsyncDone(tmp);
+    return;
+  }
+
   controllers_.clear();
   rpcs_.clear();
 
@@ -233,30 +271,34 @@ void VectorImportDeleteTask::DoAsync() {
     CHECK(iter != region_id_to_region.end());
     auto region = iter->second;
 
-    auto rpc = std::make_unique<VectorImportRpc>();
-    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
-
+    RpcChunker chunker(FLAGS_index_rpc_max_batch_count, FLAGS_index_rpc_max_batch_bytes);
+    std::unique_ptr<VectorImportRpc> rpc;
     for (const auto& id : entry.second) {
+      if (rpc == nullptr) {
+        rpc = std::make_unique<VectorImportRpc>();
+        FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
+      }
+
       rpc->MutableRequest()->add_delete_ids(id);
-    }
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+      if (chunker.Add(sizeof(int64_t))) {
+        controllers_.emplace_back(stub, *rpc, region);
+        rpcs_.push_back(std::move(rpc));
+      }
+    }
 
-    rpcs_.push_back(std::move(rpc));
+    if (rpc != nullptr) {
+      controllers_.emplace_back(stub, *rpc, region);
+      rpcs_.push_back(std::move(rpc));
+    }
   }
 
-  DCHECK_EQ(rpcs_.size(), region_vectors_to_ids.size());
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_vectors_to_ids.size());
-
-  for (auto i = 0; i < region_vectors_to_ids.size(); i++) {
-    auto& controller = controllers_[i];
-
-    controller.AsyncCall(
+  window_.Start(rpcs_.size(), FLAGS_index_rpc_max_in_flight, [this](int64_t i) {
+    controllers_[i].AsyncCall(
         [this, rpc = rpcs_[i].get()](auto&& s) { VectorImportDeleteRpcCallback(std::forward<decltype(s)>(s), rpc); });
-  }
+  });
 }
 
 void VectorImportDeleteTask::VectorImportDeleteRpcCallback(const Status& status, VectorImportRpc* rpc) {
@@ -265,8 +307,8 @@ void VectorImportDeleteTask::VectorImportDeleteRpcCallback(const Status& status,
                        << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    if (status_.ok()) {
-      // only return first fail status
+    if (status_.ok() || (IsRetryError(status_) && !IsRetryError(status))) {
+      // return first fail status, a fatal one wins over errors which only need resend
       status_ = status;
     }
   } else {
@@ -276,7 +318,7 @@ void VectorImportDeleteTask::VectorImportDeleteRpcCallback(const Status& status,
     }
   }
 
-  if (sub_tasks_count_.fetch_sub(1) == 1) {
+  if (window_.Done()) {
     Status tmp;
     {
       std::shared_lock<std::shared_mutex> r(rw_lock_);
@@ -8,8 +8,10 @@
 
 #include "sdk/client_stub.h"
 #include "sdk/rpc/index_service_rpc.h"
+#include "sdk/rpc/rpc_batch.h"
 #include "sdk/rpc/store_rpc_controller.h"
 #include "sdk/vector/vector_index.h"
+#include "sdk/vector/vector_rows.h"
 #include "sdk/vector/vector_task.h"
 
 namespace dingodb {
@@ -20,6 +22,9 @@ class VectorImportAddTask : public VectorTask {
   VectorImportAddTask(const ClientStub& stub, int64_t index_id, std::vector<VectorWithId>& vectors)
       : VectorTask(stub), index_id_(index_id), vectors_(vectors) {}
 
+  VectorImportAddTask(const ClientStub& stub, int64_t index_id, VectorBatch& batch)
+      : VectorTask(stub), index_id_(index_id), vectors_(batch) {}
+
   ~VectorImportAddTask() override = default;
 
  private:
@@ -30,7 +35,7 @@ class VectorImportAddTask : public VectorTask {
   std::string Name() const override { return fmt::format("VectorImportAddTask-{}", index_id_); }
 
   const int64_t index_id_;
-  std::vector<VectorWithId>& vectors_;
+  VectorRows vectors_;
 
   std::shared_ptr<VectorIndex> vector_index_;
 
@@ -41,7 +46,7 @@ class VectorImportAddTask : public VectorTask {
   std::unordered_map<int64_t, int64_t> vector_id_to_idx_;
   Status status_;
 
-  std::atomic<int> sub_tasks_count_{0};
+  RpcWindow window_;
 };
 
 class VectorImportDeleteTask : public VectorTask {
@@ -71,7 +76,7 @@ class VectorImportDeleteTask : public VectorTask {
   std::set<int64_t> next_vector_ids_;
   Status status_;
 
-  std::atomic<int> sub_tasks_count_{0};
+  RpcWindow window_;
 };
 
 }  // namespace sdk
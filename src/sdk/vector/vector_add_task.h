@@ -21,8 +21,10 @@
 
 #include "sdk/client_stub.h"
 #include "sdk/rpc/index_service_rpc.h"
+#include "sdk/rpc/rpc_batch.h"
 #include "sdk/rpc/store_rpc_controller.h"
 #include "sdk/vector/vector_index.h"
+#include "sdk/vector/vector_rows.h"
 #include "sdk/vector/vector_task.h"
 
 namespace dingodb {
@@ -33,6 +35,9 @@ class VectorAddTask : public VectorTask {
   VectorAddTask(const ClientStub& stub, int64_t index_id, std::vector<VectorWithId>& vectors)
       : VectorTask(stub), index_id_(index_id), vectors_(vectors) {}
 
+  VectorAddTask(const ClientStub& stub, int64_t index_id, VectorBatch& batch)
+      : VectorTask(stub), index_id_(index_id), vectors_(batch) {}
+
   ~VectorAddTask() override = default;
 
   Status TEST_Init() { return Init(); }
@@ -46,7 +51,7 @@ class VectorAddTask : public VectorTask {
   void VectorAddRpcCallback(const Status& status, VectorAddRpc* rpc);
 
   const int64_t index_id_;
-  std::vector<VectorWithId>& vectors_;
+  VectorRows vectors_;
 
   std::shared_ptr<VectorIndex> vector_index_;
 
@@ -57,7 +62,7 @@ class VectorAddTask : public VectorTask {
   std::unordered_map<int64_t, int64_t> vector_id_to_idx_;
   Status status_;
 
-  std::atomic<int> sub_tasks_count_{0};
+  RpcWindow window_;
 };
 
 }  // namespace sdk
@@ -56,21 +56,23 @@ void VectorBatchQueryTask::DoAsync() {
 
   auto meta_cache = stub.GetMetaCache();
 
-  for (const auto& id : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(vector_helper::VectorIdToRangeKey(*vector_index_, id), tmp);
-    if (!s.ok()) {
+  // sorted ids are routed by the id intervals of the index, meta cache is only asked for uncached ranges
+  std::vector<int64_t> ids(next_batch.begin(), next_batch.end());
+
+  std::vector<std::shared_ptr<Region>> regions;
+  Status s = vector_index_->GetIdRegionMap().Route(*meta_cache, ids, regions);
+
+  for (size_t i = 0; i < ids.size(); i++) {
+    int64_t id = ids[i];
+    const auto& region = regions[i];
+    if (region == nullptr) {
       // TODO: continue
       DoAsyncDone(s);
       return;
-    };
-
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
     }
 
-    region_id_to_vector_ids[tmp->RegionId()].push_back(id);
+    region_id_to_region.try_emplace(region->RegionId(), region);
+    region_id_to_vector_ids[region->RegionId()].push_back(id);
   }
 
   controllers_.clear();
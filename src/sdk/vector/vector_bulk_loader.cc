@@ -0,0 +1,587 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/vector/vector_bulk_loader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/auto_increment_manager.h"
+#include "sdk/client_stub.h"
+#include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/index_service_rpc.h"
+#include "sdk/rpc/store_rpc_controller.h"
+#include "sdk/vector/vector_index.h"
+#include "sdk/vector/vector_rows.h"
+#include "sdk/vector/vector_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+int64_t BulkLoadWatermark::AddChunk(int64_t count) {
+  CHECK_GT(count, 0);
+  end_offset_ += count;
+  chunks_.push_back({end_offset_, count});
+  return first_chunk_id_ + static_cast<int64_t>(chunks_.size()) - 1;
+}
+
+void BulkLoadWatermark::Ack(int64_t chunk_id, int64_t count) {
+  CHECK_GE(chunk_id, first_chunk_id_);
+  CHECK_LT(chunk_id - first_chunk_id_, static_cast<int64_t>(chunks_.size()));
+  auto& chunk = chunks_[chunk_id - first_chunk_id_];
+  CHECK_GE(chunk.pending, count);
+  chunk.pending -= count;
+
+  while (!chunks_.empty() && chunks_.front().pending == 0) {
+    watermark_ = chunks_.front().end_offset;
+    chunks_.pop_front();
+    first_chunk_id_++;
+  }
+}
+
+Status ReadBulkLoadCheckpoint(const std::string& path, int64_t index_id, int64_t& out_offset) {
+  std::ifstream in(path);
+  if (!in.is_open()) {
+    return Status::NotFound("checkpoint not found, path: " + path);
+  }
+
+  int64_t file_index_id = 0;
+  int64_t offset = -1;
+  if (!(in >> file_index_id >> offset) || offset < 0) {
+    return Status::Corruption("invalid checkpoint, path: " + path);
+  }
+
+  if (file_index_id != index_id) {
+    return Status::InvalidArgument(
+        fmt::format("checkpoint belongs to index: {}, not index: {}, path: {}", file_index_id, index_id, path));
+  }
+
+  out_offset = offset;
+  return Status::OK();
+}
+
+Status WriteBulkLoadCheckpoint(const std::string& path, int64_t index_id, int64_t offset) {
+  std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream out(tmp_path, std::ios::trunc);
+    if (!out.is_open()) {
+      return Status::IOError("open checkpoint fail, path: " + tmp_path);
+    }
+
+    out << index_id << " " << offset << "\n";
+    out.flush();
+    if (!out.good()) {
+      return Status::IOError("write checkpoint fail, path: " + tmp_path);
+    }
+  }
+
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    return Status::IOError("rename checkpoint fail, path: " + path);
+  }
+
+  return Status::OK();
+}
+
+VectorBulkLoader::Data::Data(const ClientStub& stub, int64_t index_id, const BulkLoadOption& option)
+    : stub_(stub),
+      index_id_(index_id),
+      option_(option),
+      start_time_(std::chrono::steady_clock::now()),
+      last_checkpoint_time_(start_time_),
+      last_progress_time_(start_time_) {}
+
+VectorBulkLoader::Data::~Data() {
+  std::vector<Batch*> dropped;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    closing_ = true;
+    cv_.wait(lk, [this] { return in_flight_ == 0; });
+
+    for (auto& [store, queue] : stores_) {
+      dropped.insert(dropped.end(), queue.waiting.begin(), queue.waiting.end());
+      queue.waiting.clear();
+    }
+    dropped.insert(dropped.end(), retry_batches_.begin(), retry_batches_.end());
+    retry_batches_.clear();
+  }
+
+  if (!dropped.empty() || !building_.empty()) {
+    DINGO_LOG(WARNING) << "bulk loader of index: " << index_id_ << " destroyed without flush, drop "
+                       << dropped.size() + building_.size() << " batches";
+  }
+
+  for (Batch* batch : dropped) {
+    delete batch;
+  }
+}
+
+Status VectorBulkLoader::Data::Init() {
+  if (option_.batch_size <= 0 || option_.max_in_flight_per_store <= 0 || option_.max_pending_rpcs <= 0) {
+    return Status::InvalidArgument("batch_size, max_in_flight_per_store and max_pending_rpcs must be positive");
+  }
+
+  std::shared_ptr<VectorIndex> tmp;
+  DINGO_RETURN_NOT_OK(stub_.GetVectorIndexCache()->GetVectorIndexById(index_id_, tmp));
+  DCHECK_NOTNULL(tmp);
+  vector_index_ = std::move(tmp);
+
+  // ids fetched from the auto increment service before a crash are not persisted, a resumed load would give the
+  // replayed vectors new ids and the skipped ones would keep ids nobody knows
+  if (vector_index_->HasAutoIncrement() && !option_.checkpoint_path.empty()) {
+    return Status::InvalidArgument("checkpoint_path is not supported by auto increment index");
+  }
+
+  if (vector_index_->HasAutoIncrement()) {
+    incrementer_ = stub_.GetAutoIncrementerManager()->GetOrCreateVectorIndexIncrementer(vector_index_);
+  }
+
+  if (!option_.checkpoint_path.empty()) {
+    Status s = ReadBulkLoadCheckpoint(option_.checkpoint_path, index_id_, resume_offset_);
+    if (s.IsNotFound()) {
+      resume_offset_ = 0;
+    } else if (!s.ok()) {
+      return s;
+    } else {
+      DINGO_LOG(INFO) << "bulk load of index: " << index_id_ << " resume from offset: " << resume_offset_;
+    }
+  }
+
+  last_checkpoint_ = resume_offset_;
+  watermark_ = BulkLoadWatermark(resume_offset_);
+  progress_.checkpoint = resume_offset_;
+
+  return Status::OK();
+}
+
+Status VectorBulkLoader::Data::Add(VectorRows& rows) {
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    DINGO_RETURN_NOT_OK(status_);
+  }
+
+  if (rows.Empty()) {
+    return Status::OK();
+  }
+
+  DINGO_RETURN_NOT_OK(rows.Check());
+
+  // vectors added by previous load are skipped, the input offset keeps counting them
+  int64_t size = rows.Size();
+  int64_t skip = std::clamp(resume_offset_ - input_offset_, static_cast<int64_t>(0), size);
+  input_offset_ += size;
+
+  int64_t chunk_id = 0;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    progress_.submitted_count += size;
+    progress_.skipped_count += skip;
+    if (skip < size) {
+      chunk_id = watermark_.AddChunk(size - skip);
+    }
+  }
+
+  if (skip == size) {
+    return Status::OK();
+  }
+
+  Status s = AssignIds(rows, skip);
+  if (s.ok()) {
+    ids_.clear();
+    for (int64_t i = skip; i < size; i++) {
+      ids_.push_back(rows.GetId(i));
+    }
+    s = vector_index_->GetIdRegionMap().Route(*stub_.GetMetaCache(), ids_, regions_);
+  }
+
+  if (!s.ok()) {
+    // part of the input is not routed, the watermark can not move forward any more
+    std::unique_lock<std::mutex> lk(mutex_);
+    if (status_.ok()) {
+      status_ = s;
+    }
+    return s;
+  }
+
+  for (int64_t i = skip; i < size; i++) {
+    Route(rows, i, regions_[i - skip], chunk_id);
+  }
+
+  DINGO_RETURN_NOT_OK(WaitPending(option_.max_pending_rpcs));
+
+  return MaybeCheckpoint(false);
+}
+
+Status VectorBulkLoader::Data::Flush() {
+  SealAll();
+
+  Status s = WaitPending(1);
+  Status checkpoint = MaybeCheckpoint(true);
+
+  return s.ok() ? checkpoint : s;
+}
+
+void VectorBulkLoader::Data::GetProgress(BulkLoadProgress& progress) {
+  std::unique_lock<std::mutex> lk(mutex_);
+  progress = ProgressUnlocked();
+}
+
+Status VectorBulkLoader::Data::AssignIds(VectorRows& rows, int64_t begin) {
+  if (incrementer_ == nullptr) {
+    for (int64_t i = begin; i < rows.Size(); i++) {
+      if (rows.GetId(i) <= 0) {
+        return Status::InvalidArgument("vector id must be positive");
+      }
+    }
+    return Status::OK();
+  }
+
+  // fetch ids in large batch, so the meta server is not asked for every Add
+  int64_t count = rows.Size() - begin;
+  int64_t pool_size = id_pool_.size();
+  if (pool_size < count) {
+    std::vector<int64_t> ids;
+    int64_t fetch_count = std::max(count - pool_size, option_.id_prefetch_count);
+    ids.reserve(fetch_count);
+    DINGO_RETURN_NOT_OK(incrementer_->GetNextIds(ids, fetch_count));
+    CHECK_EQ(ids.size(), fetch_count);
+    id_pool_.insert(id_pool_.end(), ids.begin(), ids.end());
+  }
+
+  std::vector<int64_t> ids;
+  ids.reserve(rows.Size());
+  for (int64_t i = 0; i < begin; i++) {
+    ids.push_back(rows.GetId(i));
+  }
+  for (int64_t i = begin; i < rows.Size(); i++) {
+    ids.push_back(id_pool_.front());
+    id_pool_.pop_front();
+  }
+  rows.SetIds(ids);
+
+  return Status::OK();
+}
+
+void VectorBulkLoader::Data::Route(const VectorRows& rows, int64_t idx, const std::shared_ptr<Region>& region,
+                                   int64_t chunk_id) {
+  int64_t region_id = region->RegionId();
+  auto& batch = building_[region_id];
+  if (batch == nullptr) {
+    batch = NewBatch(region, 0);
+  }
+
+  auto* vector_pb = batch->rpc->MutableRequest()->add_vectors();
+  rows.FillVectorWithIdPB(vector_pb, idx);
+  batch->chunk_ids.push_back(chunk_id);
+  batch->bytes += vector_pb->ByteSizeLong();
+
+  if (IsFull(*batch)) {
+    Seal(std::move(batch));
+    building_.erase(region_id);
+  }
+}
+
+std::unique_ptr<VectorBulkLoader::Data::Batch> VectorBulkLoader::Data::NewBatch(std::shared_ptr<Region> region,
+                                                                                int retry) {
+  auto batch = std::make_unique<Batch>();
+  batch->rpc = std::make_unique<VectorAddRpc>();
+  FillRpcContext(*batch->rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
+  batch->rpc->MutableRequest()->set_is_update(false);
+
+  // rpc are limited by leader store, region without known leader is limited by itself
+  EndPoint leader;
+  if (region->GetLeader(leader).ok()) {
+    batch->store = leader.StringAddr();
+  } else {
+    batch->store = fmt::format("region-{}", region->RegionId());
+  }
+
+  batch->region = std::move(region);
+  batch->retry = retry;
+  return batch;
+}
+
+bool VectorBulkLoader::Data::IsFull(const Batch& batch) const {
+  return static_cast<int64_t>(batch.chunk_ids.size()) >= option_.batch_size ||
+         batch.bytes >= FLAGS_index_rpc_max_batch_bytes;
+}
+
+void VectorBulkLoader::Data::Seal(std::unique_ptr<Batch> batch) {
+  Batch* raw = batch.release();
+  bool send = false;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    pending_rpcs_++;
+    auto& store = stores_[raw->store];
+    if (store.in_flight < option_.max_in_flight_per_store) {
+      store.in_flight++;
+      in_flight_++;
+      send = true;
+    } else {
+      store.waiting.push_back(raw);
+    }
+  }
+
+  if (send) {
+    Send(raw);
+  }
+}
+
+void VectorBulkLoader::Data::SealAll() {
+  for (auto& [region_id, batch] : building_) {
+    Seal(std::move(batch));
+  }
+  building_.clear();
+}
+
+void VectorBulkLoader::Data::Send(Batch* batch) {
+  batch->controller = std::make_unique<StoreRpcController>(stub_, *batch->rpc, batch->region);
+  batch->controller->AsyncCall([this, batch](const Status& s) { OnBatchDone(batch, s); });
+}
+
+void VectorBulkLoader::Data::OnBatchDone(Batch* batch, const Status& status) {
+  int64_t count = batch->chunk_ids.size();
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << "rpc: " << batch->rpc->Method() << " send to region: " << batch->region->RegionId()
+                       << " fail, vector count: " << count << ", retry: " << batch->retry
+                       << ", status: " << status.ToString();
+  }
+
+  // results cached before may miss these vectors, a failed rpc may be applied too, same as writes of VectorClient
+  stub_.GetVectorSearchCache()->Invalidate(index_id_);
+
+  Batch* next = nullptr;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    auto& store = stores_[batch->store];
+    store.in_flight--;
+    if (!closing_ && !store.waiting.empty()) {
+      next = store.waiting.front();
+      store.waiting.pop_front();
+      store.in_flight++;
+      in_flight_++;
+    }
+
+    if (status.ok()) {
+      // ack consecutive vectors of the same chunk together
+      for (int64_t i = 0; i < count;) {
+        int64_t j = i + 1;
+        while (j < count && batch->chunk_ids[j] == batch->chunk_ids[i]) {
+          j++;
+        }
+        watermark_.Ack(batch->chunk_ids[i], j - i);
+        i = j;
+      }
+
+      progress_.added_count += count;
+      progress_.bytes += batch->bytes;
+      progress_.rpc_count++;
+      pending_rpcs_--;
+      done_batches_.emplace_back(batch);
+    } else if (VectorTask::IsRetryError(status) && batch->retry < FLAGS_vector_op_max_retry) {
+      batch->retry++;
+      progress_.retried_count += count;
+      retry_batches_.push_back(batch);
+    } else {
+      if (status_.ok()) {
+        status_ = status;
+      }
+      pending_rpcs_--;
+      done_batches_.emplace_back(batch);
+    }
+
+    cv_.notify_all();
+  }
+
+  if (next != nullptr) {
+    Send(next);
+  }
+
+  MaybeReportProgress();
+
+  {
+    // last access of this, destructor waits for it
+    std::unique_lock<std::mutex> lk(mutex_);
+    in_flight_--;
+    cv_.notify_all();
+  }
+}
+
+Status VectorBulkLoader::Data::ResendRetryBatches() {
+  std::vector<Batch*> batches;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    batches.swap(retry_batches_);
+  }
+
+  if (batches.empty()) {
+    return Status::OK();
+  }
+
+  int retry = 0;
+  for (const auto* batch : batches) {
+    retry = std::max(retry, batch->retry);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(retry * FLAGS_vector_op_delay_ms));
+
+  // the meta cache is refreshed by the failed rpc, lookup again and resend to the new regions
+  Status s;
+  std::unordered_map<int64_t, std::unique_ptr<Batch>> rerouted;
+  for (Batch* raw : batches) {
+    std::unique_ptr<Batch> batch(raw);
+    {
+      std::unique_lock<std::mutex> lk(mutex_);
+      pending_rpcs_--;
+    }
+
+    auto* vectors = batch->rpc->MutableRequest()->mutable_vectors();
+    for (int i = 0; s.ok() && i < vectors->size(); i++) {
+      auto* vector_pb = vectors->Mutable(i);
+      std::shared_ptr<Region> region;
+      s = vector_index_->GetIdRegionMap().Route(*stub_.GetMetaCache(), vector_pb->id(), region);
+      if (!s.ok()) {
+        break;
+      }
+
+      int64_t region_id = region->RegionId();
+      auto& to = rerouted[region_id];
+      if (to == nullptr) {
+        to = NewBatch(std::move(region), batch->retry);
+      }
+      to->retry = std::max(to->retry, batch->retry);
+      to->bytes += vector_pb->ByteSizeLong();
+      to->rpc->MutableRequest()->add_vectors()->Swap(vector_pb);
+      to->chunk_ids.push_back(batch->chunk_ids[i]);
+
+      if (IsFull(*to)) {
+        Seal(std::move(to));
+        rerouted.erase(region_id);
+      }
+    }
+  }
+
+  if (!s.ok()) {
+    DINGO_LOG(WARNING) << "re-route bulk load vectors fail, status: " << s.ToString();
+    std::unique_lock<std::mutex> lk(mutex_);
+    if (status_.ok()) {
+      status_ = s;
+    }
+    return s;
+  }
+
+  for (auto& [region_id, batch] : rerouted) {
+    Seal(std::move(batch));
+  }
+
+  return Status::OK();
+}
+
+Status VectorBulkLoader::Data::WaitPending(int64_t limit) {
+  while (true) {
+    std::vector<std::unique_ptr<Batch>> done;
+    {
+      std::unique_lock<std::mutex> lk(mutex_);
+      cv_.wait(lk, [this, limit] { return pending_rpcs_ < limit || !retry_batches_.empty(); });
+      done.swap(done_batches_);
+      if (retry_batches_.empty()) {
+        return status_;
+      }
+    }
+
+    DINGO_RETURN_NOT_OK(ResendRetryBatches());
+  }
+}
+
+BulkLoadProgress VectorBulkLoader::Data::ProgressUnlocked() const {
+  BulkLoadProgress progress = progress_;
+  progress.checkpoint = watermark_.Watermark();
+  progress.elapsed_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time_).count();
+  return progress;
+}
+
+void VectorBulkLoader::Data::MaybeReportProgress() {
+  if (!option_.progress_callback) {
+    return;
+  }
+
+  BulkLoadProgress progress;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_progress_time_ < std::chrono::milliseconds(option_.progress_interval_ms)) {
+      return;
+    }
+    last_progress_time_ = now;
+    progress = ProgressUnlocked();
+  }
+
+  option_.progress_callback(progress);
+}
+
+Status VectorBulkLoader::Data::MaybeCheckpoint(bool force) {
+  if (option_.checkpoint_path.empty()) {
+    return Status::OK();
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  if (!force && now - last_checkpoint_time_ < std::chrono::milliseconds(option_.checkpoint_interval_ms)) {
+    return Status::OK();
+  }
+  last_checkpoint_time_ = now;
+
+  int64_t offset = 0;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    offset = watermark_.Watermark();
+  }
+
+  if (offset == last_checkpoint_) {
+    return Status::OK();
+  }
+
+  DINGO_RETURN_NOT_OK(WriteBulkLoadCheckpoint(option_.checkpoint_path, index_id_, offset));
+  last_checkpoint_ = offset;
+
+  return Status::OK();
+}
+
+VectorBulkLoader::VectorBulkLoader(Data* data) : data_(data) {}
+
+VectorBulkLoader::~VectorBulkLoader() { delete data_; }
+
+Status VectorBulkLoader::Add(std::vector<VectorWithId>& vectors) {
+  VectorRows rows(vectors);
+  return data_->Add(rows);
+}
+
+Status VectorBulkLoader::Add(VectorBatch& batch) {
+  VectorRows rows(batch);
+  return data_->Add(rows);
+}
+
+Status VectorBulkLoader::Flush() { return data_->Flush(); }
+
+int64_t VectorBulkLoader::ResumeOffset() const { return data_->ResumeOffset(); }
+
+void VectorBulkLoader::GetProgress(BulkLoadProgress& progress) { data_->GetProgress(progress); }
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,177 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_BULK_LOADER_H_
+#define DINGODB_SDK_VECTOR_BULK_LOADER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dingosdk/status.h"
+#include "dingosdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+
+class AutoIncrementer;
+class Region;
+class VectorIndex;
+class VectorRows;
+
+// Track which input vectors are added when rpc complete out of order.
+// Every Add call is one chunk of consecutive input offsets, the watermark is the end offset of the leading chunks
+// whose vectors are all acknowledged, so all input before it is durable.
+class BulkLoadWatermark {
+ public:
+  explicit BulkLoadWatermark(int64_t start_offset = 0) : watermark_(start_offset), end_offset_(start_offset) {}
+
+  ~BulkLoadWatermark() = default;
+
+  // return the chunk id of the next count input vectors
+  int64_t AddChunk(int64_t count);
+
+  // count vectors of the chunk are acknowledged
+  void Ack(int64_t chunk_id, int64_t count);
+
+  int64_t Watermark() const { return watermark_; }
+
+  int64_t EndOffset() const { return end_offset_; }
+
+ private:
+  struct Chunk {
+    int64_t end_offset;
+    int64_t pending;
+  };
+
+  int64_t watermark_;
+  int64_t end_offset_;
+  // chunk id of chunks_.front()
+  int64_t first_chunk_id_{0};
+  std::deque<Chunk> chunks_;
+};
+
+// checkpoint file is one line of "<index_id> <watermark>", saved by write a temp file and rename it
+Status ReadBulkLoadCheckpoint(const std::string& path, int64_t index_id, int64_t& out_offset);
+Status WriteBulkLoadCheckpoint(const std::string& path, int64_t index_id, int64_t offset);
+
+class ClientStub;
+class StoreRpcController;
+class VectorAddRpc;
+
+class VectorBulkLoader::Data {
+ public:
+  Data(const Data&) = delete;
+  const Data& operator=(const Data&) = delete;
+
+  Data(const ClientStub& stub, int64_t index_id, const BulkLoadOption& option);
+
+  ~Data();
+
+  Status Init();
+
+  Status Add(VectorRows& rows);
+
+  Status Flush();
+
+  int64_t ResumeOffset() const { return resume_offset_; }
+
+  void GetProgress(BulkLoadProgress& progress);
+
+ private:
+  // vectors of one rpc, chunk_ids[i] is the watermark chunk of the i-th vector in request
+  struct Batch {
+    std::shared_ptr<Region> region;
+    std::unique_ptr<VectorAddRpc> rpc;
+    std::unique_ptr<StoreRpcController> controller;
+    std::vector<int64_t> chunk_ids;
+    std::string store;
+    int64_t bytes{0};
+    int retry{0};
+  };
+
+  struct StoreQueue {
+    int64_t in_flight{0};
+    std::deque<Batch*> waiting;
+  };
+
+  Status AssignIds(VectorRows& rows, int64_t begin);
+
+  // append the vector to the building batch of its region, seal the batch when full
+  void Route(const VectorRows& rows, int64_t idx, const std::shared_ptr<Region>& region, int64_t chunk_id);
+
+  std::unique_ptr<Batch> NewBatch(std::shared_ptr<Region> region, int retry);
+  bool IsFull(const Batch& batch) const;
+  void Seal(std::unique_ptr<Batch> batch);
+  void SealAll();
+
+  void Send(Batch* batch);
+  void OnBatchDone(Batch* batch, const Status& status);
+
+  // re-route vectors of the batches failed by region split or leader change, run on caller thread
+  Status ResendRetryBatches();
+
+  // wait until pending rpc is less than limit, resend retry batches meanwhile
+  Status WaitPending(int64_t limit);
+
+  BulkLoadProgress ProgressUnlocked() const;
+  void MaybeReportProgress();
+  Status MaybeCheckpoint(bool force);
+
+  const ClientStub& stub_;
+  const int64_t index_id_;
+  const BulkLoadOption option_;
+
+  std::shared_ptr<VectorIndex> vector_index_;
+  std::shared_ptr<AutoIncrementer> incrementer_;
+  std::deque<int64_t> id_pool_;
+  // ids and regions of the rows being routed, reused across Add calls
+  std::vector<int64_t> ids_;
+  std::vector<std::shared_ptr<Region>> regions_;
+
+  int64_t resume_offset_{0};
+  int64_t input_offset_{0};
+  const std::chrono::steady_clock::time_point start_time_;
+  std::chrono::steady_clock::time_point last_checkpoint_time_;
+  int64_t last_checkpoint_{-1};
+  std::chrono::steady_clock::time_point last_progress_time_;
+
+  // building batch of each region, only touched by caller thread
+  std::unordered_map<int64_t, std::unique_ptr<Batch>> building_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool closing_{false};
+  Status status_;
+  // waiting, in flight and to retry
+  int64_t pending_rpcs_{0};
+  int64_t in_flight_{0};
+  std::unordered_map<std::string, StoreQueue> stores_;
+  std::vector<Batch*> retry_batches_;
+  // freed on caller thread, not in the rpc callback of its own controller
+  std::vector<std::unique_ptr<Batch>> done_batches_;
+  BulkLoadWatermark watermark_;
+  BulkLoadProgress progress_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_VECTOR_BULK_LOADER_H_
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <cstdint>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -32,14 +34,18 @@
 #include "sdk/vector/diskann/vector_diskann_status_by_region_task.h"
 #include "sdk/vector/vector_add_task.h"
 #include "sdk/vector/vector_batch_query_task.h"
+#include "sdk/vector/vector_bulk_loader.h"
 #include "sdk/vector/vector_count_task.h"
 #include "sdk/vector/vector_delete_task.h"
 #include "sdk/vector/vector_get_auto_increment_id_task.h"
 #include "sdk/vector/vector_get_border_task.h"
 #include "sdk/vector/vector_get_index_metrics_task.h"
 #include "sdk/vector/vector_index_cache.h"
+#include "sdk/vector/vector_rows.h"
+#include "sdk/vector/vector_search_cache.h"
 #include "sdk/vector/vector_scan_query_task.h"
 #include "sdk/vector/vector_search_task.h"
+#include "sdk/vector/vector_stream_search_task.h"
 #include "sdk/vector/vector_update_auto_increment_task.h"
 #include "sdk/vector/vector_upsert_task.h"
 
@@ -48,9 +54,76 @@ namespace sdk {
 
 VectorClient::VectorClient(const ClientStub& stub) : stub_(stub) {}
 
+// writes through this client make the cached search results of the index stale
+static Status InvalidateSearchCache(const ClientStub& stub, int64_t index_id, const Status& status) {
+  stub.GetVectorSearchCache()->Invalidate(index_id);
+  return status;
+}
+
+// concurrent searches of the same index and search param are merged into one task when coalescing is enabled
+static Status RunSearch(const ClientStub& stub, int64_t index_id, const SearchParam& search_param,
+                        const VectorRows& target_vectors, std::vector<SearchResult>& out_result) {
+  auto coalescer = stub.GetVectorSearchCoalescer();
+  if (coalescer->Enabled()) {
+    return coalescer->Search(stub, index_id, search_param, target_vectors, out_result);
+  }
+
+  VectorSearchTask task(stub, index_id, search_param, target_vectors, out_result);
+  return task.Run();
+}
+
+// serve queries from search cache, only the missed queries are searched and then put to cache
+static Status SearchWithCache(const ClientStub& stub, int64_t index_id, const SearchParam& search_param,
+                              const VectorRows& target_vectors, std::vector<SearchResult>& out_result) {
+  auto cache = stub.GetVectorSearchCache();
+
+  std::vector<std::string> keys;
+  std::vector<SearchResult> results;
+  std::vector<int64_t> missed_idxes;
+  std::vector<VectorWithId> missed_vectors;
+  keys.reserve(target_vectors.Size());
+  results.reserve(target_vectors.Size());
+  for (int64_t i = 0; i < target_vectors.Size(); i++) {
+    VectorWithId query(target_vectors.GetVector(i));
+    keys.push_back(cache->EncodeKey(index_id, search_param, query.vector));
+
+    SearchResult result(query);
+    if (!cache->Get(keys.back(), result.vector_datas)) {
+      missed_idxes.push_back(i);
+      missed_vectors.push_back(std::move(query));
+    }
+    results.push_back(std::move(result));
+  }
+
+  if (!missed_vectors.empty()) {
+    std::vector<SearchResult> missed_results;
+    DINGO_RETURN_NOT_OK(RunSearch(stub, index_id, search_param, VectorRows(missed_vectors), missed_results));
+    CHECK_EQ(missed_results.size(), missed_idxes.size());
+
+    for (int64_t i = 0; i < missed_idxes.size(); i++) {
+      int64_t idx = missed_idxes[i];
+      cache->Put(keys[idx], missed_results[i].vector_datas);
+      results[idx].vector_datas = std::move(missed_results[i].vector_datas);
+    }
+  }
+
+  out_result.reserve(out_result.size() + results.size());
+  std::move(results.begin(), results.end(), std::back_inserter(out_result));
+  return Status::OK();
+}
+
+static Status SearchVectors(const ClientStub& stub, int64_t index_id, const SearchParam& search_param,
+                            const VectorRows& target_vectors, std::vector<SearchResult>& out_result) {
+  if (stub.GetVectorSearchCache()->Enabled()) {
+    return SearchWithCache(stub, index_id, search_param, target_vectors, out_result);
+  }
+
+  return RunSearch(stub, index_id, search_param, target_vectors, out_result);
+}
+
 Status VectorClient::AddByIndexId(int64_t index_id, std::vector<VectorWithId>& vectors) {
   VectorAddTask task(stub_, index_id, vectors);
-  return task.Run();
+  return InvalidateSearchCache(stub_, index_id, task.Run());
 }
 
 Status VectorClient::AddByIndexName(int64_t schema_id, const std::string& index_name,
@@ -60,12 +133,12 @@ Status VectorClient::AddByIndexName(int64_t schema_id, const std::string& index_
       stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
   CHECK_GT(index_id, 0);
   VectorAddTask task(stub_, index_id, vectors);
-  return task.Run();
+  return InvalidateSearchCache(stub_, index_id, task.Run());
 }
 
 Status VectorClient::UpsertByIndexId(int64_t index_id, std::vector<VectorWithId>& vectors) {
   VectorUpsertTask task(stub_, index_id, vectors);
-  return task.Run();
+  return InvalidateSearchCache(stub_, index_id, task.Run());
 }
 
 Status VectorClient::UpsertByIndexName(int64_t schema_id, const std::string& index_name,
@@ -75,14 +148,41 @@ Status VectorClient::UpsertByIndexName(int64_t schema_id, const std::string& ind
       stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
   CHECK_GT(index_id, 0);
   VectorUpsertTask task(stub_, index_id, vectors);
-  return task.Run();
+  return InvalidateSearchCache(stub_, index_id, task.Run());
+}
+
+Status VectorClient::AddByIndexId(int64_t index_id, VectorBatch& batch) {
+  VectorAddTask task(stub_, index_id, batch);
+  return InvalidateSearchCache(stub_, index_id, task.Run());
+}
+
+Status VectorClient::AddByIndexName(int64_t schema_id, const std::string& index_name, VectorBatch& batch) {
+  int64_t index_id{0};
+  DINGO_RETURN_NOT_OK(
+      stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
+  CHECK_GT(index_id, 0);
+  VectorAddTask task(stub_, index_id, batch);
+  return InvalidateSearchCache(stub_, index_id, task.Run());
+}
+
+Status VectorClient::UpsertByIndexId(int64_t index_id, VectorBatch& batch) {
+  VectorUpsertTask task(stub_, index_id, batch);
+  return InvalidateSearchCache(stub_, index_id, task.Run());
+}
+
+Status VectorClient::UpsertByIndexName(int64_t schema_id, const std::string& index_name, VectorBatch& batch) {
+  int64_t index_id{0};
+  DINGO_RETURN_NOT_OK(
+      stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
+  CHECK_GT(index_id, 0);
+  VectorUpsertTask task(stub_, index_id, batch);
+  return InvalidateSearchCache(stub_, index_id, task.Run());
 }
 
 Status VectorClient::SearchByIndexId(int64_t index_id, const SearchParam& search_param,
                                      const std::vector<VectorWithId>& target_vectors,
                                      std::vector<SearchResult>& out_result) {
-  VectorSearchTask task(stub_, index_id, search_param, target_vectors, out_result);
-  return task.Run();
+  return SearchVectors(stub_, index_id, search_param, VectorRows(target_vectors), out_result);
 }
 
 Status VectorClient::SearchByIndexName(int64_t schema_id, const std::string& index_name,
@@ -92,14 +192,49 @@ Status VectorClient::SearchByIndexName(int64_t schema_id, const std::string& ind
   DINGO_RETURN_NOT_OK(
       stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
   CHECK_GT(index_id, 0);
-  VectorSearchTask task(stub_, index_id, search_param, target_vectors, out_result);
+  return SearchVectors(stub_, index_id, search_param, VectorRows(target_vectors), out_result);
+}
+
+Status VectorClient::SearchByIndexId(int64_t index_id, const SearchParam& search_param,
+                                     const VectorBatch& target_batch, std::vector<SearchResult>& out_result) {
+  return SearchVectors(stub_, index_id, search_param, VectorRows(target_batch), out_result);
+}
+
+Status VectorClient::SearchByIndexName(int64_t schema_id, const std::string& index_name,
+                                       const SearchParam& search_param, const VectorBatch& target_batch,
+                                       std::vector<SearchResult>& out_result) {
+  int64_t index_id{0};
+  DINGO_RETURN_NOT_OK(
+      stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
+  CHECK_GT(index_id, 0);
+  return SearchVectors(stub_, index_id, search_param, VectorRows(target_batch), out_result);
+}
+
+Status VectorClient::StreamSearchByIndexId(int64_t index_id, const SearchParam& search_param,
+                                           const std::vector<VectorWithId>& target_vectors,
+                                           const StreamSearchOption& option, StreamSearchResult& out_result) {
+  VectorStreamSearchTask task(stub_, index_id, search_param, target_vectors, option, out_result);
+  return task.Run();
+}
+
+Status VectorClient::StreamSearchByIndexName(int64_t schema_id, const std::string& index_name,
+                                             const SearchParam& search_param,
+                                             const std::vector<VectorWithId>& target_vectors,
+                                             const StreamSearchOption& option, StreamSearchResult& out_result) {
+  int64_t index_id{0};
+  DINGO_RETURN_NOT_OK(
+      stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
+  CHECK_GT(index_id, 0);
+  VectorStreamSearchTask task(stub_, index_id, search_param, target_vectors, option, out_result);
   return task.Run();
 }
 
+void VectorClient::GetSearchCacheStats(SearchCacheStats& stats) { stub_.GetVectorSearchCache()->GetStats(stats); }
+
 Status VectorClient::DeleteByIndexId(int64_t index_id, const std::vector<int64_t>& vector_ids,
                                      std::vector<DeleteResult>& out_result) {
   VectorDeleteTask task(stub_, index_id, vector_ids, out_result);
-  return task.Run();
+  return InvalidateSearchCache(stub_, index_id, task.Run());
 }
 
 Status VectorClient::DeleteByIndexName(int64_t schema_id, const std::string& index_name,
@@ -109,7 +244,7 @@ Status VectorClient::DeleteByIndexName(int64_t schema_id, const std::string& ind
       stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
   CHECK_GT(index_id, 0);
   VectorDeleteTask task(stub_, index_id, vector_ids, out_result);
-  return task.Run();
+  return InvalidateSearchCache(stub_, index_id, task.Run());
 }
 
 Status VectorClient::BatchQueryByIndexId(int64_t index_id, const QueryParam& query_param, QueryResult& out_result) {
@@ -158,6 +293,41 @@ Status VectorClient::ScanQueryByIndexName(int64_t schema_id, const std::string&
   return task.Run();
 }
 
+Status VectorClient::ScanQueryPageByIndexId(int64_t index_id, const ScanQueryParam& query_param,
+                                            const std::string& page_token, ScanQueryResult& out_result,
+                                            std::string& next_page_token) {
+  VectorScanQueryPageTask task(stub_, index_id, query_param, page_token, out_result, next_page_token);
+  return task.Run();
+}
+
+Status VectorClient::ScanQueryPageByIndexName(int64_t schema_id, const std::string& index_name,
+                                              const ScanQueryParam& query_param, const std::string& page_token,
+                                              ScanQueryResult& out_result, std::string& next_page_token) {
+  int64_t index_id{0};
+  DINGO_RETURN_NOT_OK(
+      stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
+  CHECK_GT(index_id, 0);
+  VectorScanQueryPageTask task(stub_, index_id, query_param, page_token, out_result, next_page_token);
+  return task.Run();
+}
+
+Status VectorClient::NewBulkLoaderByIndexId(int64_t index_id, const BulkLoadOption& option,
+                                            VectorBulkLoader** out_loader) {
+  auto data = std::make_unique<VectorBulkLoader::Data>(stub_, index_id, option);
+  DINGO_RETURN_NOT_OK(data->Init());
+  *out_loader = new VectorBulkLoader(data.release());
+  return Status::OK();
+}
+
+Status VectorClient::NewBulkLoaderByIndexName(int64_t schema_id, const std::string& index_name,
+                                              const BulkLoadOption& option, VectorBulkLoader** out_loader) {
+  int64_t index_id{0};
+  DINGO_RETURN_NOT_OK(
+      stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
+  CHECK_GT(index_id, 0);
+  return NewBulkLoaderByIndexId(index_id, option, out_loader);
+}
+
 Status VectorClient::GetIndexMetricsByIndexId(int64_t index_id, IndexMetricsResult& out_result) {
   VectorGetIndexMetricsTask task(stub_, index_id, out_result);
   return task.Run();
@@ -337,7 +507,7 @@ Status VectorClient::CountMemoryByIndexName(int64_t schema_id, const std::string
 
 Status VectorClient::ImportAddByIndexId(int64_t index_id, std::vector<VectorWithId>& vectors) {
   VectorImportAddTask task(stub_, index_id, vectors);
-  return task.Run();
+  return InvalidateSearchCache(stub_, index_id, task.Run());
 }
 
 Status VectorClient::ImportAddByIndexName(int64_t schema_id, const std::string& index_name,
@@ -347,12 +517,26 @@ Status VectorClient::ImportAddByIndexName(int64_t schema_id, const std::string&
       stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
   CHECK_GT(index_id, 0);
   VectorImportAddTask task(stub_, index_id, vectors);
-  return task.Run();
+  return InvalidateSearchCache(stub_, index_id, task.Run());
+}
+
+Status VectorClient::ImportAddByIndexId(int64_t index_id, VectorBatch& batch) {
+  VectorImportAddTask task(stub_, index_id, batch);
+  return InvalidateSearchCache(stub_, index_id, task.Run());
+}
+
+Status VectorClient::ImportAddByIndexName(int64_t schema_id, const std::string& index_name, VectorBatch& batch) {
+  int64_t index_id{0};
+  DINGO_RETURN_NOT_OK(
+      stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
+  CHECK_GT(index_id, 0);
+  VectorImportAddTask task(stub_, index_id, batch);
+  return InvalidateSearchCache(stub_, index_id, task.Run());
 }
 
 Status VectorClient::ImportDeleteByIndexId(int64_t index_id, const std::vector<int64_t>& vector_ids) {
   VectorImportDeleteTask task(stub_, index_id, vector_ids);
-  return task.Run();
+  return InvalidateSearchCache(stub_, index_id, task.Run());
 }
 
 Status VectorClient::ImportDeleteByIndexName(int64_t schema_id, const std::string& index_name,
@@ -362,7 +546,7 @@ Status VectorClient::ImportDeleteByIndexName(int64_t schema_id, const std::strin
       stub_.GetVectorIndexCache()->GetIndexIdByKey(EncodeVectorIndexCacheKey(schema_id, index_name), index_id));
   CHECK_GT(index_id, 0);
   VectorImportDeleteTask task(stub_, index_id, vector_ids);
-  return task.Run();
+  return InvalidateSearchCache(stub_, index_id, task.Run());
 }
 
 // dump
@@ -20,6 +20,7 @@
 #include "common/logging.h"
 #include "glog/logging.h"
 #include "sdk/utils/codec.h"
+#include "sdk/utils/key_codec.h"
 #include "serial/schema/long_schema.h"
 
 namespace dingodb {
@@ -45,18 +46,20 @@ static void EncodeVectorKey(char prefix, int64_t partition_id, int64_t vector_id
   CHECK(prefix != 0) << "Encode vector key failed, prefix is 0, partition_id:[" << partition_id << "], vector_id:["
                      << vector_id << "]";
 
-  // Buf buf(17);
-  Buf buf(kVectorKeyMaxLenWithPrefix);
-  buf.Write(prefix);
-  buf.WriteLong(partition_id);
-  DingoSchema<std::optional<int64_t>>::InternalEncodeKey(&buf, vector_id);
-  buf.GetBytes(result);
+  result.resize(kVectorKeyMaxLenWithPrefix);
+  key_codec::EncodeIdKey(prefix, partition_id, vector_id, result.data());
+}
+
+// encode keys of count ids in the partition back to back into keys, without allocation per key
+static void EncodeVectorKeys(char prefix, int64_t partition_id, const int64_t* ids, size_t count,
+                             key_codec::IdKeyBuffer& keys) {
+  CHECK(prefix != 0) << "Encode vector keys failed, prefix is 0, partition_id:[" << partition_id << "]";
+  keys.Append(prefix, partition_id, ids, count);
 }
 
 static int64_t DecodeVectorId(const std::string& value) {
-  Buf buf(value);
   if (value.size() >= kVectorKeyMaxLenWithPrefix) {
-    buf.Skip(9);
+    return key_codec::DecodeIdKey(value.data());
   } else if (value.size() == kVectorKeyMinLenWithPrefix) {
     return 0;
   } else {
@@ -64,8 +67,6 @@ static int64_t DecodeVectorId(const std::string& value) {
                      << codec::BytesToHexString(value) << "]";
     return 0;
   }
-
-  return DingoSchema<std::optional<int64_t>>::InternalDecodeKey(&buf);
 }
 
 static int64_t DecodePartitionId(const std::string& value) {
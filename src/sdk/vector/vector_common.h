@@ -501,6 +501,9 @@ static void FillInternalSearchParams(pb::common::VectorSearchParameter* internal
     case FilterType::kQueryPost:
       internal_parameter->set_vector_filter_type(pb::common::VectorFilterType::QUERY_POST);
       break;
+    case FilterType::kQueryAuto:
+      // resolved by vector search task
+      break;
     default:
       CHECK(false) << "not support filter type: " << static_cast<int>(parameter.filter_type);
       break;
@@ -17,6 +17,7 @@
 #include <cstdint>
 
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
 #include "sdk/vector/vector_helper.h"
 
 namespace dingodb {
@@ -58,21 +59,38 @@ void VectorDeleteTask::DoAsync() {
 
   auto meta_cache = stub.GetMetaCache();
 
-  for (const auto& id : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(vector_helper::VectorIdToRangeKey(*vector_index_, id), tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    };
-
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
+  // sorted ids are routed by the id intervals of the index, meta cache is only asked for uncached ranges
+  std::vector<int64_t> ids(next_batch.begin(), next_batch.end());
+
+  std::vector<std::shared_ptr<Region>> regions;
+  Status s = vector_index_->GetIdRegionMap().Route(*meta_cache, ids, regions);
+
+  for (size_t i = 0; i < ids.size(); i++) {
+    int64_t id = ids[i];
+    const auto& region = regions[i];
+    if (region == nullptr) {
+      // keep the id pending and route the others, it is resent in next round
+      DINGO_LOG(WARNING) << "lookup region fail, id: " << id << ", status: " << s.ToString();
+      Status lookup_status = RegionLookupStatus(s);
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      if (status_.ok() || (IsRetryError(status_) && !IsRetryError(lookup_status))) {
+        status_ = lookup_status;
+      }
+      continue;
     }
 
-    region_vectors_to_ids[tmp->RegionId()].push_back(id);
+    region_id_to_region.try_emplace(region->RegionId(), region);
+    region_vectors_to_ids[region->RegionId()].push_back(id);
+  }
+
+  if (region_vectors_to_ids.empty()) {
+    Status tmp;
+    {
+      std::shared_lock<std::shared_mutex> r(rw_lock_);
+      tmp = status_;
+    }
+    DoAsyncDone(tmp);
+    return;
   }
 
   controllers_.clear();
@@ -85,30 +103,34 @@ void VectorDeleteTask::DoAsync() {
     CHECK(iter != region_id_to_region.end());
     auto region = iter->second;
 
-    auto rpc = std::make_unique<VectorDeleteRpc>();
-    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
-
+    RpcChunker chunker(FLAGS_index_rpc_max_batch_count, FLAGS_index_rpc_max_batch_bytes);
+    std::unique_ptr<VectorDeleteRpc> rpc;
     for (const auto& id : entry.second) {
+      if (rpc == nullptr) {
+        rpc = std::make_unique<VectorDeleteRpc>();
+        FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
+      }
+
       rpc->MutableRequest()->add_ids(id);
-    }
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+      if (chunker.Add(sizeof(int64_t))) {
+        controllers_.emplace_back(stub, *rpc, region);
+        rpcs_.push_back(std::move(rpc));
+      }
+    }
 
-    rpcs_.push_back(std::move(rpc));
+    if (rpc != nullptr) {
+      controllers_.emplace_back(stub, *rpc, region);
+      rpcs_.push_back(std::move(rpc));
+    }
   }
 
-  DCHECK_EQ(rpcs_.size(), region_vectors_to_ids.size());
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_vectors_to_ids.size());
-
-  for (auto i = 0; i < region_vectors_to_ids.size(); i++) {
-    auto& controller = controllers_[i];
-
-    controller.AsyncCall(
+  window_.Start(rpcs_.size(), FLAGS_index_rpc_max_in_flight, [this](int64_t i) {
+    controllers_[i].AsyncCall(
         [this, rpc = rpcs_[i].get()](auto&& s) { VectorDeleteRpcCallback(std::forward<decltype(s)>(s), rpc); });
-  }
+  });
 }
 
 void VectorDeleteTask::VectorDeleteRpcCallback(const Status& status, VectorDeleteRpc* rpc) {
@@ -117,8 +139,8 @@ void VectorDeleteTask::VectorDeleteRpcCallback(const Status& status, VectorDelet
                        << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    if (status_.ok()) {
-      // only return first fail status
+    if (status_.ok() || (IsRetryError(status_) && !IsRetryError(status))) {
+      // return first fail status, a fatal one wins over errors which only need resend
       status_ = status;
     }
   } else {
@@ -127,10 +149,12 @@ void VectorDeleteTask::VectorDeleteRpcCallback(const Status& status, VectorDelet
     for (auto i = 0; i < rpc->Response()->key_states_size(); i++) {
       int64_t id = rpc->Request()->ids(i);
       out_result_.push_back({id, rpc->Response()->key_states(i)});
+      // acked ids are not resent when other chunks need retry
+      next_vector_ids_.erase(id);
     }
   }
 
-  if (sub_tasks_count_.fetch_sub(1) == 1) {
+  if (window_.Done()) {
     Status tmp;
     {
       std::shared_lock<std::shared_mutex> r(rw_lock_);
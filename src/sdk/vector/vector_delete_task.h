@@ -18,6 +18,7 @@
 #include <cstdint>
 
 #include "sdk/rpc/index_service_rpc.h"
+#include "sdk/rpc/rpc_batch.h"
 #include "sdk/rpc/store_rpc_controller.h"
 #include "sdk/vector/vector_task.h"
 
@@ -54,7 +55,7 @@ class VectorDeleteTask : public VectorTask {
   std::set<int64_t> next_vector_ids_;
   Status status_;
 
-  std::atomic<int> sub_tasks_count_{0};
+  RpcWindow window_;
 };
 
 }  // namespace sdk
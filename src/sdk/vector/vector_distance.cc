@@ -0,0 +1,308 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "sdk/vector/vector_distance.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__)
+#define DINGO_DISTANCE_X86
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define DINGO_DISTANCE_NEON
+#include <arm_neon.h>
+#endif
+
+#include "fmt/core.h"
+
+namespace dingodb {
+namespace sdk {
+namespace vector_distance {
+
+// store reports inner product and cosine as 1 - similarity, so every metric is smaller is better
+static float ToStoreDistance(float distance, MetricType metric_type) {
+  return (metric_type == MetricType::kInnerProduct || metric_type == MetricType::kCosine) ? 1 - distance : distance;
+}
+
+static float CosineFromProducts(float xy, float xx, float yy) {
+  if (xx <= 0 || yy <= 0) {
+    return 0;
+  }
+
+  return xy / (std::sqrt(xx) * std::sqrt(yy));
+}
+
+// inlined into the kernels built with popcnt, so the builtin becomes one instruction there
+__attribute__((always_inline)) static inline int64_t HammingWords(const uint8_t* x, const uint8_t* y,
+                                                                  int64_t bytes) {
+  int64_t count = 0;
+  int64_t i = 0;
+  for (; i + 8 <= bytes; i += 8) {
+    uint64_t a;
+    uint64_t b;
+    memcpy(&a, x + i, sizeof(a));
+    memcpy(&b, y + i, sizeof(b));
+    count += __builtin_popcountll(a ^ b);
+  }
+  for (; i < bytes; i++) {
+    count += __builtin_popcount(x[i] ^ y[i]);
+  }
+  return count;
+}
+
+namespace scalar {
+
+float L2Sqr(const float* x, const float* y, int64_t dim) {
+  float sum = 0;
+  for (int64_t i = 0; i < dim; i++) {
+    float d = x[i] - y[i];
+    sum += d * d;
+  }
+  return sum;
+}
+
+float InnerProduct(const float* x, const float* y, int64_t dim) {
+  float sum = 0;
+  for (int64_t i = 0; i < dim; i++) {
+    sum += x[i] * y[i];
+  }
+  return sum;
+}
+
+float Cosine(const float* x, const float* y, int64_t dim) {
+  return CosineFromProducts(InnerProduct(x, y, dim), InnerProduct(x, x, dim), InnerProduct(y, y, dim));
+}
+
+float Hamming(const uint8_t* x, const uint8_t* y, int64_t bytes) { return HammingWords(x, y, bytes); }
+
+}  // namespace scalar
+
+#if defined(DINGO_DISTANCE_X86)
+
+namespace avx512 {
+
+__attribute__((target("avx512f"))) static float L2Sqr(const float* x, const float* y, int64_t dim) {
+  __m512 sum = _mm512_setzero_ps();
+  int64_t i = 0;
+  for (; i + 16 <= dim; i += 16) {
+    __m512 d = _mm512_sub_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i));
+    sum = _mm512_fmadd_ps(d, d, sum);
+  }
+  return _mm512_reduce_add_ps(sum) + scalar::L2Sqr(x + i, y + i, dim - i);
+}
+
+__attribute__((target("avx512f"))) static float InnerProduct(const float* x, const float* y, int64_t dim) {
+  __m512 sum = _mm512_setzero_ps();
+  int64_t i = 0;
+  for (; i + 16 <= dim; i += 16) {
+    sum = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), sum);
+  }
+  return _mm512_reduce_add_ps(sum) + scalar::InnerProduct(x + i, y + i, dim - i);
+}
+
+}  // namespace avx512
+
+namespace avx2 {
+
+__attribute__((target("avx2"))) static inline float HorizontalSum(__m256 v) {
+  __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+  return _mm_cvtss_f32(sum);
+}
+
+__attribute__((target("avx2"))) static float L2Sqr(const float* x, const float* y, int64_t dim) {
+  __m256 sum = _mm256_setzero_ps();
+  int64_t i = 0;
+  for (; i + 8 <= dim; i += 8) {
+    __m256 d = _mm256_sub_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i));
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(d, d));
+  }
+  return HorizontalSum(sum) + scalar::L2Sqr(x + i, y + i, dim - i);
+}
+
+__attribute__((target("avx2"))) static float InnerProduct(const float* x, const float* y, int64_t dim) {
+  __m256 sum = _mm256_setzero_ps();
+  int64_t i = 0;
+  for (; i + 8 <= dim; i += 8) {
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+  }
+  return HorizontalSum(sum) + scalar::InnerProduct(x + i, y + i, dim - i);
+}
+
+}  // namespace avx2
+
+// every cpu with avx2 has popcnt
+__attribute__((target("popcnt"))) static float HammingPopcnt(const uint8_t* x, const uint8_t* y, int64_t bytes) {
+  return HammingWords(x, y, bytes);
+}
+
+static std::vector<Kernels> DetectKernels() {
+  std::vector<Kernels> kernels = {{"scalar", scalar::L2Sqr, scalar::InnerProduct, scalar::Hamming}};
+
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    kernels.push_back({"avx2", avx2::L2Sqr, avx2::InnerProduct, HammingPopcnt});
+  }
+  if (__builtin_cpu_supports("avx512f")) {
+    kernels.push_back({"avx512", avx512::L2Sqr, avx512::InnerProduct, HammingPopcnt});
+  }
+  return kernels;
+}
+
+#elif defined(DINGO_DISTANCE_NEON)
+
+// neon is part of the aarch64 baseline, no runtime check is needed
+namespace neon {
+
+static float L2Sqr(const float* x, const float* y, int64_t dim) {
+  float32x4_t sum = vdupq_n_f32(0);
+  int64_t i = 0;
+  for (; i + 4 <= dim; i += 4) {
+    float32x4_t d = vsubq_f32(vld1q_f32(x + i), vld1q_f32(y + i));
+    sum = vfmaq_f32(sum, d, d);
+  }
+  return vaddvq_f32(sum) + scalar::L2Sqr(x + i, y + i, dim - i);
+}
+
+static float InnerProduct(const float* x, const float* y, int64_t dim) {
+  float32x4_t sum = vdupq_n_f32(0);
+  int64_t i = 0;
+  for (; i + 4 <= dim; i += 4) {
+    sum = vfmaq_f32(sum, vld1q_f32(x + i), vld1q_f32(y + i));
+  }
+  return vaddvq_f32(sum) + scalar::InnerProduct(x + i, y + i, dim - i);
+}
+
+static float Hamming(const uint8_t* x, const uint8_t* y, int64_t bytes) {
+  int64_t count = 0;
+  int64_t i = 0;
+  for (; i + 16 <= bytes; i += 16) {
+    count += vaddlvq_u8(vcntq_u8(veorq_u8(vld1q_u8(x + i), vld1q_u8(y + i))));
+  }
+  return count + scalar::Hamming(x + i, y + i, bytes - i);
+}
+
+}  // namespace neon
+
+static std::vector<Kernels> DetectKernels() {
+  return {{"scalar", scalar::L2Sqr, scalar::InnerProduct, scalar::Hamming},
+          {"neon", neon::L2Sqr, neon::InnerProduct, neon::Hamming}};
+}
+
+#else
+
+static std::vector<Kernels> DetectKernels() {
+  return {{"scalar", scalar::L2Sqr, scalar::InnerProduct, scalar::Hamming}};
+}
+
+#endif
+
+const std::vector<Kernels>& SupportedKernels() {
+  static const std::vector<Kernels> kKernels = DetectKernels();
+  return kKernels;
+}
+
+static const Kernels& ActiveKernels() {
+  static const Kernels& kActive = SupportedKernels().back();
+  return kActive;
+}
+
+const char* SimdName() { return ActiveKernels().name; }
+
+float L2Sqr(const float* x, const float* y, int64_t dim) { return ActiveKernels().l2_sqr(x, y, dim); }
+
+float InnerProduct(const float* x, const float* y, int64_t dim) { return ActiveKernels().inner_product(x, y, dim); }
+
+float Cosine(const float* x, const float* y, int64_t dim) {
+  return CosineFromProducts(InnerProduct(x, y, dim), InnerProduct(x, x, dim), InnerProduct(y, y, dim));
+}
+
+float Hamming(const uint8_t* x, const uint8_t* y, int64_t bytes) { return ActiveKernels().hamming(x, y, bytes); }
+
+Status Distance(const Vector& x, const Vector& y, MetricType metric_type, float& distance) {
+  if (x.value_type != y.value_type) {
+    return Status::InvalidArgument(fmt::format("value type mismatch, {} vs {}", ValueTypeToString(x.value_type),
+                                               ValueTypeToString(y.value_type)));
+  }
+
+  if (x.value_type == ValueType::kFloat) {
+    if (x.float_values.empty() || x.float_values.size() != y.float_values.size()) {
+      return Status::InvalidArgument(
+          fmt::format("float vector size mismatch, {} vs {}", x.float_values.size(), y.float_values.size()));
+    }
+
+    const float* a = x.float_values.data();
+    const float* b = y.float_values.data();
+    int64_t dim = x.float_values.size();
+    switch (metric_type) {
+      case MetricType::kL2:
+        distance = L2Sqr(a, b, dim);
+        return Status::OK();
+      case MetricType::kInnerProduct:
+        distance = InnerProduct(a, b, dim);
+        return Status::OK();
+      case MetricType::kCosine:
+        distance = Cosine(a, b, dim);
+        return Status::OK();
+      default:
+        return Status::NotSupported(
+            fmt::format("metric type {} not support float vector", MetricTypeToString(metric_type)));
+    }
+  }
+
+  // binary vectors hold dimension bits packed into bytes, only the bit level hamming distance is defined
+  if (x.value_type == ValueType::kUint8 || x.value_type == ValueType::kInt8) {
+    if (metric_type != MetricType::kHamming) {
+      return Status::NotSupported(
+          fmt::format("metric type {} not support binary vector", MetricTypeToString(metric_type)));
+    }
+
+    if (x.binary_values.empty() || x.binary_values.size() != y.binary_values.size()) {
+      return Status::InvalidArgument(
+          fmt::format("binary vector size mismatch, {} vs {}", x.binary_values.size(), y.binary_values.size()));
+    }
+
+    distance = Hamming(x.binary_values.data(), y.binary_values.data(), x.binary_values.size());
+    return Status::OK();
+  }
+
+  return Status::NotSupported(fmt::format("value type {} not support", ValueTypeToString(x.value_type)));
+}
+
+Status Rerank(const Vector& query, std::vector<VectorWithDistance>& results) {
+  std::vector<float> distances(results.size());
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& result = results[i];
+    DINGO_RETURN_NOT_OK(Distance(query, result.vector_data.vector, result.metric_type, distances[i]));
+  }
+
+  for (size_t i = 0; i < results.size(); i++) {
+    results[i].distance = ToStoreDistance(distances[i], results[i].metric_type);
+  }
+
+  std::stable_sort(results.begin(), results.end(), [](const VectorWithDistance& a, const VectorWithDistance& b) {
+    return a.distance < b.distance;
+  });
+  return Status::OK();
+}
+
+}  // namespace vector_distance
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,78 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DINGODB_SDK_VECTOR_DISTANCE_H_
+#define DINGODB_SDK_VECTOR_DISTANCE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "dingosdk/status.h"
+#include "dingosdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+namespace vector_distance {
+
+// Distance kernels are built for every instruction set the compiler targets (avx512 and avx2 on x86-64 through
+// function target attributes, neon on aarch64) and picked once at runtime by what the cpu supports, falling back
+// to scalar code. L2 is squared euclidean distance, cosine is cosine similarity.
+
+// name of the instruction set the kernels use: avx512, avx2, neon or scalar
+const char* SimdName();
+
+float L2Sqr(const float* x, const float* y, int64_t dim);
+float InnerProduct(const float* x, const float* y, int64_t dim);
+float Cosine(const float* x, const float* y, int64_t dim);
+
+// number of different bits of two bit packed vectors
+float Hamming(const uint8_t* x, const uint8_t* y, int64_t bytes);
+
+// kernels of one instruction set
+struct Kernels {
+  const char* name;
+  float (*l2_sqr)(const float* x, const float* y, int64_t dim);
+  float (*inner_product)(const float* x, const float* y, int64_t dim);
+  float (*hamming)(const uint8_t* x, const uint8_t* y, int64_t bytes);
+};
+
+// kernels which are built and supported by the running cpu, from scalar to the widest, the last one is used
+const std::vector<Kernels>& SupportedKernels();
+
+// reference implementation, also the fallback of the kernels above
+namespace scalar {
+
+float L2Sqr(const float* x, const float* y, int64_t dim);
+float InnerProduct(const float* x, const float* y, int64_t dim);
+float Cosine(const float* x, const float* y, int64_t dim);
+
+float Hamming(const uint8_t* x, const uint8_t* y, int64_t bytes);
+
+}  // namespace scalar
+
+// exact distance of two vectors of same value type and dimension under metric_type, binary vectors are bit packed
+// and only support hamming
+Status Distance(const Vector& x, const Vector& y, MetricType metric_type, float& distance);
+
+// re-score results against query with their vector data, then sort them from best to worst. The new distance has
+// the form store reports, 1 - similarity for inner product and cosine. Results are re-scored all or none, when one
+// of them can not be scored results are left as reported by server and the error is returned.
+Status Rerank(const Vector& query, std::vector<VectorWithDistance>& results);
+
+}  // namespace vector_distance
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_VECTOR_DISTANCE_H_
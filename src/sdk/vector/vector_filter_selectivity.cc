@@ -0,0 +1,138 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/vector/vector_filter_selectivity.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "common/logging.h"
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/client_stub.h"
+#include "sdk/common/param_config.h"
+#include "sdk/expression/langchain_expr_evaluator.h"
+#include "sdk/utils/actuator.h"
+#include "sdk/vector/vector_index.h"
+#include "sdk/vector/vector_scan_query_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+double EstimateSelectivity(const ScalarSample& sample, expression::LangchainExpr* expr,
+                           const std::map<std::string, ScalarField>& params) {
+  if (sample.rows.empty()) {
+    return -1.0;
+  }
+
+  expression::LangChainExprEvaluator evaluator(&params);
+  int64_t matched = 0;
+  for (const auto& row : sample.rows) {
+    if (evaluator.Evaluate(expr, row)) {
+      matched++;
+    }
+  }
+
+  return static_cast<double>(matched) / sample.rows.size();
+}
+
+FilterPlan PlanFilter(double selectivity, int64_t topk) {
+  FilterPlan plan{kQueryPre, topk};
+  if (selectivity <= 0.0 || topk <= 0) {
+    return plan;
+  }
+
+  int64_t overfetch = static_cast<int64_t>(std::ceil(1.0 / selectivity));
+  if (overfetch <= FLAGS_vector_filter_auto_max_overfetch) {
+    plan.filter_type = kQueryPost;
+    plan.top_n = topk * overfetch;
+  }
+
+  return plan;
+}
+
+Status SampleScalarData(const ClientStub& stub, const std::shared_ptr<VectorIndex>& vector_index, ScalarSample& out) {
+  ScanQueryParam param;
+  param.vector_id_start = 1;
+  param.max_scan_count = FLAGS_vector_filter_sample_per_region;
+  param.with_vector_data = false;
+  param.with_scalar_data = true;
+  param.with_table_data = false;
+
+  out.rows.clear();
+  // part task asks every region of the partition for at most max_scan_count vectors
+  for (int64_t part_id : vector_index->GetPartitionIds()) {
+    VectorScanQueryPartTask task(stub, vector_index, part_id, param);
+    DINGO_RETURN_NOT_OK(task.Run());
+
+    for (auto& vector : task.GetResult()) {
+      out.rows.push_back(std::move(vector.scalar_data));
+    }
+  }
+  out.sample_time = std::chrono::steady_clock::now();
+
+  VLOG(kSdkVlogLevel) << "sampled " << out.rows.size() << " vectors of index: " << vector_index->GetId();
+  return Status::OK();
+}
+
+static void RefreshScalarSample(const ClientStub& stub, const std::shared_ptr<VectorIndex>& vector_index) {
+  if (!vector_index->StartScalarSampling()) {
+    return;
+  }
+
+  // sampling scans every region, it runs on actuator so searches are not blocked by it
+  std::weak_ptr<VectorIndex> weak_index = vector_index;
+  bool scheduled = stub.GetActuator()->Schedule(
+      [&stub, weak_index] {
+        auto index = weak_index.lock();
+        if (index == nullptr) {
+          return;
+        }
+
+        auto sample = std::make_shared<ScalarSample>();
+        Status s = SampleScalarData(stub, index, *sample);
+        if (!s.ok()) {
+          DINGO_LOG(WARNING) << "sample scalar data of index: " << index->GetId() << " fail: " << s.ToString();
+          sample.reset();
+        }
+        index->FinishScalarSampling(std::move(sample));
+      },
+      0);
+
+  if (!scheduled) {
+    vector_index->FinishScalarSampling(nullptr);
+  }
+}
+
+Status GetScalarSample(const ClientStub& stub, const std::shared_ptr<VectorIndex>& vector_index,
+                       std::shared_ptr<const ScalarSample>& out) {
+  std::shared_ptr<const ScalarSample> sample = vector_index->GetScalarSample();
+  auto ttl = std::chrono::seconds(FLAGS_vector_filter_sample_ttl_s);
+  if (sample == nullptr || std::chrono::steady_clock::now() - sample->sample_time >= ttl) {
+    RefreshScalarSample(stub, vector_index);
+  }
+
+  if (sample == nullptr) {
+    return Status::NotFound(fmt::format("scalar data of index {} is not sampled yet", vector_index->GetId()));
+  }
+
+  out = std::move(sample);
+  return Status::OK();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
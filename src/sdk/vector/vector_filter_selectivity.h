@@ -0,0 +1,69 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_FILTER_SELECTIVITY_H_
+#define DINGODB_SDK_VECTOR_FILTER_SELECTIVITY_H_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dingosdk/status.h"
+#include "dingosdk/vector.h"
+#include "sdk/expression/langchain_expr.h"
+
+namespace dingodb {
+namespace sdk {
+
+class ClientStub;
+class VectorIndex;
+
+// scalar data of the vectors sampled from every region of one index
+struct ScalarSample {
+  std::vector<std::map<std::string, ScalarValue>> rows;
+  std::chrono::steady_clock::time_point sample_time;
+};
+
+// filter type and top_n sent to regions
+struct FilterPlan {
+  FilterType filter_type{kQueryPre};
+  int64_t top_n{0};
+};
+
+// fraction of the sampled vectors matching expr, negative when sample is empty.
+// regions are sampled with the same count, so small regions weigh more than they should.
+double EstimateSelectivity(const ScalarSample& sample, expression::LangchainExpr* expr,
+                           const std::map<std::string, ScalarField>& params);
+
+// post filter when topk over-fetched by 1 / selectivity is within vector_filter_auto_max_overfetch,
+// otherwise pre filter which never starves top-k, also pre filter when selectivity is unknown
+FilterPlan PlanFilter(double selectivity, int64_t topk);
+
+// scan at most vector_filter_sample_per_region vectors of every region, with only scalar data.
+// every region is scanned from its smallest id, so the sample leans to the oldest vectors of each region and the
+// estimate drifts when scalar data changes with insert order.
+Status SampleScalarData(const ClientStub& stub, const std::shared_ptr<VectorIndex>& vector_index, ScalarSample& out);
+
+// sample cached on vector_index. when it is missing or older than vector_filter_sample_ttl_s, one sampling is started
+// in background and the stale sample is returned meanwhile, NotFound when no sample is taken yet.
+Status GetScalarSample(const ClientStub& stub, const std::shared_ptr<VectorIndex>& vector_index,
+                       std::shared_ptr<const ScalarSample>& out);
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_VECTOR_FILTER_SELECTIVITY_H_
@@ -15,6 +15,7 @@
 #include "sdk/vector/vector_index.h"
 
 #include <cstdint>
+#include <memory>
 #include <sstream>
 #include <utility>
 #include <vector>
@@ -42,7 +43,9 @@ VectorIndex::VectorIndex(pb::meta::IndexDefinitionWithId index_def_with_id)
     CHECK(start_key_to_part_id_.insert({start_id, part_id}).second);
     CHECK(part_id_to_range_.insert({part_id, partition.range()}).second);
   }
+  id_region_map_ = std::make_unique<IdRegionMap>(kVectorPrefix, start_key_to_part_id_);
   MaybeGenerateScalarSchema();
+  prepared_filter_cache_ = std::make_unique<expression::PreparedFilterCache>(scalar_schema_);
   VLOG(kSdkVlogLevel) << "Init:" << ToString();
 }
 
@@ -99,6 +102,28 @@ bool VectorIndex::ExistRegion(std::shared_ptr<Region> region) const {
   return false;
 }
 
+std::shared_ptr<const ScalarSample> VectorIndex::GetScalarSample() const {
+  std::lock_guard<std::mutex> guard(scalar_sample_mutex_);
+  return scalar_sample_;
+}
+
+bool VectorIndex::StartScalarSampling() {
+  std::lock_guard<std::mutex> guard(scalar_sample_mutex_);
+  if (scalar_sampling_) {
+    return false;
+  }
+  scalar_sampling_ = true;
+  return true;
+}
+
+void VectorIndex::FinishScalarSampling(std::shared_ptr<const ScalarSample> sample) {
+  std::lock_guard<std::mutex> guard(scalar_sample_mutex_);
+  scalar_sampling_ = false;
+  if (sample != nullptr) {
+    scalar_sample_ = std::move(sample);
+  }
+}
+
 void VectorIndex::MaybeGenerateScalarSchema() {
   for (const auto& schema_item :
        index_def_with_id_.index_definition().index_parameter().vector_index_parameter().scalar_schema().fields()) {
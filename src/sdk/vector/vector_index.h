@@ -17,16 +17,20 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
 #include "dingosdk/vector.h"
 #include "proto/meta.pb.h"
+#include "sdk/expression/langchain_prepared_filter.h"
+#include "sdk/id_region_map.h"
 #include "sdk/region.h"
 
 namespace dingodb {
 namespace sdk {
 
+struct ScalarSample;
 class VectorIndexCache;
 class VectorIndex {
  public:
@@ -61,8 +65,21 @@ class VectorIndex {
   bool HasScalarSchema() const { return !scalar_schema_.empty(); }
   const std::unordered_map<std::string, Type>& GetScalarSchema() const { return scalar_schema_; }
 
+  // compiled langchain filters against the scalar schema of this index version
+  expression::PreparedFilterCache& GetPreparedFilterCache() const { return *prepared_filter_cache_; }
+
+  // scalar data sampled for filter selectivity estimate, nullptr when not sampled
+  std::shared_ptr<const ScalarSample> GetScalarSample() const;
+  // only one sampling of the index runs at a time, return false when one is running
+  bool StartScalarSampling();
+  // sample is nullptr when sampling fails, the previous sample is kept
+  void FinishScalarSampling(std::shared_ptr<const ScalarSample> sample);
+
   const pb::meta::IndexDefinitionWithId& GetIndexDefWithId() const { return index_def_with_id_; }
 
+  // routes ids of the index to regions by id intervals, lives as long as this index version
+  IdRegionMap& GetIdRegionMap() const { return *id_region_map_; }
+
   std::string ToString(bool verbose = false) const;
 
   bool ExistRegion(std::shared_ptr<Region> region) const;
@@ -85,8 +102,14 @@ class VectorIndex {
   // start_key is 0 or valid vector id
   std::map<int64_t, int64_t> start_key_to_part_id_;
   std::map<int64_t, pb::common::Range> part_id_to_range_;
+  std::unique_ptr<IdRegionMap> id_region_map_;
 
   std::unordered_map<std::string, Type> scalar_schema_;
+  std::unique_ptr<expression::PreparedFilterCache> prepared_filter_cache_;
+
+  mutable std::mutex scalar_sample_mutex_;
+  std::shared_ptr<const ScalarSample> scalar_sample_;
+  bool scalar_sampling_{false};
 
   std::atomic<bool> stale_{true};
 };
@@ -119,6 +119,55 @@ std::string VectorWithId::ToString() const {
   return ss.str();
 }
 
+int64_t ScalarColumn::Size() const {
+  switch (type) {
+    case Type::kBOOL:
+      return bool_data.size();
+    case Type::kINT64:
+      return long_data.size();
+    case Type::kDOUBLE:
+      return double_data.size();
+    case Type::kSTRING:
+      return string_data.size();
+    default:
+      return 0;
+  }
+}
+
+std::string ScalarColumn::ToString() const {
+  return fmt::format("ScalarColumn {{ type: {}, size: {} }}", TypeToString(type), Size());
+}
+
+int64_t VectorBatch::Rows() const {
+  if (dimension <= 0) {
+    return 0;
+  }
+
+  if (value_type == ValueType::kFloat) {
+    return float_values.size() / dimension;
+  } else {
+    return binary_values.size() / BinaryRowBytes();
+  }
+}
+
+std::string VectorBatch::ToString() const {
+  std::stringstream ss;
+  ss << "VectorBatch { dimension: " << dimension << ", value_type: " << ValueTypeToString(value_type)
+     << ", rows: " << Rows() << ", ids: " << ids.size();
+
+  if (!scalar_columns.empty()) {
+    ss << ", scalar_columns: {";
+    for (const auto& pair : scalar_columns) {
+      ss << " " << pair.first << ": " << pair.second.ToString() << ",";
+    }
+    ss.seekp(-1, std::ios_base::end);  // Remove the trailing comma
+    ss << " }";
+  }
+
+  ss << " }";
+  return ss.str();
+}
+
 std::string VectorWithDistance::ToString() const {
   return fmt::format("VectorWithDistance {{ vector: {}, distance: {}, metric_type: {} }}", vector_data.ToString(),
                      distance, MetricTypeToString(metric_type));
@@ -134,6 +183,33 @@ std::string SearchResult::ToString() const {
   return oss.str();
 }
 
+std::string StreamSearchResult::ToString() const {
+  std::ostringstream oss;
+  oss << "StreamSearchResult { region_count: " << region_count << ", skipped_region_ids: [";
+  for (const auto& region_id : skipped_region_ids) {
+    oss << region_id << ", ";
+  }
+  oss << "], results: [";
+  for (const auto& result : results) {
+    oss << result.ToString() << ", ";
+  }
+  oss << "]}";
+  return oss.str();
+}
+
+std::string SearchCacheStats::ToString() const {
+  return fmt::format("SearchCacheStats {{ hits: {}, misses: {}, hit_rate: {:.4f}, entries: {}, bytes: {} }}", hits,
+                     misses, HitRate(), entries, bytes);
+}
+
+std::string BulkLoadProgress::ToString() const {
+  return fmt::format(
+      "BulkLoadProgress {{ submitted: {}, added: {}, skipped: {}, retried: {}, rpc: {}, bytes: {}, elapsed_ms: {}, "
+      "vectors_per_second: {:.1f}, checkpoint: {} }}",
+      submitted_count, added_count, skipped_count, retried_count, rpc_count, bytes, elapsed_ms, VectorsPerSecond(),
+      checkpoint);
+}
+
 std::string DeleteResult::ToString() const {
   return fmt::format("DeleteResult {{ vector_id: {}, deleted: {} }}", vector_id, (deleted ? "true" : "false"));
 }
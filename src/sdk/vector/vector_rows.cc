@@ -0,0 +1,180 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "sdk/vector/vector_rows.h"
+
+#include <cstdint>
+#include <string>
+
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/types_util.h"
+#include "sdk/vector/vector_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+Status VectorRows::Check() const {
+  if (batch_ == nullptr) {
+    return Status::OK();
+  }
+
+  if (batch_->dimension <= 0) {
+    return Status::InvalidArgument("vector batch dimension must be positive");
+  }
+
+  int64_t rows = batch_->Rows();
+  if (batch_->value_type == ValueType::kFloat) {
+    if (!batch_->binary_values.empty()) {
+      return Status::InvalidArgument("float vector batch must not have binary_values");
+    }
+    if (static_cast<int64_t>(batch_->float_values.size()) != rows * batch_->dimension) {
+      return Status::InvalidArgument(
+          fmt::format("float_values size:{} is not multiple of dimension:{}", batch_->float_values.size(),
+                      batch_->dimension));
+    }
+  } else if (batch_->value_type == ValueType::kUint8 || batch_->value_type == ValueType::kInt8) {
+    if (!batch_->float_values.empty()) {
+      return Status::InvalidArgument("binary vector batch must not have float_values");
+    }
+    if (static_cast<int64_t>(batch_->binary_values.size()) != rows * batch_->BinaryRowBytes()) {
+      return Status::InvalidArgument(fmt::format("binary_values size:{} is not multiple of row bytes:{}",
+                                                 batch_->binary_values.size(), batch_->BinaryRowBytes()));
+    }
+  } else {
+    return Status::InvalidArgument("vector batch value_type is not set");
+  }
+
+  if (!batch_->ids.empty() && static_cast<int64_t>(batch_->ids.size()) != rows) {
+    return Status::InvalidArgument(fmt::format("ids size:{} not equal rows:{}", batch_->ids.size(), rows));
+  }
+
+  for (const auto& [key, column] : batch_->scalar_columns) {
+    if (column.type != kBOOL && column.type != kINT64 && column.type != kDOUBLE && column.type != kSTRING) {
+      return Status::InvalidArgument(
+          fmt::format("scalar column:{} unsupported type:{}", key, TypeToString(column.type)));
+    }
+    if (column.Size() != rows) {
+      return Status::InvalidArgument(
+          fmt::format("scalar column:{} size:{} not equal rows:{}", key, column.Size(), rows));
+    }
+  }
+
+  return Status::OK();
+}
+
+int64_t VectorRows::Size() const {
+  if (batch_ != nullptr) {
+    return batch_->Rows();
+  } else {
+    return vectors_->size();
+  }
+}
+
+int64_t VectorRows::GetId(int64_t idx) const {
+  if (batch_ != nullptr) {
+    return batch_->ids.empty() ? 0 : batch_->ids[idx];
+  } else {
+    return (*vectors_)[idx].id;
+  }
+}
+
+void VectorRows::SetIds(const std::vector<int64_t>& ids) {
+  CHECK_EQ(ids.size(), Size());
+  if (batch_ != nullptr) {
+    CHECK_NOTNULL(mutable_batch_);
+    mutable_batch_->ids = ids;
+  } else {
+    CHECK_NOTNULL(mutable_vectors_);
+    for (size_t i = 0; i < ids.size(); i++) {
+      (*mutable_vectors_)[i].id = ids[i];
+    }
+  }
+}
+
+void VectorRows::FillVectorWithIdPB(pb::common::VectorWithId* pb, int64_t idx, bool with_id) const {
+  if (batch_ == nullptr) {
+    sdk::FillVectorWithIdPB(pb, (*vectors_)[idx], with_id);
+    return;
+  }
+
+  if (with_id) {
+    pb->set_id(GetId(idx));
+  }
+
+  auto* vector_pb = pb->mutable_vector();
+  vector_pb->set_dimension(batch_->dimension);
+  vector_pb->set_value_type(ValueType2InternalValueTypePB(batch_->value_type));
+  if (batch_->value_type == ValueType::kFloat) {
+    const float* begin = batch_->float_values.data() + idx * batch_->dimension;
+    vector_pb->mutable_float_values()->Reserve(batch_->dimension);
+    vector_pb->mutable_float_values()->Add(begin, begin + batch_->dimension);
+  } else {
+    int32_t row_bytes = batch_->BinaryRowBytes();
+    const uint8_t* begin = batch_->binary_values.data() + idx * row_bytes;
+    vector_pb->mutable_binary_values()->Reserve(row_bytes);
+    for (int32_t i = 0; i < row_bytes; i++) {
+      vector_pb->add_binary_values()->assign(1, static_cast<char>(begin[i]));
+    }
+  }
+
+  if (batch_->scalar_columns.empty()) {
+    return;
+  }
+
+  auto* scalar_data = pb->mutable_scalar_data()->mutable_scalar_data();
+  for (const auto& [key, column] : batch_->scalar_columns) {
+    pb::common::ScalarValue& value = (*scalar_data)[key];
+    value.set_field_type(Type2InternalScalarFieldTypePB(column.type));
+    auto* field = value.add_fields();
+    switch (column.type) {
+      case kBOOL:
+        field->set_bool_data(column.bool_data[idx]);
+        break;
+      case kINT64:
+        field->set_long_data(column.long_data[idx]);
+        break;
+      case kDOUBLE:
+        field->set_double_data(column.double_data[idx]);
+        break;
+      case kSTRING:
+        field->set_string_data(column.string_data[idx]);
+        break;
+      default:
+        CHECK(false) << "unsupported scalar column type:" << column.type;
+    }
+  }
+}
+
+Vector VectorRows::GetVector(int64_t idx) const {
+  if (batch_ == nullptr) {
+    return (*vectors_)[idx].vector;
+  }
+
+  Vector vector(batch_->value_type, batch_->dimension);
+  if (batch_->value_type == ValueType::kFloat) {
+    const float* begin = batch_->float_values.data() + idx * batch_->dimension;
+    vector.float_values.assign(begin, begin + batch_->dimension);
+  } else {
+    int32_t row_bytes = batch_->BinaryRowBytes();
+    const uint8_t* begin = batch_->binary_values.data() + idx * row_bytes;
+    vector.binary_values.assign(begin, begin + row_bytes);
+  }
+
+  return vector;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,69 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DINGODB_SDK_VECTOR_ROWS_H_
+#define DINGODB_SDK_VECTOR_ROWS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "dingosdk/status.h"
+#include "dingosdk/vector.h"
+#include "proto/common.pb.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Row access over the vector inputs accepted by vector tasks, either row-oriented std::vector<VectorWithId> or
+// columnar VectorBatch. It only holds a pointer to the user input, so it is cheap to copy, the input must outlive it.
+class VectorRows {
+ public:
+  explicit VectorRows(std::vector<VectorWithId>& vectors) : vectors_(&vectors), mutable_vectors_(&vectors) {}
+  explicit VectorRows(const std::vector<VectorWithId>& vectors) : vectors_(&vectors) {}
+  explicit VectorRows(VectorBatch& batch) : batch_(&batch), mutable_batch_(&batch) {}
+  explicit VectorRows(const VectorBatch& batch) : batch_(&batch) {}
+
+  ~VectorRows() = default;
+
+  // check VectorBatch layout, always ok for std::vector<VectorWithId>
+  Status Check() const;
+
+  int64_t Size() const;
+
+  bool Empty() const { return Size() == 0; }
+
+  // return 0 when VectorBatch ids is empty
+  int64_t GetId(int64_t idx) const;
+
+  // overwrite all ids, ids.size() must equal Size(), only for mutable input
+  void SetIds(const std::vector<int64_t>& ids);
+
+  // encode row idx into pb directly from user input
+  void FillVectorWithIdPB(pb::common::VectorWithId* pb, int64_t idx, bool with_id = true) const;
+
+  // copy vector of row idx
+  Vector GetVector(int64_t idx) const;
+
+ private:
+  const std::vector<VectorWithId>* vectors_{nullptr};
+  std::vector<VectorWithId>* mutable_vectors_{nullptr};
+  const VectorBatch* batch_{nullptr};
+  VectorBatch* mutable_batch_{nullptr};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_VECTOR_ROWS_H_
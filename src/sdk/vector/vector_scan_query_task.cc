@@ -14,35 +14,71 @@
 
 #include "sdk/vector/vector_scan_query_task.h"
 
+#include <algorithm>
+
 #include "glog/logging.h"
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
+#include "sdk/common/scan_cursor.h"
 #include "dingosdk/status.h"
 #include "sdk/utils/scoped_cleanup.h"
 #include "sdk/vector/vector_common.h"
+#include "sdk/vector/vector_helper.h"
 
 namespace dingodb {
 namespace sdk {
 
-Status VectorScanQueryTask::Init() {
-  if (scan_query_param_.max_scan_count < 0) {
+static Status CheckScanQueryParam(const ScanQueryParam& scan_query_param) {
+  if (scan_query_param.max_scan_count < 0) {
     return Status::InvalidArgument("max_scan_count must be greater than or equal to 0");
   }
 
-  if (scan_query_param_.is_reverse) {
-    if (!(scan_query_param_.vector_id_end < scan_query_param_.vector_id_start)) {
+  if (scan_query_param.is_reverse) {
+    if (!(scan_query_param.vector_id_end < scan_query_param.vector_id_start)) {
       return Status::InvalidArgument("vector_id_end must be less than vector_id_start in reverse scan");
     }
   } else {
-    if (scan_query_param_.vector_id_end != 0 &&
-        !(scan_query_param_.vector_id_start < scan_query_param_.vector_id_end)) {
+    if (scan_query_param.vector_id_end != 0 &&
+        !(scan_query_param.vector_id_start < scan_query_param.vector_id_end)) {
       return Status::InvalidArgument("vector_id_end must be greater than vector_id_start in forward scan");
     }
   }
 
-  if (scan_query_param_.max_scan_count <= 0) {
+  if (scan_query_param.max_scan_count <= 0) {
     return Status::InvalidArgument("max_scan_count must bigger than 0");
   }
 
+  return Status::OK();
+}
+
+static void FillScanQueryRequest(pb::index::VectorScanQueryRequest* request, const ScanQueryParam& scan_query_param) {
+  request->set_vector_id_start(scan_query_param.vector_id_start);
+  request->set_is_reverse_scan(scan_query_param.is_reverse);
+  request->set_max_scan_count(scan_query_param.max_scan_count);
+  request->set_vector_id_end(scan_query_param.vector_id_end);
+  request->set_without_vector_data(!scan_query_param.with_vector_data);
+  request->set_without_scalar_data(!scan_query_param.with_scalar_data);
+  if (scan_query_param.with_scalar_data) {
+    for (const auto& key : scan_query_param.selected_keys) {
+      request->add_selected_keys(key);
+    }
+  }
+
+  request->set_without_table_data(!scan_query_param.with_table_data);
+  request->set_use_scalar_filter(scan_query_param.use_scalar_filter);
+  if (scan_query_param.use_scalar_filter) {
+    request->set_without_scalar_data(false);
+
+    for (const auto& [key, value] : scan_query_param.scalar_data) {
+      request->mutable_scalar_for_filter()->mutable_scalar_data()->insert(
+          {key, ScalarValue2InternalScalarValuePB(value)});
+    }
+  }
+}
+
+Status VectorScanQueryTask::Init() {
+  DINGO_RETURN_NOT_OK(CheckScanQueryParam(scan_query_param_));
+
   std::shared_ptr<VectorIndex> tmp;
   DINGO_RETURN_NOT_OK(stub.GetVectorIndexCache()->GetVectorIndexById(index_id_, tmp));
   DCHECK_NOTNULL(tmp);
@@ -172,29 +208,7 @@ void VectorScanQueryPartTask::DoAsync() {
 void VectorScanQueryPartTask::FillVectorScanQueryRpcRequest(pb::index::VectorScanQueryRequest* request,
                                                             const std::shared_ptr<Region>& region) {
   FillRpcContext(*request->mutable_context(), region->RegionId(), region->Epoch());
-
-  request->set_vector_id_start(scan_query_param_.vector_id_start);
-  request->set_is_reverse_scan(scan_query_param_.is_reverse);
-  request->set_max_scan_count(scan_query_param_.max_scan_count);
-  request->set_vector_id_end(scan_query_param_.vector_id_end);
-  request->set_without_vector_data(!scan_query_param_.with_vector_data);
-  request->set_without_scalar_data(!scan_query_param_.with_scalar_data);
-  if (scan_query_param_.with_scalar_data) {
-    for (const auto& key : scan_query_param_.selected_keys) {
-      request->add_selected_keys(key);
-    }
-  }
-
-  request->set_without_table_data(!scan_query_param_.with_table_data);
-  request->set_use_scalar_filter(scan_query_param_.use_scalar_filter);
-  if (scan_query_param_.use_scalar_filter) {
-    request->set_without_scalar_data(false);
-
-    for (const auto& [key, value] : scan_query_param_.scalar_data) {
-      request->mutable_scalar_for_filter()->mutable_scalar_data()->insert(
-          {key, ScalarValue2InternalScalarValuePB(value)});
-    }
-  }
+  FillScanQueryRequest(request, scan_query_param_);
 }
 
 void VectorScanQueryPartTask::VectorScanQueryRpcCallback(Status status, VectorScanQueryRpc* rpc) {
@@ -226,5 +240,173 @@ void VectorScanQueryPartTask::VectorScanQueryRpcCallback(Status status, VectorSc
   }
 }
 
+Status VectorScanQueryPageTask::Init() {
+  DINGO_RETURN_NOT_OK(CheckScanQueryParam(scan_query_param_));
+
+  if (page_token_.empty()) {
+    start_id_ = std::max<int64_t>(scan_query_param_.vector_id_start, 1);
+  } else {
+    DINGO_RETURN_NOT_OK(scan_cursor::DecodeToken(page_token_, start_id_));
+  }
+
+  std::shared_ptr<VectorIndex> tmp;
+  DINGO_RETURN_NOT_OK(stub.GetVectorIndexCache()->GetVectorIndexById(index_id_, tmp));
+  DCHECK_NOTNULL(tmp);
+  vector_index_ = std::move(tmp);
+
+  return Status::OK();
+}
+
+void VectorScanQueryPageTask::DoAsync() {
+  {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    result_vectors_.clear();
+    status_ = Status::OK();
+  }
+
+  cursor_id_ = start_id_;
+  regions_.clear();
+  next_region_idx_ = 0;
+
+  Status s = scan_cursor::OrderedRegions(stub, *vector_index_, cursor_id_, scan_query_param_.is_reverse,
+                                         vector_helper::VectorIdToRangeKey, regions_);
+  if (!s.ok()) {
+    DoAsyncDone(s);
+    return;
+  }
+
+  if (regions_.empty()) {
+    Done(Status::OK());
+    return;
+  }
+
+  SendNextRegions();
+}
+
+void VectorScanQueryPageTask::SendNextRegions() {
+  int64_t count = std::min<int64_t>(std::max<int64_t>(FLAGS_scan_query_page_parallel_regions, 1),
+                                    regions_.size() - next_region_idx_);
+  // one row more than the page is asked for, it tells whether rows are left after the page
+  int64_t missing_count = scan_query_param_.max_scan_count + 1 - result_vectors_.size();
+
+  controllers_.clear();
+  rpcs_.clear();
+  region_vectors_.assign(count, {});
+
+  for (int64_t i = 0; i < count; i++) {
+    const auto& region = regions_[next_region_idx_ + i];
+
+    auto rpc = std::make_unique<VectorScanQueryRpc>();
+    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
+    FillScanQueryRequest(rpc->MutableRequest(), scan_query_param_);
+    rpc->MutableRequest()->set_vector_id_start(cursor_id_);
+    rpc->MutableRequest()->set_max_scan_count(missing_count);
+
+    controllers_.emplace_back(stub, *rpc, region);
+    rpcs_.push_back(std::move(rpc));
+  }
+
+  sub_tasks_count_.store(count);
+
+  for (int64_t i = 0; i < count; i++) {
+    controllers_[i].AsyncCall([this, rpc = rpcs_[i].get(), i](auto&& s) {
+      VectorScanQueryRpcCallback(std::forward<decltype(s)>(s), rpc, i);
+    });
+  }
+}
+
+void VectorScanQueryPageTask::VectorScanQueryRpcCallback(const Status& status, VectorScanQueryRpc* rpc, int64_t idx) {
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << rpc->Request()->context().region_id()
+                       << " fail: " << status.ToString();
+
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    if (status_.ok()) {
+      // only return first fail status
+      status_ = status;
+    }
+  } else {
+    std::unique_lock<std::shared_mutex> w(rw_lock_);
+    auto& vectors = region_vectors_[idx];
+    vectors.reserve(rpc->Response()->vectors_size());
+    for (const auto& vectorid_pb : rpc->Response()->vectors()) {
+      vectors.emplace_back(InternalVectorIdPB2VectorWithId(vectorid_pb));
+    }
+  }
+
+  if (sub_tasks_count_.fetch_sub(1) == 1) {
+    Status tmp;
+    bool finished = false;
+    {
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      tmp = status_;
+      if (tmp.ok()) {
+        finished = CollectResultUnlocked();
+      }
+    }
+
+    if (!tmp.ok()) {
+      DoAsyncDone(tmp);
+    } else if (finished) {
+      Done(tmp);
+    } else {
+      // the next round clears controllers and rpcs, one of them is still firing this callback
+      stub.GetActuator()->Execute([this] { SendNextRegions(); });
+    }
+  }
+}
+
+bool VectorScanQueryPageTask::CollectResultUnlocked() {
+  auto limit = scan_query_param_.max_scan_count + 1;
+  for (int64_t i = 0; i < region_vectors_.size(); i++) {
+    auto& vectors = region_vectors_[i];
+    if (scan_query_param_.is_reverse) {
+      std::sort(vectors.begin(), vectors.end(),
+                [](const VectorWithId& a, const VectorWithId& b) { return a.id > b.id; });
+    } else {
+      std::sort(vectors.begin(), vectors.end(),
+                [](const VectorWithId& a, const VectorWithId& b) { return a.id < b.id; });
+    }
+
+    int64_t last_id = vectors.empty() ? 0 : vectors.back().id;
+    for (auto& vector : vectors) {
+      if (result_vectors_.size() >= limit) {
+        return true;
+      }
+      result_vectors_.push_back(std::move(vector));
+    }
+
+    if (result_vectors_.size() >= limit) {
+      return true;
+    }
+
+    // without scalar filter a region returns less than asked only when it has no more vectors after cursor, so the
+    // next region follows. the scalar filter may stop a region before its end, so scan it again after its last vector
+    // until it returns nothing.
+    if (scan_query_param_.use_scalar_filter && !vectors.empty()) {
+      if (!scan_query_param_.is_reverse || last_id > 1) {
+        cursor_id_ = scan_query_param_.is_reverse ? last_id - 1 : last_id + 1;
+        next_region_idx_ += i;
+        return false;
+      }
+    }
+  }
+
+  next_region_idx_ += region_vectors_.size();
+  return next_region_idx_ >= regions_.size();
+}
+
+void VectorScanQueryPageTask::Done(const Status& status) {
+  // the look-ahead vector is where the next page starts, without it the scan is finished
+  next_page_token_.clear();
+  if (result_vectors_.size() > scan_query_param_.max_scan_count) {
+    next_page_token_ = scan_cursor::EncodeToken(result_vectors_[scan_query_param_.max_scan_count].id);
+    result_vectors_.resize(scan_query_param_.max_scan_count);
+  }
+
+  out_result_.vectors = std::move(result_vectors_);
+  DoAsyncDone(status);
+}
+
 }  // namespace sdk
-}  // namespace dingodb
\ No newline at end of file
+}  // namespace dingodb
@@ -0,0 +1,206 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "sdk/vector/vector_search_cache.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string>
+
+namespace dingodb {
+namespace sdk {
+
+static int64_t NowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+template <typename T>
+static void AppendValue(std::string& buf, T value) {
+  buf.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void AppendString(std::string& buf, const std::string& value) {
+  AppendValue<uint32_t>(buf, value.size());
+  buf.append(value);
+}
+
+// values out of the int64 range after quantization, or not finite, are marked and kept as exact float bits
+static constexpr int64_t kExactValueMark = std::numeric_limits<int64_t>::min();
+static constexpr double kMaxQuantized = 9.2e18;
+
+static void AppendQuantized(std::string& buf, float value, double step) {
+  if (step > 0) {
+    double quantized = value / step;
+    if (std::isfinite(quantized) && std::fabs(quantized) < kMaxQuantized) {
+      AppendValue<int64_t>(buf, std::llround(quantized));
+      return;
+    }
+    AppendValue<int64_t>(buf, kExactValueMark);
+  }
+
+  // -0.0 and 0.0 are the same query value
+  float exact = value == 0 ? 0.0f : value;
+  uint32_t bits;
+  memcpy(&bits, &exact, sizeof(bits));
+  AppendValue<uint32_t>(buf, bits);
+}
+
+static int64_t EstimateBytes(const VectorWithDistance& result) {
+  const auto& vector_data = result.vector_data;
+  int64_t bytes = sizeof(VectorWithDistance) + vector_data.vector.float_values.size() * sizeof(float) +
+                  vector_data.vector.binary_values.size();
+  for (const auto& [key, value] : vector_data.scalar_data) {
+    bytes += key.size() + sizeof(ScalarValue) + value.fields.size() * sizeof(ScalarField);
+    for (const auto& field : value.fields) {
+      bytes += field.string_data.size();
+    }
+  }
+  return bytes;
+}
+
+VectorSearchCache::VectorSearchCache(int64_t capacity_bytes, int64_t ttl_ms, double quantize_step)
+    : capacity_bytes_(capacity_bytes), ttl_ms_(ttl_ms), quantize_step_(quantize_step) {}
+
+std::string VectorSearchCache::EncodeKey(int64_t index_id, const SearchParam& search_param, const Vector& query) {
+  std::string key;
+  AppendValue(key, index_id);
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    AppendValue(key, generations_[index_id]);
+  }
+
+  EncodeSearchParam(search_param, key);
+
+  AppendValue(key, query.value_type);
+  AppendValue<uint32_t>(key, query.float_values.size());
+  for (float value : query.float_values) {
+    AppendQuantized(key, value, quantize_step_);
+  }
+  AppendValue<uint32_t>(key, query.binary_values.size());
+  key.append(query.binary_values.begin(), query.binary_values.end());
+
+  return key;
+}
+
+bool VectorSearchCache::Get(const std::string& key, std::vector<VectorWithDistance>& out_result) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = entries_.find(key);
+  if (iter == entries_.end()) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  if (iter->second->expire_ms <= NowMs()) {
+    EraseUnlocked(iter->second);
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  lru_.splice(lru_.begin(), lru_, iter->second);
+  out_result = iter->second->result;
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void VectorSearchCache::Put(const std::string& key, const std::vector<VectorWithDistance>& result) {
+  int64_t bytes = sizeof(Entry) + key.size() * 2;
+  for (const auto& vector_with_distance : result) {
+    bytes += EstimateBytes(vector_with_distance);
+  }
+
+  if (bytes > capacity_bytes_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = entries_.find(key);
+  if (iter != entries_.end()) {
+    EraseUnlocked(iter->second);
+  }
+
+  lru_.push_front(Entry{key, result, bytes, NowMs() + ttl_ms_});
+  entries_.emplace(key, lru_.begin());
+  bytes_ += bytes;
+
+  while (bytes_ > capacity_bytes_) {
+    EraseUnlocked(std::prev(lru_.end()));
+  }
+}
+
+void VectorSearchCache::Invalidate(int64_t index_id) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  generations_[index_id]++;
+}
+
+void VectorSearchCache::GetStats(SearchCacheStats& stats) const {
+  stats.hits = hits_.load(std::memory_order_relaxed);
+  stats.misses = misses_.load(std::memory_order_relaxed);
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  stats.entries = entries_.size();
+  stats.bytes = bytes_;
+}
+
+void VectorSearchCache::EncodeSearchParam(const SearchParam& search_param, std::string& key) {
+  AppendValue(key, search_param.topk);
+  AppendValue(key, search_param.with_vector_data);
+  AppendValue(key, search_param.with_scalar_data);
+  AppendValue<uint32_t>(key, search_param.selected_keys.size());
+  for (const auto& selected_key : search_param.selected_keys) {
+    AppendString(key, selected_key);
+  }
+  AppendValue(key, search_param.with_table_data);
+  AppendValue(key, search_param.enable_range_search);
+  AppendValue(key, search_param.radius);
+  AppendValue(key, search_param.filter_source);
+  AppendValue(key, search_param.filter_type);
+  AppendValue(key, search_param.is_negation);
+  AppendValue(key, search_param.is_sorted);
+  AppendValue<uint32_t>(key, search_param.vector_ids.size());
+  for (const auto& id : search_param.vector_ids) {
+    AppendValue(key, id);
+  }
+  AppendValue(key, search_param.use_brute_force);
+  AppendValue<uint32_t>(key, search_param.extra_params.size());
+  for (const auto& [type, value] : search_param.extra_params) {
+    AppendValue(key, type);
+    AppendValue(key, value);
+  }
+  AppendString(key, search_param.langchain_expr_json);
+  AppendValue<uint32_t>(key, search_param.langchain_expr_params.size());
+  for (const auto& [name, field] : search_param.langchain_expr_params) {
+    AppendString(key, name);
+    AppendValue(key, field.bool_data);
+    AppendValue(key, field.long_data);
+    AppendValue(key, field.double_data);
+    AppendString(key, field.string_data);
+  }
+  AppendValue(key, search_param.beamwidth);
+  AppendValue(key, search_param.client_rerank);
+}
+
+void VectorSearchCache::EraseUnlocked(std::list<Entry>::iterator iter) {
+  bytes_ -= iter->bytes;
+  entries_.erase(iter->key);
+  lru_.erase(iter);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,85 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DINGODB_SDK_VECTOR_SEARCH_CACHE_H_
+#define DINGODB_SDK_VECTOR_SEARCH_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dingosdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+
+// LRU cache of the search result of one query vector, bounded by memory and ttl.
+// The key is made of index id, index generation, search param and the query vector quantized by quantize_step, so
+// near-duplicate queries share one entry, quantize_step <= 0 keys the exact float values. Writes to an index bump
+// its generation, old entries can not be hit anymore and age out by LRU.
+class VectorSearchCache {
+ public:
+  VectorSearchCache(int64_t capacity_bytes, int64_t ttl_ms, double quantize_step);
+
+  ~VectorSearchCache() = default;
+
+  bool Enabled() const { return capacity_bytes_ > 0; }
+
+  std::string EncodeKey(int64_t index_id, const SearchParam& search_param, const Vector& query);
+
+  bool Get(const std::string& key, std::vector<VectorWithDistance>& out_result);
+
+  void Put(const std::string& key, const std::vector<VectorWithDistance>& result);
+
+  void Invalidate(int64_t index_id);
+
+  void GetStats(SearchCacheStats& stats) const;
+
+  // append every field of search_param which may change the result
+  static void EncodeSearchParam(const SearchParam& search_param, std::string& key);
+
+ private:
+  struct Entry {
+    std::string key;
+    std::vector<VectorWithDistance> result;
+    int64_t bytes;
+    int64_t expire_ms;
+  };
+
+  void EraseUnlocked(std::list<Entry>::iterator iter);
+
+  const int64_t capacity_bytes_;
+  const int64_t ttl_ms_;
+  const double quantize_step_;
+
+  mutable std::mutex mutex_;
+  // front is the most recently used
+  std::list<Entry> lru_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> entries_;
+  std::unordered_map<int64_t, int64_t> generations_;
+  int64_t bytes_{0};
+
+  std::atomic<int64_t> hits_{0};
+  std::atomic<int64_t> misses_{0};
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_VECTOR_SEARCH_CACHE_H_
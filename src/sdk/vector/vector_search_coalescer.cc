@@ -0,0 +1,123 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/vector/vector_search_coalescer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+#include "fmt/core.h"
+#include "glog/logging.h"
+#include "sdk/vector/vector_search_cache.h"
+#include "sdk/vector/vector_search_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+VectorSearchCoalescer::VectorSearchCoalescer(int64_t window_us, int64_t max_batch)
+    : window_us_(window_us), max_batch_(max_batch) {}
+
+Status VectorSearchCoalescer::Search(const ClientStub& stub, int64_t index_id, const SearchParam& search_param,
+                                     const VectorRows& target_vectors, std::vector<SearchResult>& out_result) {
+  return Search(index_id, search_param, target_vectors, out_result,
+                [&](const std::vector<VectorWithId>& vectors, std::vector<SearchResult>& results) {
+                  VectorSearchTask task(stub, index_id, search_param, vectors, results);
+                  return task.Run();
+                });
+}
+
+Status VectorSearchCoalescer::Search(int64_t index_id, const SearchParam& search_param,
+                                     const VectorRows& target_vectors, std::vector<SearchResult>& out_result,
+                                     const SearchFunc& search_func) {
+  int64_t count = target_vectors.Size();
+  if (count >= max_batch_) {
+    // already a full batch, nothing to gain from waiting
+    std::vector<VectorWithId> vectors;
+    vectors.reserve(count);
+    for (int64_t i = 0; i < count; i++) {
+      vectors.emplace_back(target_vectors.GetVector(i));
+    }
+    return search_func(vectors, out_result);
+  }
+
+  std::string key;
+  key.append(reinterpret_cast<const char*>(&index_id), sizeof(index_id));
+  VectorSearchCache::EncodeSearchParam(search_param, key);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  bool leader = false;
+  auto& slot = batches_[key];
+  if (slot == nullptr) {
+    slot = std::make_shared<Batch>();
+    leader = true;
+  }
+  std::shared_ptr<Batch> batch = slot;
+
+  int64_t offset = batch->target_vectors.size();
+  for (int64_t i = 0; i < count; i++) {
+    batch->target_vectors.emplace_back(target_vectors.GetVector(i));
+  }
+
+  if (batch->target_vectors.size() >= max_batch_) {
+    SealUnlocked(key, batch);
+  }
+
+  if (leader) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(window_us_);
+    batch->cond.wait_until(lock, deadline, [&batch] { return batch->sealed; });
+    if (!batch->sealed) {
+      SealUnlocked(key, batch);
+    }
+    lock.unlock();
+
+    // nobody touches the batch until done is set, so run without lock
+    Status status = search_func(batch->target_vectors, batch->results);
+    if (status.ok() && batch->results.size() != batch->target_vectors.size()) {
+      status = Status::Incomplete(fmt::format("merged search expect {} results, but got {}",
+                                              batch->target_vectors.size(), batch->results.size()));
+    }
+
+    lock.lock();
+    batch->status = status;
+    batch->done = true;
+    batch->cond.notify_all();
+  } else {
+    batch->cond.wait(lock, [&batch] { return batch->done; });
+  }
+
+  if (!batch->status.ok()) {
+    return batch->status;
+  }
+
+  // each caller only moves its own slice
+  out_result.reserve(out_result.size() + count);
+  for (int64_t i = offset; i < offset + count; i++) {
+    out_result.push_back(std::move(batch->results[i]));
+  }
+
+  return Status::OK();
+}
+
+void VectorSearchCoalescer::SealUnlocked(const std::string& key, const std::shared_ptr<Batch>& batch) {
+  batch->sealed = true;
+  auto iter = batches_.find(key);
+  if (iter != batches_.end() && iter->second == batch) {
+    batches_.erase(iter);
+  }
+  batch->cond.notify_all();
+}
+
+}  // namespace sdk
+}  // namespace dingodb
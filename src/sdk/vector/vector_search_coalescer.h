@@ -0,0 +1,83 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_SEARCH_COALESCER_H_
+#define DINGODB_SDK_VECTOR_SEARCH_COALESCER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dingosdk/status.h"
+#include "dingosdk/vector.h"
+#include "sdk/vector/vector_rows.h"
+
+namespace dingodb {
+namespace sdk {
+
+class ClientStub;
+
+// Merge concurrent searches against the same index with the same search param into one multi-vector search, so each
+// region receives one rpc with all the query vectors instead of one rpc per caller.
+// The first caller of a batch is the leader, it waits at most window_us for others to join, or until the batch holds
+// max_batch query vectors, then runs the search for everyone and hands each caller back its own slice of results.
+class VectorSearchCoalescer {
+ public:
+  // run the merged search of the query vectors, result must be in the same order as the query vectors
+  using SearchFunc = std::function<Status(const std::vector<VectorWithId>& target_vectors,
+                                          std::vector<SearchResult>& out_result)>;
+
+  VectorSearchCoalescer(int64_t window_us, int64_t max_batch);
+
+  ~VectorSearchCoalescer() = default;
+
+  bool Enabled() const { return window_us_ > 0; }
+
+  Status Search(const ClientStub& stub, int64_t index_id, const SearchParam& search_param,
+                const VectorRows& target_vectors, std::vector<SearchResult>& out_result);
+
+  // same as above, but the merged search is run by search_func, used for test
+  Status Search(int64_t index_id, const SearchParam& search_param, const VectorRows& target_vectors,
+                std::vector<SearchResult>& out_result, const SearchFunc& search_func);
+
+ private:
+  struct Batch {
+    std::vector<VectorWithId> target_vectors;
+    std::vector<SearchResult> results;
+    // no caller can join when sealed
+    bool sealed{false};
+    bool done{false};
+    Status status;
+    std::condition_variable cond;
+  };
+
+  void SealUnlocked(const std::string& key, const std::shared_ptr<Batch>& batch);
+
+  const int64_t window_us_;
+  const int64_t max_batch_;
+
+  std::mutex mutex_;
+  // batches which are still open to join, key is index id and search param
+  std::unordered_map<std::string, std::shared_ptr<Batch>> batches_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_VECTOR_SEARCH_COALESCER_H_
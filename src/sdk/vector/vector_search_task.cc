@@ -16,30 +16,38 @@
 
 #include <algorithm>
 #include <cstdint>
-#include <iterator>
 #include <memory>
+#include <set>
+#include <unordered_map>
 
 #include "common/logging.h"
 #include "glog/logging.h"
 #include "proto/common.pb.h"
 #include "proto/index.pb.h"
 #include "sdk/common/common.h"
-#include "sdk/expression/langchain_expr.h"
-#include "sdk/expression/langchain_expr_encoder.h"
-#include "sdk/expression/langchain_expr_factory.h"
+#include "sdk/common/param_config.h"
+#include "sdk/expression/langchain_prepared_filter.h"
 #include "dingosdk/status.h"
 #include "sdk/utils/scoped_cleanup.h"
 #include "dingosdk/vector.h"
 #include "sdk/vector/vector_common.h"
+#include "sdk/vector/vector_distance.h"
+#include "sdk/vector/vector_filter_selectivity.h"
 
 namespace dingodb {
 namespace sdk {
 
 Status VectorSearchTask::Init() {
-  if (target_vectors_.empty()) {
+  if (target_vectors_.Empty()) {
     return Status::InvalidArgument("target_vectors is empty");
   }
 
+  DINGO_RETURN_NOT_OK(target_vectors_.Check());
+
+  if (search_param_.client_rerank && !search_param_.with_vector_data) {
+    return Status::InvalidArgument("client_rerank need with_vector_data");
+  }
+
   std::shared_ptr<VectorIndex> tmp;
   DINGO_RETURN_NOT_OK(stub.GetVectorIndexCache()->GetVectorIndexById(index_id_, tmp));
   DCHECK_NOTNULL(tmp);
@@ -47,29 +55,65 @@ Status VectorSearchTask::Init() {
 
   std::unique_lock<std::shared_mutex> w(rw_lock_);
 
-  auto part_ids = vector_index_->GetPartitionIds();
+  part_vector_ids_.clear();
+  if (PruneByVectorIds()) {
+    for (const auto& id : search_param_.vector_ids) {
+      if (id <= 0) {
+        return Status::InvalidArgument("vector id must be positive");
+      }
+      part_vector_ids_[vector_index_->GetPartitionId(id)].push_back(id);
+    }
+
+    // ids of a partition are sorted, so they are routed along the id intervals of the regions
+    for (auto& [part_id, ids] : part_vector_ids_) {
+      std::sort(ids.begin(), ids.end());
+      next_part_ids_.emplace(part_id);
+    }
+  } else {
+    auto part_ids = vector_index_->GetPartitionIds();
 
-  for (const auto& part_id : part_ids) {
-    next_part_ids_.emplace(part_id);
+    for (const auto& part_id : part_ids) {
+      next_part_ids_.emplace(part_id);
+    }
   }
 
-  {
-    // prepare search parameter
-    FillInternalSearchParams(&search_parameter_, vector_index_->GetVectorIndexType(), search_param_);
-    if (!search_param_.langchain_expr_json.empty()) {
-      std::shared_ptr<expression::LangchainExpr> expr;
-
-      std::unique_ptr<expression::LangchainExprFactory> expr_factory;
-      if (vector_index_->HasScalarSchema()) {
-        expr_factory = std::make_unique<expression::SchemaLangchainExprFactory>(vector_index_->GetScalarSchema());
-      } else {
-        expr_factory = std::make_unique<expression::LangchainExprFactory>();
-      }
-      DINGO_RETURN_NOT_OK(expr_factory->CreateExpr(search_param_.langchain_expr_json, expr));
+  DINGO_RETURN_NOT_OK(BuildSearchRequest(*vector_index_, search_param_, target_vectors_, search_request_));
+  if (PruneByVectorIds()) {
+    // filled per region with the ids the region owns
+    search_request_.mutable_parameter()->clear_vector_ids();
+  }
 
-      expression::LangChainExprEncoder encoder;
-      *(search_parameter_.mutable_vector_coprocessor()) = encoder.EncodeToCoprocessor(expr.get());
-    }
+  if (search_param_.filter_type == FilterType::kQueryAuto) {
+    PlanAutoFilter();
+  }
+
+  late_materialize_ = LateMaterialize();
+  if (late_materialize_) {
+    auto* parameter = search_request_.mutable_parameter();
+    parameter->set_without_vector_data(true);
+    parameter->set_without_scalar_data(true);
+    parameter->set_without_table_data(true);
+    parameter->clear_selected_keys();
+  }
+
+  return Status::OK();
+}
+
+Status VectorSearchTask::BuildSearchRequest(const VectorIndex& vector_index, const SearchParam& search_param,
+                                            const VectorRows& target_vectors,
+                                            pb::index::VectorSearchRequest& search_request) {
+  auto* search_parameter = search_request.mutable_parameter();
+  FillInternalSearchParams(search_parameter, vector_index.GetVectorIndexType(), search_param);
+  if (!search_param.langchain_expr_json.empty()) {
+    std::shared_ptr<const expression::PreparedFilter> filter;
+    DINGO_RETURN_NOT_OK(vector_index.GetPreparedFilterCache().Get(search_param.langchain_expr_json, filter));
+    DINGO_RETURN_NOT_OK(
+        filter->Bind(search_param.langchain_expr_params, *search_parameter->mutable_vector_coprocessor()));
+  }
+
+  for (int64_t i = 0; i < target_vectors.Size(); i++) {
+    // NOTE* vector_id is useless
+    target_vectors.FillVectorWithIdPB(search_request.add_vector_with_ids(), i, false);
   }
 
   return Status::OK();
@@ -91,7 +135,14 @@ void VectorSearchTask::DoAsync() {
   sub_tasks_count_.store(next_part_ids.size());
 
   for (const auto& part_id : next_part_ids) {
-    auto* sub_task = new VectorSearchPartTask(stub, index_id_, part_id, search_parameter_, target_vectors_);
+    std::vector<int64_t> vector_ids;
+    auto iter = part_vector_ids_.find(part_id);
+    if (iter != part_vector_ids_.end()) {
+      vector_ids = iter->second;
+    }
+
+    auto* sub_task =
+        new VectorSearchPartTask(stub, index_id_, part_id, search_request_, MergeTopK(), std::move(vector_ids));
     sub_task->AsyncRun([this, sub_task](auto&& s) { SubTaskCallback(std::forward<decltype(s)>(s), sub_task); });
   }
 }
@@ -109,15 +160,12 @@ void VectorSearchTask::SubTaskCallback(Status status, VectorSearchPartTask* sub_
     }
   } else {
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    std::unordered_map<int64_t, std::vector<VectorWithDistance>>& sub_results = sub_task->GetSearchResult();
+    std::unordered_map<int64_t, VectorTopK>& sub_results = sub_task->GetSearchResult();
     // merge
     for (auto& result : sub_results) {
       auto iter = tmp_out_result_.find(result.first);
       if (iter != tmp_out_result_.cend()) {
-        auto& origin = iter->second;
-        auto& to_put = result.second;
-        origin.reserve(origin.size() + to_put.size());
-        std::move(to_put.begin(), to_put.end(), std::back_inserter(origin));
+        iter->second.Merge(std::move(result.second));
       } else {
         CHECK(tmp_out_result_.insert({result.first, std::move(result.second)}).second);
       }
@@ -133,21 +181,19 @@ void VectorSearchTask::SubTaskCallback(Status status, VectorSearchPartTask* sub_
       ConstructResultUnlocked();
       tmp = status_;
     }
-    DoAsyncDone(tmp);
+
+    if (tmp.ok() && late_materialize_) {
+      FetchPayload();
+    } else {
+      DoAsyncDone(tmp);
+    }
   }
 }
 
 void VectorSearchTask::ConstructResultUnlocked() {
-  for (const auto& vector_with_id : target_vectors_) {
-    VectorWithId tmp;
-    {
-      //  NOTE: use copy
-      const Vector& to_copy = vector_with_id.vector;
-      tmp.vector.dimension = to_copy.dimension;
-      tmp.vector.value_type = to_copy.value_type;
-      tmp.vector.float_values = to_copy.float_values;
-      tmp.vector.binary_values = to_copy.binary_values;
-    }
+  for (int64_t i = 0; i < target_vectors_.Size(); i++) {
+    //  NOTE: use copy
+    VectorWithId tmp(target_vectors_.GetVector(i));
 
     SearchResult search(std::move(tmp));
 
@@ -155,20 +201,145 @@ void VectorSearchTask::ConstructResultUnlocked() {
   }
 
   for (auto& iter : tmp_out_result_) {
-    auto& vec = iter.second;
-    std::sort(vec.begin(), vec.end(),
-              [](const VectorWithDistance& a, const VectorWithDistance& b) { return a.distance < b.distance; });
+    int64_t idx = iter.first;
+    auto& vector_datas = out_result_[idx].vector_datas;
+    vector_datas = iter.second.Finish();
+
+    if (search_param_.client_rerank) {
+      Status s = vector_distance::Rerank(out_result_[idx].id.vector, vector_datas);
+      if (!s.ok()) {
+        DINGO_LOG(WARNING) << Name() << " rerank fail, keep distances of server: " << s.ToString();
+      }
+      if (!search_param_.enable_range_search && search_param_.topk > 0 && search_param_.topk < vector_datas.size()) {
+        vector_datas.resize(search_param_.topk);
+      }
+    }
   }
+}
 
-  for (auto& iter : tmp_out_result_) {
-    int64_t idx = iter.first;
-    auto& vec_distance = iter.second;
-    if (!search_param_.enable_range_search && search_param_.topk > 0 && search_param_.topk < vec_distance.size()) {
-      vec_distance.resize(search_param_.topk);
+void VectorSearchTask::PlanAutoFilter() {
+  FilterPlan plan{FilterType::kQueryPre, search_param_.topk};
+
+  // only langchain expr is estimated, range search has no topk to over-fetch
+  if (!search_param_.langchain_expr_json.empty() && !search_param_.enable_range_search && search_param_.topk > 0) {
+    std::shared_ptr<const ScalarSample> sample;
+    std::shared_ptr<const expression::PreparedFilter> filter;
+    Status s = GetScalarSample(stub, vector_index_, sample);
+    if (s.ok()) {
+      s = vector_index_->GetPreparedFilterCache().Get(search_param_.langchain_expr_json, filter);
     }
 
-    out_result_[idx].vector_datas = std::move(vec_distance);
+    if (s.ok()) {
+      double selectivity = EstimateSelectivity(*sample, filter->GetExpr(), search_param_.langchain_expr_params);
+      plan = PlanFilter(selectivity, search_param_.topk);
+      VLOG(kSdkVlogLevel) << Name() << " selectivity: " << selectivity << " filter_type: "
+                          << static_cast<int>(plan.filter_type) << " top_n: " << plan.top_n;
+    } else if (s.IsNotFound()) {
+      VLOG(kSdkVlogLevel) << Name() << " no scalar sample yet, use pre filter: " << s.ToString();
+    } else {
+      DINGO_LOG(WARNING) << Name() << " estimate filter selectivity fail, use pre filter: " << s.ToString();
+    }
+  }
+
+  auto* parameter = search_request_.mutable_parameter();
+  parameter->set_vector_filter_type(plan.filter_type == FilterType::kQueryPost
+                                        ? pb::common::VectorFilterType::QUERY_POST
+                                        : pb::common::VectorFilterType::QUERY_PRE);
+  parameter->set_top_n(plan.top_n);
+}
+
+bool VectorSearchTask::LateMaterialize() const {
+  if (FLAGS_vector_search_late_materialize_min_regions <= 0) {
+    return false;
+  }
+
+  // client rerank needs vectors of all candidates, range search keeps all candidates
+  if ((!search_param_.with_vector_data && !search_param_.with_scalar_data && !search_param_.with_table_data) ||
+      search_param_.client_rerank || search_param_.enable_range_search || search_param_.topk <= 0) {
+    return false;
   }
+
+  // regions fan out is checked on the cached region ranges, a region lookup miss just keeps the normal search
+  int64_t region_count = 0;
+  for (const auto& part_id : next_part_ids_) {
+    const auto& range = vector_index_->GetPartitionRange(part_id);
+    std::vector<std::shared_ptr<Region>> regions;
+    if (!stub.GetMetaCache()->ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), regions).ok()) {
+      return false;
+    }
+
+    region_count += regions.size();
+    if (region_count >= FLAGS_vector_search_late_materialize_min_regions) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void VectorSearchTask::FetchPayload() {
+  std::set<int64_t> ids;
+  for (const auto& result : out_result_) {
+    for (const auto& vector_data : result.vector_datas) {
+      ids.insert(vector_data.vector_data.id);
+    }
+  }
+
+  if (ids.empty()) {
+    DoAsyncDone(Status::OK());
+    return;
+  }
+
+  query_param_.vector_ids.assign(ids.begin(), ids.end());
+  query_param_.with_vector_data = search_param_.with_vector_data;
+  query_param_.with_scalar_data = search_param_.with_scalar_data;
+  query_param_.selected_keys = search_param_.selected_keys;
+  query_param_.with_table_data = search_param_.with_table_data;
+  query_result_.vectors.clear();
+
+  query_task_ = std::make_unique<VectorBatchQueryTask>(stub, index_id_, query_param_, query_result_);
+  query_task_->AsyncRun([this](auto&& s) { FetchPayloadCallback(std::forward<decltype(s)>(s)); });
+}
+
+void VectorSearchTask::FetchPayloadCallback(const Status& status) {
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << "task: " << Name() << " fetch payload fail: " << status.ToString();
+    DoAsyncDone(status);
+    return;
+  }
+
+  std::unordered_map<int64_t, const VectorWithId*> id_to_vector;
+  id_to_vector.reserve(query_result_.vectors.size());
+  for (const auto& vector : query_result_.vectors) {
+    id_to_vector.emplace(vector.id, &vector);
+  }
+
+  // a vector deleted after search keeps id and distance only
+  for (auto& result : out_result_) {
+    for (auto& vector_data : result.vector_datas) {
+      auto iter = id_to_vector.find(vector_data.vector_data.id);
+      if (iter != id_to_vector.end()) {
+        vector_data.vector_data = *iter->second;
+      }
+    }
+  }
+
+  DoAsyncDone(Status::OK());
+}
+
+int64_t VectorSearchTask::MergeTopK() const {
+  // client rerank need all candidates of regions, it truncates after re-score
+  if (search_param_.enable_range_search || search_param_.client_rerank) {
+    return 0;
+  }
+
+  return search_param_.topk;
+}
+
+bool VectorSearchTask::PruneByVectorIds() const {
+  // negation means search all vectors except vector_ids, which may live in any partition
+  return search_param_.filter_source == FilterSource::kVectorIdFilter && !search_param_.is_negation &&
+         !search_param_.vector_ids.empty();
 }
 
 Status VectorSearchPartTask::Init() {
@@ -181,9 +352,13 @@ Status VectorSearchPartTask::Init() {
 }
 
 void VectorSearchPartTask::DoAsync() {
-  const auto& range = vector_index_->GetPartitionRange(part_id_);
-
-  Status s = stub.GetMetaCache()->ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), regions_);
+  Status s;
+  if (vector_ids_.empty()) {
+    const auto& range = vector_index_->GetPartitionRange(part_id_);
+    s = stub.GetMetaCache()->ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), regions_);
+  } else {
+    s = LookupRegionsByVectorIds();
+  }
   if (!s.ok()) {
     DoAsyncDone(s);
     return;
@@ -203,7 +378,7 @@ void VectorSearchPartTask::DoAsync() {
   for (int i = 0; i < regions_.size(); i++) {
     auto rpc = std::make_unique<VectorSearchRpc>();
     auto region = regions_[i];
-    FillVectorSearchRpcRequest(rpc->MutableRequest(), region);
+    FillVectorSearchRpcRequest(rpc->MutableRequest(), region, search_request_);
     region_id_to_region_index_[region->RegionId()] = i;
     StoreRpcController controller(stub, *rpc, region);
     controllers_.push_back(controller);
@@ -225,13 +400,42 @@ void VectorSearchPartTask::DoAsync() {
 }
 
 void VectorSearchPartTask::FillVectorSearchRpcRequest(pb::index::VectorSearchRequest* request,
-                                                      const std::shared_ptr<Region>& region) {
+                                                      const std::shared_ptr<Region>& region,
+                                                      const pb::index::VectorSearchRequest& search_request) {
+  // copy the encoded parameter and vectors instead of encoding them again for each region
+  request->CopyFrom(search_request);
   FillRpcContext(*request->mutable_context(), region->RegionId(), region->Epoch());
-  *(request->mutable_parameter()) = search_parameter_;
-  for (const auto& vector_id : target_vectors_) {
-    // NOTE* vector_id is useless
-    FillVectorWithIdPB(request->add_vector_with_ids(), vector_id, false);
+
+  auto iter = region_vector_ids_.find(region->RegionId());
+  if (iter != region_vector_ids_.end()) {
+    auto* vector_ids = request->mutable_parameter()->mutable_vector_ids();
+    vector_ids->Reserve(iter->second.size());
+    for (const auto& id : iter->second) {
+      vector_ids->Add(id);
+    }
+  }
+}
+
+Status VectorSearchPartTask::LookupRegionsByVectorIds() {
+  regions_.clear();
+  region_vector_ids_.clear();
+
+  std::vector<std::shared_ptr<Region>> regions;
+  Status s = vector_index_->GetIdRegionMap().Route(*stub.GetMetaCache(), vector_ids_, regions);
+  if (!s.ok()) {
+    return s;
+  }
+
+  for (size_t i = 0; i < vector_ids_.size(); i++) {
+    const auto& region = regions[i];
+    auto& ids = region_vector_ids_[region->RegionId()];
+    if (ids.empty()) {
+      regions_.push_back(region);
+    }
+    ids.push_back(vector_ids_[i]);
   }
+
+  return Status::OK();
 }
 
 void VectorSearchPartTask::VectorSearchRpcCallback(const Status& status, VectorSearchRpc* rpc) {
@@ -259,12 +463,7 @@ void VectorSearchPartTask::VectorSearchRpcCallback(const Status& status, VectorS
 
     {
       std::unique_lock<std::shared_mutex> w(rw_lock_);
-      for (auto i = 0; i < rpc->Response()->batch_results_size(); i++) {
-        for (const auto& distancepb : rpc->Response()->batch_results(i).vector_with_distances()) {
-          VectorWithDistance distance = InternalVectorWithDistance2VectorWithDistance(distancepb);
-          search_result_[i].push_back(std::move(distance));
-        }
-      }
+      CollectSearchResultUnlocked(rpc);
     }
   }
 
@@ -273,6 +472,20 @@ void VectorSearchPartTask::VectorSearchRpcCallback(const Status& status, VectorS
   }
 }
 
+void VectorSearchPartTask::CollectSearchResultUnlocked(VectorSearchRpc* rpc) {
+  for (auto i = 0; i < rpc->Response()->batch_results_size(); i++) {
+    auto& topk = search_result_.try_emplace(i, topk_).first->second;
+    for (const auto& distancepb : rpc->Response()->batch_results(i).vector_with_distances()) {
+      // skip decoding vector data of results which can not enter top-k
+      if (!topk.Accept(distancepb.distance())) {
+        continue;
+      }
+
+      topk.Push(InternalVectorWithDistance2VectorWithDistance(distancepb));
+    }
+  }
+}
+
 void VectorSearchPartTask::CheckNoDataRegion() {
   if (!status_.ok() || nodata_region_ids_.empty()) {
     Done();
@@ -291,20 +504,17 @@ void VectorSearchPartTask::Done() {
 }
 
 void VectorSearchPartTask::SearchByBruteForce() {
-  pb::common::VectorSearchParameter paramer = search_parameter_;
-  paramer.clear_diskann();
-  paramer.set_use_brute_force(true);
+  pb::index::VectorSearchRequest brute_force_request = search_request_;
+  auto* paramer = brute_force_request.mutable_parameter();
+  paramer->clear_diskann();
+  paramer->set_use_brute_force(true);
 
   for (auto region_id : nodata_region_ids_) {
     auto rpc = std::make_unique<VectorSearchRpc>();
     CHECK(region_id_to_region_index_.find(region_id) != region_id_to_region_index_.end());
     auto region_index = region_id_to_region_index_[region_id];
     auto region = regions_[region_index];
-    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
-    *(rpc->MutableRequest()->mutable_parameter()) = paramer;
-    for (const auto& vector_id : target_vectors_) {
-      FillVectorWithIdPB(rpc->MutableRequest()->add_vector_with_ids(), vector_id, false);
-    }
+    FillVectorSearchRpcRequest(rpc->MutableRequest(), region, brute_force_request);
     StoreRpcController controller(stub, *rpc, region);
     nodata_controllers_.push_back(controller);
     nodata_rpcs_.push_back(std::move(rpc));
@@ -341,12 +551,7 @@ void VectorSearchPartTask::NodataRegionRpcCallback(const Status& status, VectorS
 
     {
       std::unique_lock<std::shared_mutex> w(rw_lock_);
-      for (auto i = 0; i < rpc->Response()->batch_results_size(); i++) {
-        for (const auto& distancepb : rpc->Response()->batch_results(i).vector_with_distances()) {
-          VectorWithDistance distance = InternalVectorWithDistance2VectorWithDistance(distancepb);
-          search_result_[i].push_back(std::move(distance));
-        }
-      }
+      CollectSearchResultUnlocked(rpc);
     }
   }
 
@@ -24,8 +24,11 @@
 #include "sdk/client_stub.h"
 #include "sdk/rpc/index_service_rpc.h"
 #include "sdk/rpc/store_rpc_controller.h"
+#include "sdk/vector/vector_batch_query_task.h"
 #include "sdk/vector/vector_index.h"
+#include "sdk/vector/vector_rows.h"
 #include "sdk/vector/vector_task.h"
+#include "sdk/vector/vector_topk.h"
 
 namespace dingodb {
 namespace sdk {
@@ -41,8 +44,28 @@ class VectorSearchTask : public VectorTask {
         target_vectors_(target_vectors),
         out_result_(out_result) {}
 
+  VectorSearchTask(const ClientStub& stub, int64_t index_id, const SearchParam& search_param,
+                   const VectorBatch& target_batch, std::vector<SearchResult>& out_result)
+      : VectorTask(stub),
+        index_id_(index_id),
+        search_param_(search_param),
+        target_vectors_(target_batch),
+        out_result_(out_result) {}
+
+  VectorSearchTask(const ClientStub& stub, int64_t index_id, const SearchParam& search_param,
+                   const VectorRows& target_vectors, std::vector<SearchResult>& out_result)
+      : VectorTask(stub),
+        index_id_(index_id),
+        search_param_(search_param),
+        target_vectors_(target_vectors),
+        out_result_(out_result) {}
+
   ~VectorSearchTask() override = default;
 
+  // encode parameter and target vectors of search, shared by the request of every region
+  static Status BuildSearchRequest(const VectorIndex& vector_index, const SearchParam& search_param,
+                                   const VectorRows& target_vectors, pb::index::VectorSearchRequest& search_request);
+
  private:
   Status Init() override;
   void DoAsync() override;
@@ -53,39 +76,66 @@ class VectorSearchTask : public VectorTask {
 
   void ConstructResultUnlocked();
 
+  // choose filter type and top_n sent to regions for FilterType::kQueryAuto
+  void PlanAutoFilter();
+
+  // whether regions return only ids and distances, and payload of the merged top-k is fetched by batch query
+  bool LateMaterialize() const;
+
+  void FetchPayload();
+
+  void FetchPayloadCallback(const Status& status);
+
+  // top-k kept when merge region results, 0 means keep all
+  int64_t MergeTopK() const;
+
+  // id filter search only need the partitions which own the vector_ids
+  bool PruneByVectorIds() const;
+
   const int64_t index_id_;
   const SearchParam& search_param_;
-  const std::vector<VectorWithId>& target_vectors_;
-  pb::common::VectorSearchParameter search_parameter_;
+  const VectorRows target_vectors_;
+  // parameter and target vectors encoded once, shared by the request of every region
+  pb::index::VectorSearchRequest search_request_;
 
   // target_vectors_ idx to search result
-  std::unordered_map<int64_t, std::vector<VectorWithDistance>> tmp_out_result_;
+  std::unordered_map<int64_t, VectorTopK> tmp_out_result_;
 
   std::vector<SearchResult>& out_result_;
 
   std::shared_ptr<VectorIndex> vector_index_;
 
+  // part id to the filter vector_ids it owns, only set when PruneByVectorIds()
+  std::unordered_map<int64_t, std::vector<int64_t>> part_vector_ids_;
+
   std::shared_mutex rw_lock_;
   std::set<int64_t> next_part_ids_;
   Status status_;
 
+  bool late_materialize_{false};
+  QueryParam query_param_;
+  QueryResult query_result_;
+  std::unique_ptr<VectorBatchQueryTask> query_task_;
+
   std::atomic<int> sub_tasks_count_{0};
 };
 
 class VectorSearchPartTask : public VectorTask {
  public:
+  // when vector_ids is not empty, only search the regions which own them and each region is sent its own ids
   VectorSearchPartTask(const ClientStub& stub, int64_t index_id, int64_t part_id,
-                       const pb::common::VectorSearchParameter& search_param,
-                       const std::vector<VectorWithId>& target_vectors)
+                       const pb::index::VectorSearchRequest& search_request, int64_t topk,
+                       std::vector<int64_t> vector_ids = {})
       : VectorTask(stub),
         index_id_(index_id),
         part_id_(part_id),
-        search_parameter_(search_param),
-        target_vectors_(target_vectors) {}
+        search_request_(search_request),
+        topk_(topk),
+        vector_ids_(std::move(vector_ids)) {}
 
   ~VectorSearchPartTask() override = default;
 
-  std::unordered_map<int64_t, std::vector<VectorWithDistance>>& GetSearchResult() {
+  std::unordered_map<int64_t, VectorTopK>& GetSearchResult() {
     std::shared_lock<std::shared_mutex> r(rw_lock_);
     return search_result_;
   }
@@ -98,7 +148,8 @@ class VectorSearchPartTask : public VectorTask {
 
   std::string Name() const override { return fmt::format("VectorSearchPartTask-{}-{}", index_id_, part_id_); }
 
-  void FillVectorSearchRpcRequest(pb::index::VectorSearchRequest* request, const std::shared_ptr<Region>& region);
+  void FillVectorSearchRpcRequest(pb::index::VectorSearchRequest* request, const std::shared_ptr<Region>& region,
+                                  const pb::index::VectorSearchRequest& search_request);
 
   void VectorSearchRpcCallback(const Status& status, VectorSearchRpc* rpc);
 
@@ -110,10 +161,15 @@ class VectorSearchPartTask : public VectorTask {
 
   void NodataRegionRpcCallback(const Status& status, VectorSearchRpc* rpc);
 
+  void CollectSearchResultUnlocked(VectorSearchRpc* rpc);
+
+  Status LookupRegionsByVectorIds();
+
   const int64_t index_id_;
   const int64_t part_id_;
-  const pb::common::VectorSearchParameter& search_parameter_;
-  const std::vector<VectorWithId>& target_vectors_;
+  const pb::index::VectorSearchRequest& search_request_;
+  const int64_t topk_;
+  const std::vector<int64_t> vector_ids_;
 
   std::shared_ptr<VectorIndex> vector_index_;
 
@@ -129,8 +185,10 @@ class VectorSearchPartTask : public VectorTask {
   Status status_;
   std::vector<std::shared_ptr<Region>> regions_;
   std::unordered_map<int64_t, int32_t> region_id_to_region_index_;
-  // target_vectors_ idx to search result
-  std::unordered_map<int64_t, std::vector<VectorWithDistance>> search_result_;
+  // region id to the filter vector_ids it owns, only set when vector_ids_ is not empty
+  std::unordered_map<int64_t, std::vector<int64_t>> region_vector_ids_;
+  // target_vectors_ idx to top-k search result of this partition
+  std::unordered_map<int64_t, VectorTopK> search_result_;
 
   std::atomic<int> nodata_tasks_count_{0};
   std::atomic<int> sub_tasks_count_{0};
@@ -0,0 +1,291 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sdk/vector/vector_stream_search_task.h"
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
+#include "common/logging.h"
+#include "dingosdk/status.h"
+#include "glog/logging.h"
+#include "sdk/common/common.h"
+#include "sdk/vector/vector_common.h"
+#include "sdk/vector/vector_distance.h"
+#include "sdk/vector/vector_search_task.h"
+
+namespace dingodb {
+namespace sdk {
+
+Status VectorStreamSearchTask::Init() {
+  if (target_vectors_.Empty()) {
+    return Status::InvalidArgument("target_vectors is empty");
+  }
+
+  if (search_param_.client_rerank && !search_param_.with_vector_data) {
+    return Status::InvalidArgument("client_rerank need with_vector_data");
+  }
+
+  if (option_.quorum_ratio <= 0 || option_.quorum_ratio > 1) {
+    return Status::InvalidArgument(fmt::format("quorum_ratio must be in (0, 1], but is {}", option_.quorum_ratio));
+  }
+
+  if (option_.deadline_ms < 0) {
+    return Status::InvalidArgument("deadline_ms must not be negative");
+  }
+
+  std::shared_ptr<VectorIndex> tmp;
+  DINGO_RETURN_NOT_OK(stub.GetVectorIndexCache()->GetVectorIndexById(index_id_, tmp));
+  DCHECK_NOTNULL(tmp);
+  vector_index_ = std::move(tmp);
+
+  return VectorSearchTask::BuildSearchRequest(*vector_index_, search_param_, target_vectors_, search_request_);
+}
+
+void VectorStreamSearchTask::DoAsync() {
+  std::vector<std::shared_ptr<Region>> regions;
+  for (const auto& part_id : vector_index_->GetPartitionIds()) {
+    const auto& range = vector_index_->GetPartitionRange(part_id);
+
+    std::vector<std::shared_ptr<Region>> part_regions;
+    Status s = stub.GetMetaCache()->ScanRegionsBetweenContinuousRange(range.start_key(), range.end_key(), part_regions);
+    if (!s.ok()) {
+      DoAsyncDone(s);
+      return;
+    }
+    regions.insert(regions.end(), part_regions.begin(), part_regions.end());
+  }
+
+  auto state = std::make_shared<State>();
+  state->task = this;
+  state->region_callback = option_.region_callback;
+  state->region_count = regions.size();
+  state->quorum = static_cast<int64_t>(std::ceil(option_.quorum_ratio * regions.size()));
+  // client rerank need all candidates of regions, it truncates after re-score
+  state->topk = (search_param_.enable_range_search || search_param_.client_rerank) ? 0 : search_param_.topk;
+
+  if (regions.empty()) {
+    Complete(state, false);
+    return;
+  }
+
+  std::vector<std::unique_ptr<VectorSearchRpc>> rpcs;
+  for (const auto& region : regions) {
+    state->pending_region_ids.insert(region->RegionId());
+
+    auto rpc = std::make_unique<VectorSearchRpc>();
+    rpc->MutableRequest()->CopyFrom(search_request_);
+    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region->RegionId(), region->Epoch());
+    rpcs.push_back(std::move(rpc));
+  }
+
+  // the task may complete while sending, so only use locals from here
+  const ClientStub& stub_ref = stub;
+  if (option_.deadline_ms > 0) {
+    stub_ref.GetActuator()->Schedule([state] { OnDeadline(state); }, option_.deadline_ms);
+  }
+
+  for (int64_t i = 0; i < regions.size(); i++) {
+    SendRpc(stub_ref, state, std::move(rpcs[i]), regions[i]);
+  }
+}
+
+void VectorStreamSearchTask::SendRpc(const ClientStub& stub, const std::shared_ptr<State>& state,
+                                     std::unique_ptr<VectorSearchRpc> rpc, const std::shared_ptr<Region>& region) {
+  VectorSearchRpc* rpc_ptr = rpc.get();
+  StoreRpcController* controller = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(state->mutex);
+    state->controllers.push_back(std::make_unique<StoreRpcController>(stub, *rpc, region));
+    controller = state->controllers.back().get();
+    state->rpcs.push_back(std::move(rpc));
+  }
+
+  controller->AsyncCall([&stub, state, rpc_ptr, region](auto&& s) {
+    RegionRpcCallback(stub, state, std::forward<decltype(s)>(s), rpc_ptr, region);
+  });
+}
+
+void VectorStreamSearchTask::RegionRpcCallback(const ClientStub& stub, const std::shared_ptr<State>& state,
+                                               const Status& status, VectorSearchRpc* rpc,
+                                               const std::shared_ptr<Region>& region) {
+  int64_t region_id = rpc->Request()->context().region_id();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  if (state->task == nullptr) {
+    // task already completed without this region
+    return;
+  }
+
+  if (!status.ok()) {
+    DINGO_LOG(WARNING) << "rpc: " << rpc->Method() << " send to region: " << region_id
+                       << " fail: " << status.ToString();
+
+    if (pb::error::Errno::EDISKANN_IS_NO_DATA == status.Errno() && !rpc->Request()->parameter().use_brute_force()) {
+      auto brute_force_rpc = std::make_unique<VectorSearchRpc>();
+      brute_force_rpc->MutableRequest()->CopyFrom(*rpc->Request());
+      auto* parameter = brute_force_rpc->MutableRequest()->mutable_parameter();
+      parameter->clear_diskann();
+      parameter->set_use_brute_force(true);
+
+      lock.unlock();
+      SendRpc(stub, state, std::move(brute_force_rpc), region);
+      return;
+    }
+
+    state->fail_count++;
+    state->failed_region_ids.push_back(region_id);
+    if (state->first_fail_status.ok()) {
+      state->first_fail_status = status;
+    }
+  } else {
+    lock.unlock();
+
+    std::vector<SearchResult> region_results;
+    region_results.resize(rpc->Response()->batch_results_size());
+    for (auto i = 0; i < rpc->Response()->batch_results_size(); i++) {
+      for (const auto& distancepb : rpc->Response()->batch_results(i).vector_with_distances()) {
+        region_results[i].vector_datas.push_back(InternalVectorWithDistance2VectorWithDistance(distancepb));
+      }
+    }
+
+    if (state->region_callback) {
+      RunRegionCallback(*state, region_id, region_results);
+    }
+
+    lock.lock();
+    if (state->task == nullptr) {
+      // completed by deadline or quorum while decoding or in callback
+      return;
+    }
+
+    for (int64_t i = 0; i < region_results.size(); i++) {
+      auto& topk = state->merged.try_emplace(i, state->topk).first->second;
+      for (auto& vector_with_distance : region_results[i].vector_datas) {
+        if (topk.Accept(vector_with_distance.distance)) {
+          topk.Push(std::move(vector_with_distance));
+        }
+      }
+    }
+
+    state->success_count++;
+  }
+
+  state->pending_region_ids.erase(region_id);
+
+  VectorStreamSearchTask* task = CheckCompleteUnlocked(*state);
+  lock.unlock();
+
+  if (task != nullptr) {
+    task->Complete(state, false);
+  }
+}
+
+void VectorStreamSearchTask::RunRegionCallback(State& state, int64_t region_id,
+                                               const std::vector<SearchResult>& region_results) {
+  {
+    std::lock_guard<std::mutex> guard(state.mutex);
+    if (state.task == nullptr) {
+      return;
+    }
+    state.running_callbacks++;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(state.callback_mutex);
+    state.region_callback(region_id, region_results);
+  }
+
+  std::lock_guard<std::mutex> guard(state.mutex);
+  state.running_callbacks--;
+  state.callbacks_done.notify_all();
+}
+
+void VectorStreamSearchTask::OnDeadline(const std::shared_ptr<State>& state) {
+  VectorStreamSearchTask* task = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(state->mutex);
+    task = state->task;
+    state->task = nullptr;
+  }
+
+  if (task != nullptr) {
+    task->Complete(state, true);
+  }
+}
+
+VectorStreamSearchTask* VectorStreamSearchTask::CheckCompleteUnlocked(State& state) {
+  // quorum can not be reached anymore when too many regions failed
+  bool complete = state.success_count >= state.quorum || state.pending_region_ids.empty() ||
+                  state.fail_count > state.region_count - state.quorum;
+  if (!complete) {
+    return nullptr;
+  }
+
+  VectorStreamSearchTask* task = state.task;
+  state.task = nullptr;
+  return task;
+}
+
+void VectorStreamSearchTask::Complete(const std::shared_ptr<State>& state, bool deadline) {
+  Status status;
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->task = nullptr;
+    // no callback starts once task is reset, wait for the running ones before the caller is released
+    state->callbacks_done.wait(lock, [&state] { return state->running_callbacks == 0; });
+
+    out_result_.region_count = state->region_count;
+    out_result_.skipped_region_ids.assign(state->pending_region_ids.begin(), state->pending_region_ids.end());
+    out_result_.skipped_region_ids.insert(out_result_.skipped_region_ids.end(), state->failed_region_ids.begin(),
+                                          state->failed_region_ids.end());
+
+    out_result_.results.clear();
+    for (int64_t i = 0; i < target_vectors_.Size(); i++) {
+      SearchResult search(VectorWithId(target_vectors_.GetVector(i)));
+
+      auto iter = state->merged.find(i);
+      if (iter != state->merged.end()) {
+        search.vector_datas = iter->second.Finish();
+      }
+
+      if (search_param_.client_rerank) {
+        Status s = vector_distance::Rerank(search.id.vector, search.vector_datas);
+        if (!s.ok()) {
+          DINGO_LOG(WARNING) << Name() << " rerank fail, keep distances of server: " << s.ToString();
+        }
+        if (!search_param_.enable_range_search && search_param_.topk > 0 &&
+            search_param_.topk < search.vector_datas.size()) {
+          search.vector_datas.resize(search_param_.topk);
+        }
+      }
+
+      out_result_.results.push_back(std::move(search));
+    }
+
+    if (state->success_count >= state->quorum || (deadline && state->success_count > 0)) {
+      status = Status::OK();
+    } else if (!state->first_fail_status.ok()) {
+      status = state->first_fail_status;
+    } else {
+      status = Status::TimedOut(fmt::format("no region responded in {} ms", option_.deadline_ms));
+    }
+  }
+
+  DoAsyncDone(status);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
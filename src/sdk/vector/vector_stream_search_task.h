@@ -0,0 +1,123 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DINGODB_SDK_VECTOR_STREAM_SEARCH_TASK_H_
+#define DINGODB_SDK_VECTOR_STREAM_SEARCH_TASK_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "dingosdk/vector.h"
+#include "fmt/core.h"
+#include "sdk/client_stub.h"
+#include "sdk/rpc/index_service_rpc.h"
+#include "sdk/rpc/store_rpc_controller.h"
+#include "sdk/vector/vector_index.h"
+#include "sdk/vector/vector_rows.h"
+#include "sdk/vector/vector_task.h"
+#include "sdk/vector/vector_topk.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Search every region of the index directly and merge region results as they arrive. Each region result is handed
+// to StreamSearchOption::region_callback, and the task may complete once a quorum of regions responded or the
+// deadline passed, the regions not waited for are reported in StreamSearchResult::skipped_region_ids.
+class VectorStreamSearchTask : public VectorTask {
+ public:
+  VectorStreamSearchTask(const ClientStub& stub, int64_t index_id, const SearchParam& search_param,
+                         const std::vector<VectorWithId>& target_vectors, const StreamSearchOption& option,
+                         StreamSearchResult& out_result)
+      : VectorTask(stub),
+        index_id_(index_id),
+        search_param_(search_param),
+        target_vectors_(target_vectors),
+        option_(option),
+        out_result_(out_result) {}
+
+  ~VectorStreamSearchTask() override = default;
+
+ private:
+  // shared with rpc callbacks, because rpcs of skipped regions still run after the task completed
+  struct State {
+    std::mutex mutex;
+    // reset when the task completes, callbacks after that only release their rpc
+    VectorStreamSearchTask* task{nullptr};
+
+    // user callback runs without mutex so a slow one does not block other regions and the deadline, calls are
+    // serialized by callback_mutex and the task completes only after running ones returned
+    RegionSearchCallback region_callback;
+    std::mutex callback_mutex;
+    int64_t running_callbacks{0};
+    std::condition_variable callbacks_done;
+
+    std::vector<std::unique_ptr<VectorSearchRpc>> rpcs;
+    std::vector<std::unique_ptr<StoreRpcController>> controllers;
+
+    int64_t region_count{0};
+    int64_t quorum{0};
+    int64_t success_count{0};
+    int64_t fail_count{0};
+    std::set<int64_t> pending_region_ids;
+    std::vector<int64_t> failed_region_ids;
+    Status first_fail_status;
+
+    int64_t topk{0};
+    // target_vectors_ idx to merged top-k of responded regions
+    std::unordered_map<int64_t, VectorTopK> merged;
+  };
+
+  Status Init() override;
+  void DoAsync() override;
+
+  // regions are retried by StoreRpcController, the ones still failed are reported as skipped
+  bool NeedRetry() override { return false; }
+
+  std::string Name() const override { return fmt::format("VectorStreamSearchTask-{}", index_id_); }
+
+  static void SendRpc(const ClientStub& stub, const std::shared_ptr<State>& state,
+                      std::unique_ptr<VectorSearchRpc> rpc, const std::shared_ptr<Region>& region);
+
+  static void RegionRpcCallback(const ClientStub& stub, const std::shared_ptr<State>& state, const Status& status,
+                                VectorSearchRpc* rpc, const std::shared_ptr<Region>& region);
+
+  // call region_callback out of state mutex, skipped when the task already completed
+  static void RunRegionCallback(State& state, int64_t region_id, const std::vector<SearchResult>& region_results);
+
+  static void OnDeadline(const std::shared_ptr<State>& state);
+
+  // return the task to complete when the state reaches quorum or no region left, nullptr otherwise
+  static VectorStreamSearchTask* CheckCompleteUnlocked(State& state);
+
+  void Complete(const std::shared_ptr<State>& state, bool deadline);
+
+  const int64_t index_id_;
+  const SearchParam& search_param_;
+  const VectorRows target_vectors_;
+  const StreamSearchOption& option_;
+  StreamSearchResult& out_result_;
+
+  std::shared_ptr<VectorIndex> vector_index_;
+  pb::index::VectorSearchRequest search_request_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_VECTOR_STREAM_SEARCH_TASK_H_
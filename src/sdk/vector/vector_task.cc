@@ -66,24 +66,38 @@ void VectorTask::FailOrRetry() {
   }
 }
 
+bool VectorTask::IsRetryError(const Status& status) {
+  if (!status.IsIncomplete()) {
+    return false;
+  }
+
+  auto error_code = status.Errno();
+  return error_code == pb::error::EREGION_VERSION || error_code == pb::error::EREGION_NOT_FOUND ||
+         error_code == pb::error::EKEY_OUT_OF_RANGE || error_code == pb::error::EVECTOR_INDEX_NOT_READY ||
+         error_code == pb::error::ERAFT_NOT_FOUND;
+}
+
+Status VectorTask::RegionLookupStatus(const Status& status) {
+  if (status.IsNotFound()) {
+    return Status::Incomplete(pb::error::EREGION_NOT_FOUND, status.ToString());
+  }
+  return status;
+}
+
 bool VectorTask::NeedRetry() {
-  if (status_.IsIncomplete()) {
+  if (IsRetryError(status_)) {
     auto error_code = status_.Errno();
-    if (error_code == pb::error::EREGION_VERSION || error_code == pb::error::EREGION_NOT_FOUND ||
-        error_code == pb::error::EKEY_OUT_OF_RANGE || error_code == pb::error::EVECTOR_INDEX_NOT_READY ||
-        error_code == pb::error::ERAFT_NOT_FOUND) {
-      retry_count_++;
-      if (retry_count_ < FLAGS_vector_op_max_retry) {
-        std::string msg = fmt::format("Task:{} will retry, reason:{}, retry_count_:{}, max_retry:{}", Name(),
-                                      pb::error::Errno_Name(error_code), retry_count_, FLAGS_vector_op_max_retry);
-        DINGO_LOG(INFO) << msg;
-        return true;
-      } else {
-        std::string msg =
-            fmt::format("Fail task:{} retry too times:{}, last err:{}", Name(), retry_count_, status_.ToString());
-        status_ = Status::Aborted(status_.Errno(), msg);
-        DINGO_LOG(INFO) << msg;
-      }
+    retry_count_++;
+    if (retry_count_ < FLAGS_vector_op_max_retry) {
+      std::string msg = fmt::format("Task:{} will retry, reason:{}, retry_count_:{}, max_retry:{}", Name(),
+                                    pb::error::Errno_Name(error_code), retry_count_, FLAGS_vector_op_max_retry);
+      DINGO_LOG(INFO) << msg;
+      return true;
+    } else {
+      std::string msg =
+          fmt::format("Fail task:{} retry too times:{}, last err:{}", Name(), retry_count_, status_.ToString());
+      status_ = Status::Aborted(status_.Errno(), msg);
+      DINGO_LOG(INFO) << msg;
     }
   }
 
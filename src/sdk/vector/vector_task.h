@@ -31,6 +31,12 @@ class VectorTask {
   Status Run();
   void AsyncRun(StatusCallback cb);
 
+  // error fixed by re-route and resend the affected items, the task retry only the items still pending
+  static bool IsRetryError(const Status& status);
+
+  // status of an item whose region lookup failed, only a missing region is fixed by retry
+  static Status RegionLookupStatus(const Status& status);
+
  protected:
   virtual Status Init();
   virtual void PostProcess();
@@ -0,0 +1,83 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "sdk/vector/vector_topk.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace dingodb {
+namespace sdk {
+
+namespace {
+
+struct BetterThan {
+  bool operator()(const VectorWithDistance& a, const VectorWithDistance& b) const { return a.distance < b.distance; }
+};
+
+}  // namespace
+
+bool VectorTopK::Accept(float distance) const {
+  if (!Bounded() || Size() < topk_) {
+    return true;
+  }
+
+  return distance < heap_.front().distance;
+}
+
+void VectorTopK::Push(VectorWithDistance&& result) {
+  if (!Bounded()) {
+    heap_.push_back(std::move(result));
+    return;
+  }
+
+  BetterThan better;
+  if (Size() < topk_) {
+    heap_.push_back(std::move(result));
+    std::push_heap(heap_.begin(), heap_.end(), better);
+  } else if (better(result, heap_.front())) {
+    std::pop_heap(heap_.begin(), heap_.end(), better);
+    heap_.back() = std::move(result);
+    std::push_heap(heap_.begin(), heap_.end(), better);
+  }
+}
+
+void VectorTopK::Merge(VectorTopK&& other) {
+  if (heap_.empty() && topk_ == other.topk_) {
+    heap_.swap(other.heap_);
+    return;
+  }
+
+  for (auto& result : other.heap_) {
+    Push(std::move(result));
+  }
+  other.heap_.clear();
+}
+
+std::vector<VectorWithDistance> VectorTopK::Finish() {
+  BetterThan better;
+  if (Bounded()) {
+    std::sort_heap(heap_.begin(), heap_.end(), better);
+  } else {
+    std::sort(heap_.begin(), heap_.end(), better);
+  }
+
+  std::vector<VectorWithDistance> results;
+  results.swap(heap_);
+  return results;
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,59 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DINGODB_SDK_VECTOR_TOPK_H_
+#define DINGODB_SDK_VECTOR_TOPK_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "dingosdk/vector.h"
+
+namespace dingodb {
+namespace sdk {
+
+// Bounded best-k collector of one query, results of regions and partitions are pushed as they arrive so only the
+// survivors are kept and moved. Store reports every metric as a distance, inner product and cosine included,
+// so smaller is better for all of them. topk <= 0 keeps all results, used by range search.
+class VectorTopK {
+ public:
+  explicit VectorTopK(int64_t topk = 0) : topk_(topk) {}
+
+  ~VectorTopK() = default;
+
+  // whether a result with this distance will be kept, check it before decode a result to skip the losers
+  bool Accept(float distance) const;
+
+  void Push(VectorWithDistance&& result);
+
+  void Merge(VectorTopK&& other);
+
+  int64_t Size() const { return heap_.size(); }
+
+  // return kept results sorted from best to worst, the collector is empty after
+  std::vector<VectorWithDistance> Finish();
+
+ private:
+  bool Bounded() const { return topk_ > 0; }
+
+  int64_t topk_;
+  // when bounded it is a heap with the worst kept result on top
+  std::vector<VectorWithDistance> heap_;
+};
+
+}  // namespace sdk
+}  // namespace dingodb
+
+#endif  // DINGODB_SDK_VECTOR_TOPK_H_
@@ -14,12 +14,14 @@
 
 #include "sdk/vector/vector_upsert_task.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <unordered_map>
 
 #include "glog/logging.h"
 #include "sdk/auto_increment_manager.h"
 #include "sdk/common/common.h"
+#include "sdk/common/param_config.h"
 #include "dingosdk/status.h"
 #include "sdk/vector/vector_common.h"
 #include "sdk/vector/vector_helper.h"
@@ -29,17 +31,19 @@ namespace dingodb {
 namespace sdk {
 
 Status VectorUpsertTask::Init() {
-  if (vectors_.empty()) {
+  if (vectors_.Empty()) {
     return Status::InvalidArgument("vectors is empty, no need update vector");
   }
 
+  DINGO_RETURN_NOT_OK(vectors_.Check());
+
   std::shared_ptr<VectorIndex> tmp;
   DINGO_RETURN_NOT_OK(stub.GetVectorIndexCache()->GetVectorIndexById(index_id_, tmp));
   DCHECK_NOTNULL(tmp);
   vector_index_ = std::move(tmp);
 
-  for (const auto &vector : vectors_) {
-    int64_t id = vector.id;
+  for (int64_t i = 0; i < vectors_.Size(); i++) {
+    int64_t id = vectors_.GetId(i);
     if (id <= 0) {
       return Status::InvalidArgument("vector id must be positive");
     }
@@ -48,8 +52,8 @@ Status VectorUpsertTask::Init() {
   std::unique_lock<std::shared_mutex> w(rw_lock_);
   vector_id_to_idx_.clear();
 
-  for (int64_t i = 0; i < vectors_.size(); i++) {
-    int64_t id = vectors_[i].id;
+  for (int64_t i = 0; i < vectors_.Size(); i++) {
+    int64_t id = vectors_.GetId(i);
     if (!vector_id_to_idx_.insert(std::make_pair(id, i)).second) {
       return Status::InvalidArgument("duplicate vector id: " + std::to_string(id));
     }
@@ -76,21 +80,43 @@ void VectorUpsertTask::DoAsync() {
 
   auto meta_cache = stub.GetMetaCache();
 
-  for (const auto &[id, idx] : next_batch) {
-    std::shared_ptr<Region> tmp;
-    Status s = meta_cache->LookupRegionByKey(vector_helper::VectorIdToRangeKey(*vector_index_, id), tmp);
-    if (!s.ok()) {
-      // TODO: continue
-      DoAsyncDone(s);
-      return;
-    };
-
-    auto iter = region_id_to_region.find(tmp->RegionId());
-    if (iter == region_id_to_region.end()) {
-      region_id_to_region.emplace(std::make_pair(tmp->RegionId(), tmp));
+  // sorted ids are routed by the id intervals of the index, meta cache is only asked for uncached ranges
+  std::vector<int64_t> ids;
+  ids.reserve(next_batch.size());
+  for (const auto& [id, idx] : next_batch) {
+    ids.push_back(id);
+  }
+  std::sort(ids.begin(), ids.end());
+
+  std::vector<std::shared_ptr<Region>> regions;
+  Status s = vector_index_->GetIdRegionMap().Route(*meta_cache, ids, regions);
+
+  for (size_t i = 0; i < ids.size(); i++) {
+    int64_t id = ids[i];
+    const auto& region = regions[i];
+    if (region == nullptr) {
+      // keep the id pending and route the others, it is resent in next round
+      DINGO_LOG(WARNING) << "lookup region fail, id: " << id << ", status: " << s.ToString();
+      Status lookup_status = RegionLookupStatus(s);
+      std::unique_lock<std::shared_mutex> w(rw_lock_);
+      if (status_.ok() || (IsRetryError(status_) && !IsRetryError(lookup_status))) {
+        status_ = lookup_status;
+      }
+      continue;
     }
 
-    region_vectors_to_ids[tmp->RegionId()].push_back(id);
+    region_id_to_region.try_emplace(region->RegionId(), region);
+    region_vectors_to_ids[region->RegionId()].push_back(id);
+  }
+
+  if (region_vectors_to_ids.empty()) {
+    Status tmp;
+    {
+      std::shared_lock<std::shared_mutex> r(rw_lock_);
+      tmp = status_;
+    }
+    DoAsyncDone(tmp);
+    return;
   }
 
   controllers_.clear();
@@ -103,32 +129,38 @@ void VectorUpsertTask::DoAsync() {
     CHECK(iter != region_id_to_region.end());
     auto region = iter->second;
 
-    auto rpc = std::make_unique<VectorAddRpc>();
-    FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
-    rpc->MutableRequest()->set_is_update(true);
-
+    // split items of one region into multiple rpc bounded by count and bytes
+    RpcChunker chunker(FLAGS_index_rpc_max_batch_count, FLAGS_index_rpc_max_batch_bytes);
+    std::unique_ptr<VectorAddRpc> rpc;
     for (const auto &id : entry.second) {
+      if (rpc == nullptr) {
+        rpc = std::make_unique<VectorAddRpc>();
+        FillRpcContext(*rpc->MutableRequest()->mutable_context(), region_id, region->Epoch());
+        rpc->MutableRequest()->set_is_update(true);
+      }
+
       int64_t idx = vector_id_to_idx_[id];
-      FillVectorWithIdPB(rpc->MutableRequest()->add_vectors(), vectors_[idx]);
-    }
+      auto *vector_pb = rpc->MutableRequest()->add_vectors();
+      vectors_.FillVectorWithIdPB(vector_pb, idx);
 
-    StoreRpcController controller(stub, *rpc, region);
-    controllers_.push_back(controller);
+      if (chunker.Add(vector_pb->ByteSizeLong())) {
+        controllers_.emplace_back(stub, *rpc, region);
+        rpcs_.push_back(std::move(rpc));
+      }
+    }
 
-    rpcs_.push_back(std::move(rpc));
+    if (rpc != nullptr) {
+      controllers_.emplace_back(stub, *rpc, region);
+      rpcs_.push_back(std::move(rpc));
+    }
   }
 
-  DCHECK_EQ(rpcs_.size(), region_vectors_to_ids.size());
   DCHECK_EQ(rpcs_.size(), controllers_.size());
 
-  sub_tasks_count_.store(region_vectors_to_ids.size());
-
-  for (auto i = 0; i < region_vectors_to_ids.size(); i++) {
-    auto &controller = controllers_[i];
-
-    controller.AsyncCall(
+  window_.Start(rpcs_.size(), FLAGS_index_rpc_max_in_flight, [this](int64_t i) {
+    controllers_[i].AsyncCall(
         [this, rpc = rpcs_[i].get()](auto &&s) { VectorAddRpcCallback(std::forward<decltype(s)>(s), rpc); });
-  }
+  });
 }
 
 void VectorUpsertTask::VectorAddRpcCallback(const Status &status, VectorAddRpc *rpc) {
@@ -137,8 +169,8 @@ void VectorUpsertTask::VectorAddRpcCallback(const Status &status, VectorAddRpc *
                        << " fail: " << status.ToString();
 
     std::unique_lock<std::shared_mutex> w(rw_lock_);
-    if (status_.ok()) {
-      // only return first fail status
+    if (status_.ok() || (IsRetryError(status_) && !IsRetryError(status))) {
+      // return first fail status, a fatal one wins over errors which only need resend
       status_ = status;
     }
   } else {
@@ -148,7 +180,7 @@ void VectorUpsertTask::VectorAddRpcCallback(const Status &status, VectorAddRpc *
     }
   }
 
-  if (sub_tasks_count_.fetch_sub(1) == 1) {
+  if (window_.Done()) {
     Status tmp;
     {
       std::shared_lock<std::shared_mutex> r(rw_lock_);
@@ -0,0 +1,125 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <vector>
+
+#include "dingosdk/document.h"
+#include "dingosdk/vector.h"
+#include "gtest/gtest.h"
+#include "sdk/document/document_hybrid_fusion.h"
+
+namespace dingodb {
+namespace sdk {
+
+static DocWithStore CreateTextCandidate(int64_t id, float score) {
+  DocWithStore candidate;
+  candidate.doc_with_id.id = id;
+  candidate.score = score;
+  return candidate;
+}
+
+static VectorWithDistance CreateVectorCandidate(int64_t id, float distance, MetricType metric_type) {
+  VectorWithDistance candidate;
+  candidate.vector_data.id = id;
+  candidate.distance = distance;
+  candidate.metric_type = metric_type;
+  return candidate;
+}
+
+static std::vector<int64_t> HitIds(const std::vector<HybridSearchHit>& hits) {
+  std::vector<int64_t> ids;
+  for (const auto& hit : hits) {
+    ids.push_back(hit.id);
+  }
+  return ids;
+}
+
+TEST(SDKDocumentHybridFusionTest, ReciprocalRankFusion) {
+  HybridSearchParam param;
+  param.top_k = 3;
+  param.rrf_k = 60;
+
+  std::vector<DocWithStore> text = {CreateTextCandidate(1, 9.0), CreateTextCandidate(2, 5.0),
+                                    CreateTextCandidate(3, 1.0)};
+  std::vector<VectorWithDistance> vector = {CreateVectorCandidate(3, 0.1, MetricType::kL2),
+                                            CreateVectorCandidate(4, 0.2, MetricType::kL2),
+                                            CreateVectorCandidate(1, 0.3, MetricType::kL2)};
+
+  auto hits = FuseHybridCandidates(param, text, vector);
+  // 1: 1/61 + 1/63, 3: 1/63 + 1/61, equal score ranks the smaller id first
+  EXPECT_EQ(HitIds(hits), std::vector<int64_t>({1, 3, 2}));
+  EXPECT_EQ(hits[0].text_rank, 1);
+  EXPECT_EQ(hits[0].vector_rank, 3);
+  EXPECT_FLOAT_EQ(hits[0].vector_distance, 0.3);
+  EXPECT_EQ(hits[2].vector_rank, 0);
+  EXPECT_DOUBLE_EQ(hits[2].score, 1.0 / 62);
+}
+
+TEST(SDKDocumentHybridFusionTest, Weights) {
+  HybridSearchParam param;
+  param.top_k = 0;
+  param.text_weight = 0.0;
+
+  std::vector<DocWithStore> text = {CreateTextCandidate(1, 9.0)};
+  std::vector<VectorWithDistance> vector = {CreateVectorCandidate(2, 0.1, MetricType::kL2)};
+
+  auto hits = FuseHybridCandidates(param, text, vector);
+  EXPECT_EQ(HitIds(hits), std::vector<int64_t>({2, 1}));
+}
+
+TEST(SDKDocumentHybridFusionTest, WeightedScoreFusion) {
+  HybridSearchParam param;
+  param.fusion_type = kWeightedScoreFusion;
+  param.text_weight = 0.3;
+  param.vector_weight = 0.7;
+
+  std::vector<DocWithStore> text = {CreateTextCandidate(1, 10.0), CreateTextCandidate(2, 0.0)};
+  std::vector<VectorWithDistance> vector = {CreateVectorCandidate(2, 0.1, MetricType::kL2),
+                                            CreateVectorCandidate(1, 0.5, MetricType::kL2)};
+
+  auto hits = FuseHybridCandidates(param, text, vector);
+  EXPECT_EQ(HitIds(hits), std::vector<int64_t>({2, 1}));
+  EXPECT_DOUBLE_EQ(hits[0].score, 0.7);
+  EXPECT_DOUBLE_EQ(hits[1].score, 0.3);
+}
+
+TEST(SDKDocumentHybridFusionTest, InnerProductDistance) {
+  HybridSearchParam param;
+  param.fusion_type = kWeightedScoreFusion;
+  param.text_weight = 0.0;
+
+  // inner product is reported as a distance by store, smaller is nearer like l2
+  std::vector<VectorWithDistance> vector = {CreateVectorCandidate(3, -0.8, MetricType::kInnerProduct),
+                                            CreateVectorCandidate(1, 0.2, MetricType::kInnerProduct),
+                                            CreateVectorCandidate(2, 0.6, MetricType::kInnerProduct)};
+
+  auto hits = FuseHybridCandidates(param, {}, vector);
+  EXPECT_EQ(HitIds(hits), std::vector<int64_t>({3, 1, 2}));
+  EXPECT_DOUBLE_EQ(hits[0].score, 1.0);
+  EXPECT_DOUBLE_EQ(hits[2].score, 0.0);
+}
+
+TEST(SDKDocumentHybridFusionTest, Empty) {
+  HybridSearchParam param;
+  EXPECT_TRUE(FuseHybridCandidates(param, {}, {}).empty());
+
+  std::vector<DocWithStore> text = {CreateTextCandidate(5, 1.0)};
+  auto hits = FuseHybridCandidates(param, text, {});
+  ASSERT_EQ(hits.size(), 1);
+  EXPECT_EQ(hits[0].doc.id, 5);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
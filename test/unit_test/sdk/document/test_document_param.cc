@@ -0,0 +1,80 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <string>
+#include <utility>
+
+#include "dingosdk/document.h"
+#include "dingosdk/types.h"
+#include "gtest/gtest.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKDocValueTest, Values) {
+  EXPECT_EQ(DocValue::FromInt(7).IntValue(), 7);
+  EXPECT_EQ(DocValue::FromDouble(1.5).DoubleValue(), 1.5);
+  EXPECT_TRUE(DocValue::FromBool(true).BoolValue());
+
+  DocValue str = DocValue::FromString("hello");
+  EXPECT_EQ(str.GetType(), Type::kSTRING);
+  EXPECT_EQ(str.StringValue(), "hello");
+
+  DocValue bytes = DocValue::FromBytes(std::string("a\0b", 3));
+  EXPECT_EQ(bytes.GetType(), Type::kBYTES);
+  EXPECT_EQ(bytes.BytesValue().size(), 3);
+
+  DocValue datetime = DocValue::FromDatetime("2024-01-01");
+  EXPECT_EQ(datetime.DatetimeValue(), "2024-01-01");
+
+  // accessor of another type returns the zero value
+  EXPECT_EQ(str.IntValue(), 0);
+  EXPECT_TRUE(DocValue::FromInt(1).StringValue().empty());
+}
+
+TEST(SDKDocValueTest, CopyAndMove) {
+  DocValue a = DocValue::FromString(std::string(100, 'x'));
+  DocValue b = a;
+  EXPECT_EQ(b.StringValue(), a.StringValue());
+
+  DocValue c = std::move(a);
+  EXPECT_EQ(c.StringValue(), std::string(100, 'x'));
+  EXPECT_EQ(c.GetType(), Type::kSTRING);
+}
+
+TEST(SDKDocumentTest, Fields) {
+  Document doc;
+  doc.AddField("title", DocValue::FromString("a"));
+  doc.AddField("count", DocValue::FromInt(3));
+  // existing key is not overwritten
+  doc.AddField("title", DocValue::FromString("b"));
+
+  ASSERT_EQ(doc.Fields().size(), 2);
+  EXPECT_EQ(doc.Fields()[0].first, "title");
+  EXPECT_EQ(doc.Fields()[1].first, "count");
+
+  const DocValue* title = doc.GetField("title");
+  ASSERT_NE(title, nullptr);
+  EXPECT_EQ(title->StringValue(), "a");
+  EXPECT_EQ(doc.GetField("count")->IntValue(), 3);
+  EXPECT_EQ(doc.GetField("missing"), nullptr);
+
+  auto fields = doc.GetFields();
+  EXPECT_EQ(fields.size(), 2);
+  EXPECT_EQ(fields.at("count").IntValue(), 3);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,192 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/document/document_search_all_cursor.h"
+
+namespace dingodb {
+namespace sdk {
+
+using Hit = DocumentSearchAllCursor::Hit;
+
+static std::vector<Hit> CreateHits(const std::vector<std::pair<int64_t, float>>& id_scores) {
+  std::vector<Hit> hits;
+  for (const auto& [id, score] : id_scores) {
+    Hit hit;
+    hit.id = id;
+    hit.score = score;
+    hit.doc = "doc" + std::to_string(id);
+    hits.push_back(std::move(hit));
+  }
+  return hits;
+}
+
+static std::vector<int64_t> HitIds(const std::vector<Hit>& hits) {
+  std::vector<int64_t> ids;
+  for (const auto& hit : hits) {
+    ids.push_back(hit.id);
+  }
+  return ids;
+}
+
+TEST(SDKDocumentSearchAllCursorTest, MergeInScoreOrder) {
+  DocumentSearchAllCursor cursor;
+  cursor.AddRegion(100);
+  cursor.AddRegion(200);
+  EXPECT_EQ(cursor.RegionsToFetch(), std::vector<int64_t>({0, 1}));
+
+  cursor.OnBatch(0, "s0", true, CreateHits({{1, 9.0}, {2, 5.0}}));
+  cursor.OnBatch(1, "s1", true, CreateHits({{3, 8.0}, {4, 7.0}}));
+
+  // region 0 may still send a hit up to 5.0, region 1 up to 7.0
+  std::vector<Hit> hits;
+  cursor.PopReady(10, hits);
+  EXPECT_EQ(HitIds(hits), std::vector<int64_t>({1, 3}));
+  EXPECT_EQ(cursor.BufferSize(), 2);
+
+  // only region 1 can send a hit better than or equal to the buffered 7.0
+  EXPECT_EQ(cursor.RegionsToFetch(), std::vector<int64_t>({1}));
+
+  cursor.OnBatch(1, "s1", false, CreateHits({{5, 6.0}, {6, 1.0}}));
+  hits.clear();
+  cursor.PopReady(10, hits);
+  EXPECT_EQ(HitIds(hits), std::vector<int64_t>({4, 5}));
+
+  EXPECT_EQ(cursor.RegionsToFetch(), std::vector<int64_t>({0}));
+  cursor.OnBatch(0, "", false, CreateHits({{7, 2.0}}));
+  hits.clear();
+  cursor.PopReady(10, hits);
+  EXPECT_EQ(HitIds(hits), std::vector<int64_t>({2, 7, 6}));
+  EXPECT_TRUE(cursor.Finished());
+}
+
+TEST(SDKDocumentSearchAllCursorTest, TieWaitsForRegion) {
+  DocumentSearchAllCursor cursor;
+  cursor.AddRegion(100);
+  cursor.AddRegion(200);
+  cursor.OnBatch(0, "s0", true, CreateHits({{5, 3.0}}));
+  cursor.OnBatch(1, "", false, CreateHits({{9, 4.0}}));
+
+  // region 0 may still send 3.0 with an id smaller than 5
+  std::vector<Hit> hits;
+  cursor.PopReady(10, hits);
+  EXPECT_EQ(HitIds(hits), std::vector<int64_t>({9}));
+  EXPECT_EQ(cursor.RegionsToFetch(), std::vector<int64_t>({0}));
+
+  cursor.OnBatch(0, "", false, CreateHits({{2, 3.0}}));
+  hits.clear();
+  cursor.PopReady(10, hits);
+  EXPECT_EQ(HitIds(hits), std::vector<int64_t>({2, 5}));
+}
+
+TEST(SDKDocumentSearchAllCursorTest, PopLimit) {
+  DocumentSearchAllCursor cursor;
+  cursor.AddRegion(100);
+  cursor.OnBatch(0, "s0", false, CreateHits({{1, 3.0}, {2, 3.0}, {3, 2.0}}));
+
+  std::vector<Hit> hits;
+  cursor.PopReady(2, hits);
+  EXPECT_EQ(HitIds(hits), std::vector<int64_t>({1, 2}));
+  EXPECT_FALSE(cursor.Finished());
+  EXPECT_TRUE(cursor.RegionsToFetch().empty());
+}
+
+TEST(SDKDocumentSearchAllCursorTest, TokenRoundTrip) {
+  DocumentSearchAllCursor cursor;
+  cursor.AddRegion(100);
+  cursor.AddRegion(200);
+  cursor.OnBatch(0, "stream-0", true, CreateHits({{1, 4.0}, {2, 3.0}}));
+  cursor.OnBatch(1, "", false, CreateHits({{3, 1.0}}));
+
+  std::vector<Hit> hits;
+  cursor.PopReady(10, hits);
+  EXPECT_EQ(HitIds(hits), std::vector<int64_t>({1}));
+
+  DocumentSearchAllCursor decoded;
+  EXPECT_TRUE(decoded.DecodeToken(cursor.EncodeToken()).ok());
+
+  // region 100 sends only the returned hit, nothing of it is buffered and its stream goes on
+  decoded.OnBatch(0, "stream-1", true, CreateHits({{1, 4.0}}));
+  decoded.OnBatch(1, "", false, CreateHits({{3, 1.0}}));
+  EXPECT_EQ(decoded.BufferSize(), 1);
+
+  DocumentSearchAllCursor again;
+  EXPECT_TRUE(again.DecodeToken(decoded.EncodeToken()).ok());
+  ASSERT_EQ(again.Regions().size(), 2);
+  EXPECT_EQ(again.Regions()[0].region_id, 100);
+  EXPECT_EQ(again.Regions()[0].stream_id, "stream-1");
+  EXPECT_TRUE(again.Regions()[0].started);
+  EXPECT_FLOAT_EQ(again.Regions()[0].last_score, 4.0);
+  EXPECT_FALSE(again.Regions()[0].done);
+  EXPECT_EQ(again.Regions()[1].region_id, 200);
+  EXPECT_FALSE(again.Regions()[1].started);
+  EXPECT_FALSE(again.Regions()[1].done);
+}
+
+TEST(SDKDocumentSearchAllCursorTest, TokenWithoutBufferedHits) {
+  DocumentSearchAllCursor cursor;
+  cursor.AddRegion(100);
+  cursor.AddRegion(200);
+  cursor.OnBatch(0, "stream-0", true, CreateHits({{1, 4.0}, {2, 3.0}}));
+  cursor.OnBatch(1, "", false, CreateHits({{3, 1.0}}));
+
+  std::vector<Hit> hits;
+  cursor.PopReady(10, hits);
+  EXPECT_EQ(HitIds(hits), std::vector<int64_t>({1}));
+
+  std::string token = cursor.EncodeToken();
+  EXPECT_EQ(token.find_first_not_of("0123456789abcdef"), std::string::npos);
+
+  DocumentSearchAllCursor decoded;
+  EXPECT_TRUE(decoded.DecodeToken(token).ok());
+  ASSERT_EQ(decoded.Regions().size(), 2);
+  EXPECT_EQ(decoded.BufferSize(), 0);
+
+  // regions with buffered hits open a new stream
+  EXPECT_EQ(decoded.Regions()[0].region_id, 100);
+  EXPECT_TRUE(decoded.Regions()[0].stream_id.empty());
+  EXPECT_FALSE(decoded.Regions()[0].started);
+  EXPECT_FALSE(decoded.Regions()[0].done);
+  EXPECT_FALSE(decoded.Regions()[1].done);
+  EXPECT_EQ(decoded.RegionsToFetch(), std::vector<int64_t>({0, 1}));
+
+  // the new streams send the returned hit again, it is skipped
+  decoded.OnBatch(0, "", false, CreateHits({{1, 4.0}, {2, 3.0}}));
+  decoded.OnBatch(1, "", false, CreateHits({{3, 1.0}}));
+  hits.clear();
+  decoded.PopReady(10, hits);
+  EXPECT_EQ(HitIds(hits), std::vector<int64_t>({2, 3}));
+  EXPECT_EQ(hits[0].doc, "doc2");
+  EXPECT_TRUE(decoded.Finished());
+}
+
+TEST(SDKDocumentSearchAllCursorTest, InvalidToken) {
+  DocumentSearchAllCursor cursor;
+  EXPECT_TRUE(cursor.DecodeToken("xyz").IsInvalidArgument());
+  EXPECT_TRUE(cursor.DecodeToken("02").IsInvalidArgument());
+
+  DocumentSearchAllCursor other;
+  other.AddRegion(100);
+  std::string token = other.EncodeToken();
+  EXPECT_TRUE(cursor.DecodeToken(token.substr(0, token.size() - 2)).IsInvalidArgument());
+  EXPECT_TRUE(cursor.DecodeToken(token + "00").IsInvalidArgument());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,123 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "dingosdk/document.h"
+#include "gtest/gtest.h"
+#include "sdk/document/document_search_task.h"
+#include "sdk/document/document_translater.h"
+#include "sdk/rpc/coordinator_rpc.h"
+#include "sdk/rpc/document_service_rpc.h"
+#include "test_base.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKDocumentSearchTaskTest : public TestBase {
+ public:
+  void SetUp() override {
+    doc_index_def = CreateFakeDocumentIndexDef();
+    EXPECT_CALL(*meta_rpc_controller, SyncCall).WillRepeatedly([this](Rpc& rpc) {
+      auto* t_rpc = dynamic_cast<GetIndexRpc*>(&rpc);
+      CHECK_NOTNULL(t_rpc);
+      *(t_rpc->MutableResponse()->mutable_index_definition_with_id()) = doc_index_def;
+      return Status::OK();
+    });
+
+    // one region per partition, region id is 100 + partition id
+    const auto& partition = doc_index_def.index_definition().index_partition();
+    for (int i = 0; i < partition.partitions_size(); i++) {
+      meta_cache->MaybeAddRegion(GenDocRegion(100 + partition.partitions(i).id().entity_id(),
+                                              partition.partitions(i).range(), 1));
+    }
+  }
+
+  static std::shared_ptr<Region> GenDocRegion(int64_t region_id, const pb::common::Range& range, int64_t version) {
+    pb::common::RegionEpoch epoch;
+    epoch.set_version(version);
+    epoch.set_conf_version(1);
+    return GenRegion(region_id, range, epoch, pb::common::RegionType::INDEX_REGION);
+  }
+
+  // partitions 3, 4, 5 own ids [0, 10), [10, 20), [20, max)
+  static pb::meta::IndexDefinitionWithId CreateFakeDocumentIndexDef() {
+    std::vector<int64_t> index_and_part_ids{2, 3, 4, 5};
+    std::vector<int64_t> range_seperator_ids = {10, 20};
+
+    pb::meta::IndexDefinitionWithId index_definition_with_id;
+    FillVectorIndexId(index_definition_with_id.mutable_index_id(), index_and_part_ids[0], 2);
+    auto* defination = index_definition_with_id.mutable_index_definition();
+    defination->set_name("test");
+    DocumentTranslater::FillRangePartitionRule(defination->mutable_index_partition(), range_seperator_ids,
+                                               index_and_part_ids);
+    defination->set_replica(3);
+    defination->mutable_index_parameter()->set_index_type(pb::common::IndexType::INDEX_TYPE_DOCUMENT);
+
+    return index_definition_with_id;
+  }
+
+  // region of partition p answers docs p * 10 + 1 and p * 10 + 2, score is the id
+  static void FillSearchResponse(DocumentSearchRpc& rpc) {
+    int64_t part_id = rpc.Request()->context().region_id() - 100;
+    for (int64_t id : {part_id * 10 + 1, part_id * 10 + 2}) {
+      auto* doc_with_score = rpc.MutableResponse()->add_document_with_scores();
+      doc_with_score->mutable_document_with_id()->set_id(id);
+      doc_with_score->set_score(static_cast<float>(id));
+    }
+  }
+
+  pb::meta::IndexDefinitionWithId doc_index_def;
+};
+
+TEST_F(SDKDocumentSearchTaskTest, RetryKeepsHitsOfDonePartitions) {
+  // the region of partition 4 is moved to a new version when it is searched first
+  auto new_region = GenDocRegion(104, doc_index_def.index_definition().index_partition().partitions(1).range(), 2);
+
+  std::atomic<int> region_104_calls{0};
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* t_rpc = dynamic_cast<DocumentSearchRpc*>(&rpc);
+    CHECK_NOTNULL(t_rpc);
+    if (t_rpc->Request()->context().region_id() == 104 && region_104_calls.fetch_add(1) == 0) {
+      auto* error = t_rpc->MutableResponse()->mutable_error();
+      error->set_errcode(pb::error::EREGION_VERSION);
+      Region2StoreRegionInfo(new_region, error->mutable_store_region_info());
+    } else {
+      FillSearchResponse(*t_rpc);
+    }
+    cb();
+  });
+
+  DocSearchParam param;
+  param.top_n = 5;
+  param.query_string = "text";
+  DocSearchResult result;
+  DocumentSearchTask task(*stub, 2, param, result);
+  Status s = task.Run();
+  ASSERT_TRUE(s.ok()) << s.ToString();
+
+  EXPECT_EQ(region_104_calls.load(), 2);
+  std::vector<int64_t> ids;
+  for (const auto& doc : result.doc_sores) {
+    ids.push_back(doc.doc_with_id.id);
+  }
+  EXPECT_EQ(ids, std::vector<int64_t>({52, 51, 42, 41, 32}));
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,90 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <vector>
+
+#include "dingosdk/document.h"
+#include "gtest/gtest.h"
+#include "sdk/document/document_topn.h"
+
+namespace dingodb {
+namespace sdk {
+
+static DocWithStore CreateResult(int64_t id, float score) {
+  DocWithStore result;
+  result.doc_with_id.id = id;
+  result.score = score;
+  return result;
+}
+
+static std::vector<int64_t> ResultIds(const std::vector<DocWithStore>& results) {
+  std::vector<int64_t> ids;
+  for (const auto& result : results) {
+    ids.push_back(result.doc_with_id.id);
+  }
+  return ids;
+}
+
+TEST(SDKDocumentTopNTest, HigherIsBetter) {
+  DocumentTopN top_n(3);
+  std::vector<float> scores = {0.5, 2.0, 1.0, 3.0, 0.1};
+  for (int64_t i = 0; i < scores.size(); i++) {
+    top_n.Push(CreateResult(i + 1, scores[i]));
+  }
+
+  EXPECT_EQ(top_n.Size(), 3);
+  EXPECT_TRUE(top_n.Accept(1.5, 10));
+  EXPECT_FALSE(top_n.Accept(0.8, 10));
+  EXPECT_EQ(ResultIds(top_n.Finish()), std::vector<int64_t>({4, 2, 3}));
+  EXPECT_EQ(top_n.Size(), 0);
+}
+
+TEST(SDKDocumentTopNTest, TieBreakById) {
+  DocumentTopN top_n(2);
+  top_n.Push(CreateResult(7, 1.0));
+  top_n.Push(CreateResult(3, 1.0));
+  top_n.Push(CreateResult(5, 1.0));
+
+  EXPECT_TRUE(top_n.Accept(1.0, 4));
+  EXPECT_FALSE(top_n.Accept(1.0, 6));
+  EXPECT_EQ(ResultIds(top_n.Finish()), std::vector<int64_t>({3, 5}));
+}
+
+TEST(SDKDocumentTopNTest, Merge) {
+  DocumentTopN left(2);
+  left.Push(CreateResult(1, 3.0));
+  left.Push(CreateResult(2, 1.0));
+
+  DocumentTopN right(2);
+  right.Push(CreateResult(3, 4.0));
+  right.Push(CreateResult(4, 2.0));
+
+  left.Merge(std::move(right));
+  EXPECT_EQ(ResultIds(left.Finish()), std::vector<int64_t>({3, 1}));
+}
+
+TEST(SDKDocumentTopNTest, Unbounded) {
+  DocumentTopN top_n(0);
+  std::vector<float> scores = {1.0, 3.0, 2.0};
+  for (int64_t i = 0; i < scores.size(); i++) {
+    EXPECT_TRUE(top_n.Accept(scores[i], i + 1));
+    top_n.Push(CreateResult(i + 1, scores[i]));
+  }
+
+  EXPECT_EQ(ResultIds(top_n.Finish()), std::vector<int64_t>({2, 3, 1}));
+}
+
+}  // namespace sdk
+}  // namespace dingodb
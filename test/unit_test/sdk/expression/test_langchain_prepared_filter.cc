@@ -0,0 +1,175 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "dingosdk/status.h"
+#include "dingosdk/vector.h"
+#include "sdk/expression/langchain_expr_encoder.h"
+#include "sdk/expression/langchain_expr_factory.h"
+#include "sdk/expression/langchain_prepared_filter.h"
+#include "sdk/utils/codec.h"
+
+namespace dingodb {
+namespace sdk {
+namespace expression {
+
+static std::string EncodeLiteral(const std::string& json_str,
+                                 const std::unordered_map<std::string, Type>& schema = {}) {
+  std::shared_ptr<LangchainExpr> expr;
+  SchemaLangchainExprFactory expr_factory(schema);
+  Status s = expr_factory.CreateExpr(json_str, expr);
+  EXPECT_TRUE(s.ok()) << s.ToString();
+
+  LangChainExprEncoder encoder;
+  return sdk::codec::BytesToHexString(encoder.EncodeToFilter(expr.get()));
+}
+
+static ScalarField Int64Field(int64_t value) {
+  ScalarField field;
+  field.long_data = value;
+  return field;
+}
+
+static ScalarField StringField(const std::string& value) {
+  ScalarField field;
+  field.string_data = value;
+  return field;
+}
+
+TEST(SDKLangChainPreparedFilterTest, WithoutParam) {
+  std::string json_str =
+      R"({"type": "comparator", "comparator": "gt", "attribute": "a3", "value": 50, "value_type": "DOUBLE"})";
+
+  std::shared_ptr<const PreparedFilter> filter;
+  Status s = PreparedFilter::Compile(json_str, nullptr, filter);
+  EXPECT_TRUE(s.ok()) << s.ToString();
+  EXPECT_FALSE(filter->HasParams());
+
+  pb::common::CoprocessorV2 coprocessor;
+  s = filter->Bind({}, coprocessor);
+  EXPECT_TRUE(s.ok()) << s.ToString();
+  EXPECT_EQ(sdk::codec::BytesToHexString(coprocessor.rel_expr()), "713500154049000000000000930500");
+  EXPECT_EQ(coprocessor.original_schema().schema_size(), 1);
+}
+
+TEST(SDKLangChainPreparedFilterTest, BindParams) {
+  std::string param_json = R"({
+      "type": "operator",
+      "operator": "and",
+      "arguments": [
+        {"type": "comparator", "comparator": "gte", "attribute": "a1", "value": {"param": "low"},
+         "value_type": "INT64"},
+        {"type": "comparator", "comparator": "eq", "attribute": "a2", "value": {"param": "tag"},
+         "value_type": "STRING"},
+        {"type": "comparator", "comparator": "lt", "attribute": "a1", "value": {"param": "high"},
+         "value_type": "INT64"}
+      ]
+    })";
+
+  std::shared_ptr<const PreparedFilter> filter;
+  Status s = PreparedFilter::Compile(param_json, nullptr, filter);
+  EXPECT_TRUE(s.ok()) << s.ToString();
+  EXPECT_TRUE(filter->HasParams());
+
+  for (int64_t low : {-300, 0, 7}) {
+    std::string literal_json = R"({
+        "type": "operator",
+        "operator": "and",
+        "arguments": [
+          {"type": "comparator", "comparator": "gte", "attribute": "a1", "value": )" +
+                               std::to_string(low) + R"(, "value_type": "INT64"},
+          {"type": "comparator", "comparator": "eq", "attribute": "a2", "value": "abc", "value_type": "STRING"},
+          {"type": "comparator", "comparator": "lt", "attribute": "a1", "value": 100000, "value_type": "INT64"}
+        ]
+      })";
+
+    std::map<std::string, ScalarField> params{
+        {"low", Int64Field(low)}, {"high", Int64Field(100000)}, {"tag", StringField("abc")}};
+    pb::common::CoprocessorV2 coprocessor;
+    s = filter->Bind(params, coprocessor);
+    EXPECT_TRUE(s.ok()) << s.ToString();
+    EXPECT_EQ(sdk::codec::BytesToHexString(coprocessor.rel_expr()), EncodeLiteral(literal_json));
+  }
+}
+
+TEST(SDKLangChainPreparedFilterTest, BindRemappedType) {
+  std::unordered_map<std::string, Type> schema{{"a3", kDOUBLE}};
+  std::string param_json =
+      R"({"type": "comparator", "comparator": "gt", "attribute": "a3", "value": {"param": "p"},
+          "value_type": "INT64"})";
+  std::string literal_json =
+      R"({"type": "comparator", "comparator": "gt", "attribute": "a3", "value": 50, "value_type": "INT64"})";
+
+  std::shared_ptr<const PreparedFilter> filter;
+  Status s = PreparedFilter::Compile(param_json, &schema, filter);
+  EXPECT_TRUE(s.ok()) << s.ToString();
+
+  pb::common::CoprocessorV2 coprocessor;
+  s = filter->Bind({{"p", Int64Field(50)}}, coprocessor);
+  EXPECT_TRUE(s.ok()) << s.ToString();
+  EXPECT_EQ(sdk::codec::BytesToHexString(coprocessor.rel_expr()), EncodeLiteral(literal_json, schema));
+}
+
+TEST(SDKLangChainPreparedFilterTest, InvalidArgument) {
+  std::shared_ptr<const PreparedFilter> filter;
+  Status s = PreparedFilter::Compile("{not json", nullptr, filter);
+  EXPECT_TRUE(s.IsInvalidArgument());
+
+  s = PreparedFilter::Compile(
+      R"({"type": "comparator", "comparator": "eq", "attribute": "a", "value": {"param": "p"}, "value_type": "BOOL"})",
+      nullptr, filter);
+  EXPECT_TRUE(s.ok()) << s.ToString();
+
+  pb::common::CoprocessorV2 coprocessor;
+  s = filter->Bind({{"q", ScalarField()}}, coprocessor);
+  EXPECT_TRUE(s.IsInvalidArgument());
+}
+
+TEST(SDKLangChainPreparedFilterTest, Cache) {
+  std::unordered_map<std::string, Type> schema;
+  PreparedFilterCache cache(schema);
+
+  std::shared_ptr<const PreparedFilter> first;
+  Status s = cache.Get(
+      R"({"type": "comparator", "comparator": "eq", "attribute": "a", "value": 1, "value_type": "INT64"})", first);
+  EXPECT_TRUE(s.ok()) << s.ToString();
+
+  // same expr with other key order and spaces
+  std::shared_ptr<const PreparedFilter> second;
+  s = cache.Get(R"({"value_type":"INT64","value":1,"attribute":"a","comparator":"eq","type":"comparator"})", second);
+  EXPECT_TRUE(s.ok()) << s.ToString();
+  EXPECT_EQ(first.get(), second.get());
+
+  std::shared_ptr<const PreparedFilter> third;
+  s = cache.Get(R"({"value_type":"INT64","value":1,"attribute":"a","comparator":"eq","type":"comparator"})", third);
+  EXPECT_TRUE(s.ok()) << s.ToString();
+  EXPECT_EQ(first.get(), third.get());
+
+  // raw key of each expr and their shared normalized key
+  EXPECT_EQ(cache.Size(), 3);
+
+  std::shared_ptr<const PreparedFilter> invalid;
+  s = cache.Get("{", invalid);
+  EXPECT_TRUE(s.IsInvalidArgument());
+}
+
+}  // namespace expression
+}  // namespace sdk
+}  // namespace dingodb
@@ -32,10 +32,14 @@ class MockClientStub final : public ClientStub {
   MOCK_METHOD(std::shared_ptr<MetaCache>, GetMetaCache, (), (const, override));
   MOCK_METHOD(std::shared_ptr<RpcClient>, GetStoreRpcClient, (), (const, override));
   MOCK_METHOD(std::shared_ptr<RegionScannerFactory>, GetRawKvRegionScannerFactory, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<RegionScannerFactory>, GetTxnRegionScannerFactory, (), (const, override));
   MOCK_METHOD(std::shared_ptr<AdminTool>, GetAdminTool, (), (const, override));
   MOCK_METHOD(std::shared_ptr<TxnLockResolver>, GetTxnLockResolver, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<TxnStatusCache>, GetTxnStatusCache, (), (const, override));
   MOCK_METHOD(std::shared_ptr<Actuator>, GetActuator, (), (const, override));
   MOCK_METHOD(std::shared_ptr<VectorIndexCache>, GetVectorIndexCache, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<VectorSearchCache>, GetVectorSearchCache, (), (const, override));
+  MOCK_METHOD(std::shared_ptr<DocumentIndexCache>, GetDocumentIndexCache, (), (const, override));
   MOCK_METHOD(std::shared_ptr<AutoIncrementerManager>, GetAutoIncrementerManager, (), (const, override));
 
   // std::shared_ptr<AutoIncrementerManager>  auto_increment_manager_;
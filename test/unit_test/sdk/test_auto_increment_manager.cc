@@ -12,13 +12,19 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "proto/meta.pb.h"
 #include "sdk/auto_increment_manager.h"
+#include "sdk/common/param_config.h"
 #include "sdk/rpc/coordinator_rpc.h"
 #include "dingosdk/status.h"
 #include "sdk/vector/vector_common.h"
@@ -30,9 +36,16 @@ namespace sdk {
 
 class SDKAutoInrementerTest : public TestBase {
  public:
-  void SetUp() override { Init(); }
+  void SetUp() override {
+    // background prefetch issue extra requests, only the prefetch tests enable it
+    prefetch_ratio = FLAGS_auto_incre_prefetch_ratio;
+    FLAGS_auto_incre_prefetch_ratio = 0;
+    Init();
+  }
+
+  void TearDown() override { FLAGS_auto_incre_prefetch_ratio = prefetch_ratio; }
 
-  void TearDown() override {}
+  double prefetch_ratio;
 
   std::shared_ptr<VectorIndex> vector_index;
   std::shared_ptr<VectorIndexAutoInrementer> incrementer;
@@ -158,6 +171,100 @@ TEST_F(SDKAutoInrementerTest, FromCacheThenRefill) {
   }
 }
 
+TEST_F(SDKAutoInrementerTest, LargeBatchOneRequest) {
+  int64_t count = FLAGS_auto_incre_req_count * 10;
+  EXPECT_CALL(*meta_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<GenerateAutoIncrementRpc*>(&rpc);
+    EXPECT_EQ(t_rpc->Request()->count(), count);
+    t_rpc->MutableResponse()->set_start_id(1);
+    t_rpc->MutableResponse()->set_end_id(count + 1);
+    return Status::OK();
+  });
+
+  std::vector<int64_t> ids;
+  Status s = incrementer->GetNextIds(ids, count);
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(ids.size(), count);
+  EXPECT_EQ(ids.front(), 1);
+  EXPECT_EQ(ids.back(), count);
+}
+
+TEST_F(SDKAutoInrementerTest, PrefetchInBackground) {
+  FLAGS_auto_incre_prefetch_ratio = 0.5;
+  std::atomic<bool> prefetched{false};
+  EXPECT_CALL(*meta_rpc_controller, SyncCall)
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<GenerateAutoIncrementRpc*>(&rpc);
+        t_rpc->MutableResponse()->set_start_id(1);
+        t_rpc->MutableResponse()->set_end_id(101);
+        return Status::OK();
+      })
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<GenerateAutoIncrementRpc*>(&rpc);
+        EXPECT_EQ(t_rpc->Request()->count(), FLAGS_auto_incre_req_count);
+        t_rpc->MutableResponse()->set_start_id(101);
+        t_rpc->MutableResponse()->set_end_id(101 + FLAGS_auto_incre_req_count);
+        prefetched.store(true);
+        return Status::OK();
+      });
+
+  int64_t id = 0;
+  Status s = incrementer->GetNextId(id);
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(id, 1);
+
+  for (int i = 0; i < 100 && !prefetched.load(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_TRUE(prefetched.load());
+  // wait the prefetched range is cached
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  // served by the current range and the prefetched one, without request
+  std::vector<int64_t> ids;
+  s = incrementer->GetNextIds(ids, 150);
+  EXPECT_TRUE(s.ok());
+  ASSERT_EQ(ids.size(), 150);
+  for (int64_t i = 0; i < 150; i++) {
+    EXPECT_EQ(ids[i], i + 2);
+  }
+}
+
+TEST_F(SDKAutoInrementerTest, MultiThreadUniqueIds) {
+  std::atomic<int64_t> next_start{1};
+  EXPECT_CALL(*meta_rpc_controller, SyncCall).WillRepeatedly([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<GenerateAutoIncrementRpc*>(&rpc);
+    int64_t start = next_start.fetch_add(t_rpc->Request()->count());
+    t_rpc->MutableResponse()->set_start_id(start);
+    t_rpc->MutableResponse()->set_end_id(start + t_rpc->Request()->count());
+    return Status::OK();
+  });
+
+  int thread_num = 8;
+  int loop = 200;
+  std::vector<std::vector<int64_t>> thread_ids(thread_num);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_num; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < loop; i++) {
+        Status s = incrementer->GetNextIds(thread_ids[t], (i % 7) + 1);
+        EXPECT_TRUE(s.ok());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::set<int64_t> all_ids;
+  size_t total = 0;
+  for (const auto& ids : thread_ids) {
+    total += ids.size();
+    all_ids.insert(ids.begin(), ids.end());
+  }
+  EXPECT_EQ(all_ids.size(), total);
+}
+
 TEST_F(SDKAutoInrementerTest, MultiThreadGetNextId) {
   EXPECT_CALL(*meta_rpc_controller, SyncCall)
       .WillOnce([&](Rpc& rpc) {
@@ -402,5 +509,103 @@ TEST_F(SDKAutoInrementerTest, MultiThreadUpdateId) {
   t5.join();
 }
 
+TEST_F(SDKAutoInrementerTest, ConcurrentUpdateAndGetNextIds) {
+  // meta server hands out consecutive ranges and restarts them from the updated id
+  std::mutex meta_mutex;
+  int64_t next_start = 1;
+  EXPECT_CALL(*meta_rpc_controller, SyncCall).WillRepeatedly([&](Rpc& rpc) {
+    std::lock_guard<std::mutex> guard(meta_mutex);
+    auto* update_rpc = dynamic_cast<UpdateAutoIncrementRpc*>(&rpc);
+    if (update_rpc != nullptr) {
+      next_start = update_rpc->Request()->start_id();
+      return Status::OK();
+    }
+
+    auto* t_rpc = dynamic_cast<GenerateAutoIncrementRpc*>(&rpc);
+    CHECK_NOTNULL(t_rpc);
+    t_rpc->MutableResponse()->set_start_id(next_start);
+    t_rpc->MutableResponse()->set_end_id(next_start + t_rpc->Request()->count());
+    next_start += t_rpc->Request()->count();
+    return Status::OK();
+  });
+
+  const int64_t update_start_id = 1000000;
+  std::atomic<bool> updated{false};
+
+  int thread_num = 4;
+  int loop = 300;
+  std::vector<std::vector<int64_t>> thread_ids(thread_num);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_num; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < loop; i++) {
+        bool after_update = updated.load();
+        std::vector<int64_t> ids;
+        Status s = incrementer->GetNextIds(ids, (i % 5) + 1);
+        EXPECT_TRUE(s.ok());
+        for (int64_t id : ids) {
+          // a call started after update never gets an id of the range cached before it
+          if (after_update) {
+            EXPECT_GE(id, update_start_id);
+          }
+          thread_ids[t].push_back(id);
+        }
+      }
+    });
+  }
+
+  threads.emplace_back([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    Status s = incrementer->UpdateAutoIncrementId(update_start_id);
+    EXPECT_TRUE(s.ok());
+    updated.store(true);
+  });
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::set<int64_t> all_ids;
+  size_t total = 0;
+  for (const auto& ids : thread_ids) {
+    total += ids.size();
+    all_ids.insert(ids.begin(), ids.end());
+  }
+  EXPECT_EQ(all_ids.size(), total);
+}
+
+TEST_F(SDKAutoInrementerTest, FetchFailLeaveIdsUnchanged) {
+  EXPECT_CALL(*meta_rpc_controller, SyncCall)
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<GenerateAutoIncrementRpc*>(&rpc);
+        t_rpc->MutableResponse()->set_start_id(1);
+        t_rpc->MutableResponse()->set_end_id(4);
+        return Status::OK();
+      })
+      .WillOnce([&](Rpc& rpc) { return Status::NetworkError("mock error"); })
+      .WillOnce([&](Rpc& rpc) {
+        auto* t_rpc = dynamic_cast<GenerateAutoIncrementRpc*>(&rpc);
+        t_rpc->MutableResponse()->set_start_id(10);
+        t_rpc->MutableResponse()->set_end_id(20);
+        return Status::OK();
+      });
+
+  int64_t id = 0;
+  Status s = incrementer->GetNextId(id);
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(id, 1);
+
+  // ids 2 and 3 are taken from the current range before the fetch fails, they are dropped
+  std::vector<int64_t> ids{100};
+  s = incrementer->GetNextIds(ids, 5);
+  EXPECT_FALSE(s.ok());
+  EXPECT_EQ(ids, std::vector<int64_t>({100}));
+
+  ids.clear();
+  s = incrementer->GetNextIds(ids, 2);
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(ids, std::vector<int64_t>({10, 11}));
+}
+
 }  // namespace sdk
 }  // namespace dingodb
\ No newline at end of file
@@ -28,12 +28,16 @@
 #include "sdk/auto_increment_manager.h"
 #include "dingosdk/client.h"
 #include "sdk/client_internal_data.h"
+#include "sdk/common/param_config.h"
+#include "sdk/document/document_index_cache.h"
 #include "sdk/meta_cache.h"
 #include "sdk/transaction/txn_impl.h"
+#include "sdk/transaction/txn_status_cache.h"
 #include "sdk/utils/actuator.h"
 #include "sdk/utils/thread_pool_actuator.h"
 #include "dingosdk/vector.h"
 #include "sdk/vector/vector_index_cache.h"
+#include "sdk/vector/vector_search_cache.h"
 #include "test_common.h"
 #include "transaction/mock_txn_lock_resolver.h"
 
@@ -70,6 +74,8 @@ class TestBase : public ::testing::Test {
     region_scanner_factory = std::make_shared<MockRegionScannerFactory>();
     ON_CALL(*stub, GetRawKvRegionScannerFactory).WillByDefault(testing::Return(region_scanner_factory));
     EXPECT_CALL(*stub, GetRawKvRegionScannerFactory).Times(testing::AnyNumber());
+    ON_CALL(*stub, GetTxnRegionScannerFactory).WillByDefault(testing::Return(region_scanner_factory));
+    EXPECT_CALL(*stub, GetTxnRegionScannerFactory).Times(testing::AnyNumber());
 
     admin_tool = std::make_shared<AdminTool>(*stub);
     ON_CALL(*stub, GetAdminTool).WillByDefault(testing::Return(admin_tool));
@@ -79,6 +85,10 @@ class TestBase : public ::testing::Test {
     ON_CALL(*stub, GetTxnLockResolver).WillByDefault(testing::Return(txn_lock_resolver));
     EXPECT_CALL(*stub, GetTxnLockResolver).Times(testing::AnyNumber());
 
+    txn_status_cache = std::make_shared<TxnStatusCache>(1024);
+    ON_CALL(*stub, GetTxnStatusCache).WillByDefault(testing::Return(txn_status_cache));
+    EXPECT_CALL(*stub, GetTxnStatusCache).Times(testing::AnyNumber());
+
     actuator = std::make_shared<ThreadPoolActuator>();
     actuator->Start(FLAGS_actuator_thread_num);
     ON_CALL(*stub, GetActuator).WillByDefault(testing::Return(actuator));
@@ -88,6 +98,16 @@ class TestBase : public ::testing::Test {
     ON_CALL(*stub, GetVectorIndexCache).WillByDefault(testing::Return(index_cache));
     EXPECT_CALL(*stub, GetVectorIndexCache).Times(testing::AnyNumber());
 
+    vector_search_cache = std::make_shared<VectorSearchCache>(FLAGS_vector_search_cache_capacity_mb * 1024 * 1024,
+                                                              FLAGS_vector_search_cache_ttl_ms,
+                                                              FLAGS_vector_search_cache_quantize_step);
+    ON_CALL(*stub, GetVectorSearchCache).WillByDefault(testing::Return(vector_search_cache));
+    EXPECT_CALL(*stub, GetVectorSearchCache).Times(testing::AnyNumber());
+
+    document_index_cache = std::make_shared<DocumentIndexCache>(*stub);
+    ON_CALL(*stub, GetDocumentIndexCache).WillByDefault(testing::Return(document_index_cache));
+    EXPECT_CALL(*stub, GetDocumentIndexCache).Times(testing::AnyNumber());
+
     auto_increment_manager = std::make_shared<AutoIncrementerManager>(*stub);
     ON_CALL(*stub, GetAutoIncrementerManager).WillByDefault(testing::Return(auto_increment_manager));
     EXPECT_CALL(*stub, GetAutoIncrementerManager).Times(testing::AnyNumber());
@@ -118,8 +138,11 @@ class TestBase : public ::testing::Test {
   std::shared_ptr<MockRegionScannerFactory> region_scanner_factory;
   std::shared_ptr<AdminTool> admin_tool;
   std::shared_ptr<MockTxnLockResolver> txn_lock_resolver;
+  std::shared_ptr<TxnStatusCache> txn_status_cache;
   std::shared_ptr<Actuator> actuator;
   std::shared_ptr<VectorIndexCache> index_cache;
+  std::shared_ptr<VectorSearchCache> vector_search_cache;
+  std::shared_ptr<DocumentIndexCache> document_index_cache;
   std::shared_ptr<AutoIncrementerManager> auto_increment_manager;
 
   // client own stub
@@ -0,0 +1,151 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/id_region_map.h"
+#include "sdk/meta_cache.h"
+#include "sdk/vector/vector_codec.h"
+#include "test_base.h"
+#include "test_common.h"
+
+namespace dingodb {
+namespace sdk {
+
+static std::string PartitionKey(int64_t part_id) {
+  std::string key;
+  vector_codec::EncodeVectorKey(kVectorPrefix, part_id, key);
+  return key;
+}
+
+static std::string IdKey(int64_t part_id, int64_t id) {
+  std::string key;
+  vector_codec::EncodeVectorKey(kVectorPrefix, part_id, id, key);
+  return key;
+}
+
+static std::shared_ptr<Region> GenIdRegion(int64_t region_id, const std::string& start_key,
+                                           const std::string& end_key) {
+  pb::common::Range range;
+  range.set_start_key(start_key);
+  range.set_end_key(end_key);
+
+  pb::common::RegionEpoch epoch;
+  epoch.set_version(1);
+  epoch.set_conf_version(1);
+
+  return GenRegion(region_id, range, epoch, pb::common::INDEX_REGION);
+}
+
+class SDKIdRegionMapTest : public TestBase {
+ protected:
+  void SetUp() override {
+    // partition 10 has ids [0, 1000), partition 20 has ids [1000, ...)
+    id_region_map = std::make_unique<IdRegionMap>(kVectorPrefix, std::map<int64_t, int64_t>{{0, 10}, {1000, 20}});
+
+    region_a = GenIdRegion(1, PartitionKey(10), IdKey(10, 500));
+    region_b = GenIdRegion(2, IdKey(10, 500), PartitionKey(11));
+    region_c = GenIdRegion(3, PartitionKey(20), PartitionKey(21));
+    meta_cache->MaybeAddRegion(region_a);
+    meta_cache->MaybeAddRegion(region_b);
+    meta_cache->MaybeAddRegion(region_c);
+  }
+
+  std::unique_ptr<IdRegionMap> id_region_map;
+  std::shared_ptr<Region> region_a;
+  std::shared_ptr<Region> region_b;
+  std::shared_ptr<Region> region_c;
+};
+
+TEST_F(SDKIdRegionMapTest, RouteSortedIds) {
+  std::vector<int64_t> ids = {1, 499, 500, 999, 1000, 5000};
+  std::vector<std::shared_ptr<Region>> regions;
+  EXPECT_TRUE(id_region_map->Route(*meta_cache, ids, regions).ok());
+
+  ASSERT_EQ(regions.size(), ids.size());
+  EXPECT_EQ(regions[0], region_a);
+  EXPECT_EQ(regions[1], region_a);
+  EXPECT_EQ(regions[2], region_b);
+  // region b ends at the end of partition 10, id 1000 belongs to partition 20
+  EXPECT_EQ(regions[3], region_b);
+  EXPECT_EQ(regions[4], region_c);
+  EXPECT_EQ(regions[5], region_c);
+  EXPECT_EQ(id_region_map->Size(), 3);
+
+  // routed again from the cached intervals
+  std::shared_ptr<Region> region;
+  EXPECT_TRUE(id_region_map->Route(*meta_cache, 700, region).ok());
+  EXPECT_EQ(region, region_b);
+  EXPECT_EQ(id_region_map->Size(), 3);
+}
+
+TEST_F(SDKIdRegionMapTest, RouteUnsortedIdsAcrossPartitions) {
+  // misses alternate between the partitions, so their keys are encoded by several runs
+  std::vector<int64_t> ids = {5000, 1, 2, 1500, 600, 3, 999};
+  std::vector<std::shared_ptr<Region>> regions;
+  EXPECT_TRUE(id_region_map->Route(*meta_cache, ids, regions).ok());
+
+  ASSERT_EQ(regions.size(), ids.size());
+  EXPECT_EQ(regions[0], region_c);
+  EXPECT_EQ(regions[1], region_a);
+  EXPECT_EQ(regions[2], region_a);
+  EXPECT_EQ(regions[3], region_c);
+  EXPECT_EQ(regions[4], region_b);
+  EXPECT_EQ(regions[5], region_a);
+  EXPECT_EQ(regions[6], region_b);
+  EXPECT_EQ(id_region_map->Size(), 3);
+}
+
+TEST_F(SDKIdRegionMapTest, RouteAfterSplit) {
+  std::shared_ptr<Region> region;
+  EXPECT_TRUE(id_region_map->Route(*meta_cache, 600, region).ok());
+  EXPECT_EQ(region, region_b);
+
+  // region b splits at 700, the old interval is dropped as the region is stale
+  meta_cache->ClearRange(region_b);
+  auto left = GenIdRegion(4, IdKey(10, 500), IdKey(10, 700));
+  auto right = GenIdRegion(5, IdKey(10, 700), PartitionKey(11));
+  meta_cache->MaybeAddRegion(left);
+  meta_cache->MaybeAddRegion(right);
+
+  std::vector<int64_t> ids = {600, 699, 700, 800};
+  std::vector<std::shared_ptr<Region>> regions;
+  EXPECT_TRUE(id_region_map->Route(*meta_cache, ids, regions).ok());
+  EXPECT_EQ(regions[0], left);
+  EXPECT_EQ(regions[1], left);
+  EXPECT_EQ(regions[2], right);
+  EXPECT_EQ(regions[3], right);
+  EXPECT_EQ(id_region_map->Size(), 2);
+}
+
+TEST_F(SDKIdRegionMapTest, LookupFail) {
+  meta_cache->ClearRange(region_b);
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).WillRepeatedly(testing::Return(Status::NetworkError("mock")));
+
+  std::vector<int64_t> ids = {100, 600, 2000};
+  std::vector<std::shared_ptr<Region>> regions;
+  Status s = id_region_map->Route(*meta_cache, ids, regions);
+  EXPECT_TRUE(s.IsNetworkError());
+  EXPECT_EQ(regions[0], region_a);
+  EXPECT_EQ(regions[1], nullptr);
+  EXPECT_EQ(regions[2], region_c);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
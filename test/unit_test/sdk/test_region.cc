@@ -72,6 +72,13 @@ TEST_F(SDKRegionTest, TestInit) {
   EXPECT_TRUE(region->IsStale());
 }
 
+TEST_F(SDKRegionTest, ContainsKey) {
+  EXPECT_TRUE(region->ContainsKey("a"));
+  EXPECT_TRUE(region->ContainsKey("aaaa"));
+  EXPECT_FALSE(region->ContainsKey("b"));
+  EXPECT_FALSE(region->ContainsKey("0"));
+}
+
 TEST_F(SDKRegionTest, TestMark) {
   EndPoint end = kAddrOne;
   region->MarkFollower(end);
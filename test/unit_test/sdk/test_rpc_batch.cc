@@ -0,0 +1,68 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sdk/rpc/rpc_batch.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKRpcBatchTest, ChunkByCount) {
+  RpcChunker chunker(3, 0);
+  EXPECT_FALSE(chunker.Add(100));
+  EXPECT_FALSE(chunker.Add(100));
+  EXPECT_TRUE(chunker.Add(100));
+  EXPECT_FALSE(chunker.Add(100));
+}
+
+TEST(SDKRpcBatchTest, ChunkByBytes) {
+  RpcChunker chunker(0, 250);
+  EXPECT_FALSE(chunker.Add(100));
+  EXPECT_FALSE(chunker.Add(100));
+  EXPECT_TRUE(chunker.Add(100));
+  EXPECT_FALSE(chunker.Add(100));
+  EXPECT_TRUE(chunker.Add(1000));
+}
+
+TEST(SDKRpcBatchTest, WindowBoundInFlight) {
+  RpcWindow window;
+  std::vector<int64_t> sent;
+  window.Start(5, 2, [&](int64_t i) { sent.push_back(i); });
+  EXPECT_EQ(sent, std::vector<int64_t>({0, 1}));
+
+  EXPECT_FALSE(window.Done());
+  EXPECT_EQ(sent, std::vector<int64_t>({0, 1, 2}));
+  EXPECT_FALSE(window.Done());
+  EXPECT_FALSE(window.Done());
+  EXPECT_EQ(sent, std::vector<int64_t>({0, 1, 2, 3, 4}));
+  EXPECT_FALSE(window.Done());
+  EXPECT_TRUE(window.Done());
+  EXPECT_EQ(sent.size(), 5);
+}
+
+TEST(SDKRpcBatchTest, WindowSmallerThanInFlight) {
+  RpcWindow window;
+  std::vector<int64_t> sent;
+  window.Start(2, 32, [&](int64_t i) { sent.push_back(i); });
+  EXPECT_EQ(sent.size(), 2);
+  EXPECT_FALSE(window.Done());
+  EXPECT_TRUE(window.Done());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
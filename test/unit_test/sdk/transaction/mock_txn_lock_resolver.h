@@ -15,6 +15,8 @@
 #ifndef DINGODB_SDK_TEST_MOCK_TXN_RESOLVER_H_
 #define DINGODB_SDK_TEST_MOCK_TXN_RESOLVER_H_
 
+#include <vector>
+
 #include "sdk/client_stub.h"
 #include "gmock/gmock.h"
 #include "dingosdk/status.h"
@@ -30,6 +32,9 @@ class MockTxnLockResolver final : public TxnLockResolver {
   ~MockTxnLockResolver() override = default;
 
   MOCK_METHOD(Status, ResolveLock, (const pb::store::LockInfo& lock_info, int64_t caller_start_ts), (override));
+
+  MOCK_METHOD(Status, ResolveLocks, (const std::vector<pb::store::LockInfo>& lock_infos, int64_t caller_start_ts),
+              (override));
 };
 
 }  // namespace sdk
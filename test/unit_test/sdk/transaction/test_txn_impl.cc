@@ -14,6 +14,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "glog/logging.h"
 #include "gmock/gmock.h"
@@ -58,6 +59,7 @@ class SDKTxnImplTest : public TestBase {
     EXPECT_CALL(*meta_rpc_controller, SyncCall).Times(testing::AnyNumber());
 
     ON_CALL(*txn_lock_resolver, ResolveLock).WillByDefault(testing::Return(Status::OK()));
+    ON_CALL(*txn_lock_resolver, ResolveLocks).WillByDefault(testing::Return(Status::OK()));
   }
 
   TransactionOptions options;
@@ -446,9 +448,10 @@ TEST_F(SDKTxnImplTest, PrimaryKeyLockConflict) {
         cb();
       });
 
-  EXPECT_CALL(*txn_lock_resolver, ResolveLock)
-      .WillOnce([&](const pb::store::LockInfo& lock_info, int64_t caller_start_ts) {
-        EXPECT_TRUE(LockInfoEqual(lock_info, mock_lock));
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks)
+      .WillOnce([&](const std::vector<pb::store::LockInfo>& lock_infos, int64_t caller_start_ts) {
+        EXPECT_EQ(lock_infos.size(), 1);
+        EXPECT_TRUE(LockInfoEqual(lock_infos[0], mock_lock));
         EXPECT_EQ(caller_start_ts, txn->TEST_GetStartTs());
         return Status::OK();
       });
@@ -502,9 +505,10 @@ TEST_F(SDKTxnImplTest, PrimaryKeyLockConflictExceed) {
     cb();
   });
 
-  EXPECT_CALL(*txn_lock_resolver, ResolveLock)
-      .WillRepeatedly([&](const pb::store::LockInfo& lock_info, int64_t caller_start_ts) {
-        EXPECT_TRUE(LockInfoEqual(lock_info, mock_lock));
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks)
+      .WillRepeatedly([&](const std::vector<pb::store::LockInfo>& lock_infos, int64_t caller_start_ts) {
+        EXPECT_EQ(lock_infos.size(), 1);
+        EXPECT_TRUE(LockInfoEqual(lock_infos[0], mock_lock));
         EXPECT_EQ(caller_start_ts, txn->TEST_GetStartTs());
         return Status::TxnLockConflict("");
       });
@@ -557,6 +561,7 @@ TEST_F(SDKTxnImplTest, PrimaryKeyWriteLockConfict) {
   });
 
   EXPECT_CALL(*txn_lock_resolver, ResolveLock).Times(0);
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks).Times(0);
 
   Status s = txn->PreCommit();
   EXPECT_TRUE(s.IsTxnWriteConflict());
@@ -618,7 +623,7 @@ TEST_F(SDKTxnImplTest, PreWriteSecondLockConflict) {
         cb();
       });
 
-  EXPECT_CALL(*txn_lock_resolver, ResolveLock).Times(testing::AnyNumber());
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks).Times(testing::AnyNumber());
 
   Status s = txn->PreCommit();
   EXPECT_TRUE(s.IsTxnLockConflict());
@@ -686,6 +691,7 @@ TEST_F(SDKTxnImplTest, PreWriteSecondWriteConflict) {
       });
 
   EXPECT_CALL(*txn_lock_resolver, ResolveLock).Times(0);
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks).Times(0);
 
   Status s = txn->PreCommit();
   EXPECT_TRUE(s.IsTxnWriteConflict());
@@ -741,6 +747,7 @@ TEST_F(SDKTxnImplTest, CommitPrimaryKeyMeetRollback) {
   });
 
   EXPECT_CALL(*txn_lock_resolver, ResolveLock).Times(0);
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks).Times(0);
 
   Status s = txn->PreCommit();
   EXPECT_TRUE(s.ok());
@@ -793,6 +800,7 @@ TEST_F(SDKTxnImplTest, CommitSencondError) {
   });
 
   EXPECT_CALL(*txn_lock_resolver, ResolveLock).Times(0);
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks).Times(0);
 
   Status s = txn->PreCommit();
   EXPECT_TRUE(s.ok());
@@ -858,6 +866,7 @@ TEST_F(SDKTxnImplTest, PreCommitFailThenRollback) {
   });
 
   EXPECT_CALL(*txn_lock_resolver, ResolveLock).Times(0);
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks).Times(0);
 
   Status s = txn->PreCommit();
   EXPECT_TRUE(s.IsTxnWriteConflict());
@@ -930,6 +939,7 @@ TEST_F(SDKTxnImplTest, RollbackPrimaryKeyFail) {
   });
 
   EXPECT_CALL(*txn_lock_resolver, ResolveLock).Times(0);
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks).Times(0);
 
   Status s = txn->PreCommit();
   EXPECT_TRUE(s.IsTxnWriteConflict());
@@ -1005,6 +1015,7 @@ TEST_F(SDKTxnImplTest, RollbackSecondKeysFail) {
   });
 
   EXPECT_CALL(*txn_lock_resolver, ResolveLock).Times(0);
+  EXPECT_CALL(*txn_lock_resolver, ResolveLocks).Times(0);
 
   Status s = txn->PreCommit();
   EXPECT_TRUE(s.IsTxnWriteConflict());
@@ -1015,5 +1026,108 @@ TEST_F(SDKTxnImplTest, RollbackSecondKeysFail) {
   EXPECT_EQ(txn->TEST_GetTransactionState(), TransactionState::kRollbackted);
 }
 
+TEST_F(SDKTxnImplTest, SnapshotTsOnlyForReadOnly) {
+  options.snapshot_ts = 1000;
+
+  Transaction* txn = nullptr;
+  EXPECT_TRUE(client->NewTransaction(options, &txn).IsInvalidArgument());
+  delete txn;
+}
+
+TEST_F(SDKTxnImplTest, ReadOnlySnapshotTs) {
+  options.read_only = true;
+  options.snapshot_ts = 1000;
+
+  // stale read needs no tso
+  EXPECT_CALL(*meta_rpc_controller, SyncCall).Times(0);
+
+  auto txn = NewTransactionImpl(options);
+  EXPECT_EQ(txn->TEST_GetStartTs(), options.snapshot_ts);
+  EXPECT_TRUE(txn->IsReadOnly());
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillOnce([&](Rpc& rpc, std::function<void()> cb) {
+    auto* txn_rpc = dynamic_cast<TxnGetRpc*>(&rpc);
+    CHECK_NOTNULL(txn_rpc);
+
+    EXPECT_EQ(txn_rpc->Request()->key(), "b");
+    EXPECT_EQ(txn_rpc->Request()->start_ts(), options.snapshot_ts);
+
+    txn_rpc->MutableResponse()->set_value("pong");
+    cb();
+  });
+
+  std::string value;
+  EXPECT_TRUE(txn->Get("b", value).ok());
+  EXPECT_EQ(value, "pong");
+
+  EXPECT_TRUE(txn->Put("b", "ping").IsIllegalState());
+  EXPECT_TRUE(txn->BatchPut({{"b", "ping"}}).IsIllegalState());
+  EXPECT_TRUE(txn->PutIfAbsent("b", "ping").IsIllegalState());
+  EXPECT_TRUE(txn->BatchPutIfAbsent({{"b", "ping"}}).IsIllegalState());
+  EXPECT_TRUE(txn->Delete("b").IsIllegalState());
+  EXPECT_TRUE(txn->BatchDelete({"b"}).IsIllegalState());
+
+  // commit sends nothing
+  EXPECT_TRUE(txn->PreCommit().ok());
+  EXPECT_TRUE(txn->Commit().ok());
+  EXPECT_EQ(txn->TEST_GetTransactionState(), TransactionState::kCommitted);
+}
+
+TEST_F(SDKTxnImplTest, ReadOnlyBatchGet) {
+  options.read_only = true;
+  auto txn = NewTransactionImpl(options);
+
+  std::vector<std::string> keys = {"b", "d", "f"};
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(3).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* txn_rpc = dynamic_cast<TxnBatchGetRpc*>(&rpc);
+    CHECK_NOTNULL(txn_rpc);
+
+    EXPECT_EQ(txn_rpc->Request()->start_ts(), txn->TEST_GetStartTs());
+    for (const auto& key : txn_rpc->Request()->keys()) {
+      auto* kv = txn_rpc->MutableResponse()->add_kvs();
+      kv->set_key(key);
+      kv->set_value(key);
+    }
+    cb();
+  });
+
+  std::vector<KVPair> kvs;
+  EXPECT_TRUE(txn->BatchGet(keys, kvs).ok());
+  EXPECT_EQ(kvs.size(), keys.size());
+}
+
+TEST_F(SDKTxnImplTest, ReadOnlyParallelScan) {
+  options.read_only = true;
+  auto txn = NewTransactionImpl(options);
+
+  // every region returns its scan start key
+  EXPECT_CALL(*region_scanner_factory, NewRegionScanner)
+      .Times(3)
+      .WillRepeatedly([&](const ScannerOptions& scan_options, std::shared_ptr<RegionScanner>& scanner) {
+        EXPECT_EQ(scan_options.start_ts.value(), txn->TEST_GetStartTs());
+        auto mock_scanner = std::make_shared<MockRegionScanner>(scan_options.stub, scan_options.region,
+                                                                scan_options.start_key, scan_options.end_key);
+
+        EXPECT_CALL(*mock_scanner, Open).WillOnce(testing::Return(Status::OK()));
+        EXPECT_CALL(*mock_scanner, HasMore).WillOnce(testing::Return(true)).WillRepeatedly(testing::Return(false));
+        std::string start_key = scan_options.start_key;
+        EXPECT_CALL(*mock_scanner, NextBatch).WillOnce([start_key](std::vector<KVPair>& kvs) {
+          kvs.push_back({start_key, "v"});
+          return Status::OK();
+        });
+        EXPECT_CALL(*mock_scanner, Close).Times(1);
+
+        scanner = std::move(mock_scanner);
+        return Status::OK();
+      });
+
+  std::vector<KVPair> kvs;
+  EXPECT_TRUE(txn->Scan("b", "f", 0, kvs).ok());
+  ASSERT_EQ(kvs.size(), 3);
+  EXPECT_EQ(kvs[0].key, "b");
+  EXPECT_EQ(kvs[1].key, "c");
+  EXPECT_EQ(kvs[2].key, "e");
+}
+
 }  // namespace sdk
 }  // namespace dingodb
@@ -12,7 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "sdk/common/common.h"
@@ -489,6 +494,108 @@ TEST_F(SDKTxnLockResolverTest, Rollbacked) {
   EXPECT_TRUE(s.ok());
 }
 
+TEST_F(SDKTxnLockResolverTest, CommittedStatusCached) {
+  // NOTE: careful!!! key and fake_lock primary key in same region
+  std::string key = "b";
+  auto fake_lock = PrepareLockInfo();
+  fake_lock.set_key(key);
+
+  int64_t commit_ts = fake_lock.lock_ts() + 10;
+  txn_status_cache->Put(fake_lock.lock_ts(), TxnStatus(0, commit_ts));
+
+  // neither tso nor check txn status is needed
+  EXPECT_CALL(*meta_rpc_controller, SyncCall).Times(0);
+
+  std::vector<std::string> resolved_keys;
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(2).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* txn_rpc = dynamic_cast<TxnResolveLockRpc*>(&rpc);
+    CHECK_NOTNULL(txn_rpc);
+
+    const auto* request = txn_rpc->Request();
+    EXPECT_EQ(request->start_ts(), fake_lock.lock_ts());
+    EXPECT_EQ(request->commit_ts(), commit_ts);
+    EXPECT_EQ(request->keys_size(), 1);
+    resolved_keys.push_back(request->keys(0));
+
+    cb();
+  });
+
+  Status s = lock_resolver->ResolveLock(fake_lock, Tso2Timestamp(init_tso));
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(resolved_keys, std::vector<std::string>({fake_lock.primary_lock(), key}));
+  EXPECT_EQ(txn_status_cache->Hits(), 1);
+}
+
+TEST_F(SDKTxnLockResolverTest, ResolveLocksBatch) {
+  // same txn locks keys in three regions, duplicate lock info is resolved once
+  auto lock_b = PrepareLockInfo();
+  lock_b.set_key("b");
+  auto lock_b1 = PrepareLockInfo();
+  lock_b1.set_key("b1");
+  auto lock_d = PrepareLockInfo();
+  lock_d.set_key("d");
+  auto lock_f = PrepareLockInfo();
+  lock_f.set_key("f");
+  std::vector<pb::store::LockInfo> lock_infos = {lock_b, lock_d, lock_b1, lock_f, lock_b};
+
+  std::shared_ptr<Region> region_a;
+  CHECK(meta_cache->LookupRegionByKey("b", region_a).IsOK());
+  std::shared_ptr<Region> region_c;
+  CHECK(meta_cache->LookupRegionByKey("d", region_c).IsOK());
+  std::shared_ptr<Region> region_e;
+  CHECK(meta_cache->LookupRegionByKey("f", region_e).IsOK());
+
+  auto fake_tso = CurrentFakeTso();
+
+  EXPECT_CALL(*meta_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<TsoServiceRpc*>(&rpc);
+    auto* ts = t_rpc->MutableResponse()->mutable_start_timestamp();
+    *ts = fake_tso;
+
+    return Status::OK();
+  });
+
+  std::mutex mutex;
+  int check_count = 0;
+  // region id -> resolved keys, in rpc order
+  std::vector<std::pair<int64_t, std::vector<std::string>>> resolved;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    std::lock_guard<std::mutex> guard(mutex);
+    if (auto* check_rpc = dynamic_cast<TxnCheckTxnStatusRpc*>(&rpc); check_rpc != nullptr) {
+      check_count++;
+      EXPECT_EQ(check_rpc->Request()->primary_key(), lock_b.primary_lock());
+      check_rpc->MutableResponse()->set_commit_ts(check_rpc->Request()->current_ts());
+    } else {
+      auto* resolve_rpc = dynamic_cast<TxnResolveLockRpc*>(&rpc);
+      CHECK_NOTNULL(resolve_rpc);
+      const auto* request = resolve_rpc->Request();
+      EXPECT_EQ(request->start_ts(), lock_b.lock_ts());
+      EXPECT_EQ(request->commit_ts(), Tso2Timestamp(fake_tso));
+      std::vector<std::string> keys(request->keys().begin(), request->keys().end());
+      std::sort(keys.begin(), keys.end());
+      resolved.emplace_back(request->context().region_id(), keys);
+    }
+
+    cb();
+  });
+
+  Status s = lock_resolver->ResolveLocks(lock_infos, Tso2Timestamp(init_tso));
+  EXPECT_TRUE(s.ok());
+
+  EXPECT_EQ(check_count, 1);
+  ASSERT_EQ(resolved.size(), 4);
+  // primary key is resolved before others
+  EXPECT_EQ(resolved[0].first, region_a->RegionId());
+  EXPECT_EQ(resolved[0].second, std::vector<std::string>{lock_b.primary_lock()});
+
+  std::sort(resolved.begin() + 1, resolved.end());
+  std::vector<std::pair<int64_t, std::vector<std::string>>> expected = {
+      {region_a->RegionId(), {"b", "b1"}}, {region_c->RegionId(), {"d"}}, {region_e->RegionId(), {"f"}}};
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(std::vector<std::pair<int64_t, std::vector<std::string>>>(resolved.begin() + 1, resolved.end()),
+            expected);
+}
+
 }  // namespace sdk
 
 }  // namespace dingodb
\ No newline at end of file
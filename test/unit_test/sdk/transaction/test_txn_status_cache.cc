@@ -0,0 +1,76 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+
+#include "gtest/gtest.h"
+#include "sdk/transaction/txn_status_cache.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKTxnStatusCacheTest, OnlyFinalStatus) {
+  TxnStatusCache cache(8);
+
+  cache.Put(1, TxnStatus(10, 0));
+  cache.Put(2, TxnStatus(0, 100));
+  cache.Put(3, TxnStatus(0, 0));
+  EXPECT_EQ(cache.Size(), 2);
+
+  TxnStatus status;
+  EXPECT_FALSE(cache.Get(1, status));
+
+  EXPECT_TRUE(cache.Get(2, status));
+  EXPECT_TRUE(status.IsCommitted());
+  EXPECT_EQ(status.commit_ts, 100);
+
+  EXPECT_TRUE(cache.Get(3, status));
+  EXPECT_TRUE(status.IsRollbacked());
+
+  EXPECT_EQ(cache.Hits(), 2);
+  EXPECT_EQ(cache.Misses(), 1);
+}
+
+TEST(SDKTxnStatusCacheTest, EvictLeastRecentlyUsed) {
+  TxnStatusCache cache(2);
+
+  cache.Put(1, TxnStatus(0, 10));
+  cache.Put(2, TxnStatus(0, 20));
+
+  TxnStatus status;
+  // 1 is used recently, 2 is evicted
+  EXPECT_TRUE(cache.Get(1, status));
+  cache.Put(3, TxnStatus(0, 30));
+  EXPECT_EQ(cache.Size(), 2);
+
+  EXPECT_FALSE(cache.Get(2, status));
+  EXPECT_TRUE(cache.Get(1, status));
+  EXPECT_EQ(status.commit_ts, 10);
+  EXPECT_TRUE(cache.Get(3, status));
+  EXPECT_EQ(status.commit_ts, 30);
+}
+
+TEST(SDKTxnStatusCacheTest, Disabled) {
+  TxnStatusCache cache(0);
+  EXPECT_FALSE(cache.Enabled());
+
+  cache.Put(1, TxnStatus(0, 10));
+  EXPECT_EQ(cache.Size(), 0);
+
+  TxnStatus status;
+  EXPECT_FALSE(cache.Get(1, status));
+}
+
+}  // namespace sdk
+}  // namespace dingodb
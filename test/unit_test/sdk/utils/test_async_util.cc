@@ -0,0 +1,58 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "sdk/utils/async_util.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKParallelExecutorTest, ExecuteWithLimitRunsEachTaskOnce) {
+  const uint32_t task_num = 37;
+  std::vector<std::atomic<int>> runs(task_num);
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+
+  ParallelExecutor::ExecuteWithLimit(task_num, 4, [&](uint32_t i) {
+    int now = running.fetch_add(1) + 1;
+    int prev = max_running.load();
+    while (now > prev && !max_running.compare_exchange_weak(prev, now)) {
+    }
+
+    runs[i].fetch_add(1);
+    running.fetch_sub(1);
+  });
+
+  for (uint32_t i = 0; i < task_num; i++) {
+    EXPECT_EQ(runs[i].load(), 1) << "task:" << i;
+  }
+  EXPECT_LE(max_running.load(), 4);
+}
+
+TEST(SDKParallelExecutorTest, ExecuteWithLimitZeroLimit) {
+  std::atomic<int> count{0};
+  ParallelExecutor::ExecuteWithLimit(3, 0, [&](uint32_t) { count.fetch_add(1); });
+  EXPECT_EQ(count.load(), 3);
+
+  ParallelExecutor::ExecuteWithLimit(0, 4, [&](uint32_t) { count.fetch_add(1); });
+  EXPECT_EQ(count.load(), 3);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,138 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "sdk/utils/key_codec.h"
+
+namespace dingodb {
+namespace sdk {
+namespace key_codec {
+
+static std::string EncodeOne(char prefix, int64_t partition_id, int64_t id) {
+  std::string key(kIdKeyLen, '\0');
+  EncodeIdKey(prefix, partition_id, id, key.data());
+  return key;
+}
+
+TEST(SDKKeyCodecTest, EncodeLayout) {
+  std::string key = EncodeOne('r', 0x0102030405060708, 0x1112131415161718);
+
+  const std::string expected("r\x01\x02\x03\x04\x05\x06\x07\x08\x91\x12\x13\x14\x15\x16\x17\x18", kIdKeyLen);
+  EXPECT_EQ(key, expected);
+  EXPECT_EQ(DecodeIdKey(key.data()), 0x1112131415161718);
+  EXPECT_EQ(DecodeIdKeyPartitionId(key.data()), 0x0102030405060708);
+}
+
+TEST(SDKKeyCodecTest, KeyOrderAsId) {
+  std::vector<int64_t> ids = {std::numeric_limits<int64_t>::min(), -100, -1, 0, 1, 255, 256, 1 << 20,
+                              std::numeric_limits<int64_t>::max()};
+  for (size_t i = 1; i < ids.size(); i++) {
+    EXPECT_LT(EncodeOne('r', 5, ids[i - 1]), EncodeOne('r', 5, ids[i])) << ids[i];
+  }
+}
+
+TEST(SDKKeyCodecTest, BatchSameAsSingle) {
+  std::vector<int64_t> ids;
+  // more than one transform block and not a multiple of the simd width
+  for (int64_t i = 0; i < 203; i++) {
+    ids.push_back(i * 7919 - 500);
+  }
+  ids.push_back(std::numeric_limits<int64_t>::min());
+  ids.push_back(std::numeric_limits<int64_t>::max());
+
+  std::string keys(ids.size() * kIdKeyLen, '\0');
+  EncodeIdKeys('r', 66, ids.data(), ids.size(), keys.data());
+
+  for (size_t i = 0; i < ids.size(); i++) {
+    EXPECT_EQ(keys.substr(i * kIdKeyLen, kIdKeyLen), EncodeOne('r', 66, ids[i])) << SimdName() << " " << ids[i];
+  }
+
+  std::vector<int64_t> decoded(ids.size());
+  DecodeIdKeys(keys.data(), ids.size(), decoded.data());
+  EXPECT_EQ(decoded, ids);
+}
+
+TEST(SDKKeyCodecTest, TransformsMatchScalar) {
+  const auto& transforms = SupportedTransforms();
+  ASSERT_FALSE(transforms.empty());
+  EXPECT_STREQ(transforms.front().name, "scalar");
+  EXPECT_STREQ(SimdName(), transforms.back().name);
+
+  std::vector<int64_t> ids;
+  for (int64_t i = 0; i < 11; i++) {
+    ids.push_back(i * 104729 - 3000);
+  }
+  ids.push_back(std::numeric_limits<int64_t>::min());
+  ids.push_back(std::numeric_limits<int64_t>::max());
+
+  std::vector<uint64_t> expected(ids.size());
+  transforms.front().encode(ids.data(), expected.data(), ids.size());
+  for (const auto& transform : transforms) {
+    std::vector<uint64_t> encoded(ids.size());
+    transform.encode(ids.data(), encoded.data(), ids.size());
+    EXPECT_EQ(encoded, expected) << transform.name;
+
+    std::vector<int64_t> decoded(ids.size());
+    transform.decode(encoded.data(), decoded.data(), ids.size());
+    EXPECT_EQ(decoded, ids) << transform.name;
+  }
+}
+
+TEST(SDKKeyCodecTest, IdLowerBound) {
+  const int64_t min = std::numeric_limits<int64_t>::min();
+  const int64_t max = std::numeric_limits<int64_t>::max();
+
+  std::string key = EncodeOne('r', 5, 100);
+  EXPECT_EQ(IdLowerBound(key, 'r', 5), 100);
+  EXPECT_EQ(IdLowerBound(key + "x", 'r', 5), 101);
+  EXPECT_EQ(IdLowerBound(key, 'r', 4), max);
+  EXPECT_EQ(IdLowerBound(key, 'r', 6), min);
+
+  // partition start key
+  EXPECT_EQ(IdLowerBound(key.substr(0, kIdKeyHeaderLen), 'r', 5), min);
+  EXPECT_EQ(IdLowerBound(key.substr(0, kIdKeyHeaderLen), 'r', 4), max);
+  EXPECT_EQ(IdLowerBound("", 'r', 5), min);
+
+  // partial id is padded by zero
+  std::string partial = EncodeOne('r', 5, 0x0102030405060708).substr(0, kIdKeyHeaderLen + 2);
+  EXPECT_EQ(IdLowerBound(partial, 'r', 5), 0x0102000000000000);
+}
+
+TEST(SDKKeyCodecTest, IdKeyBuffer) {
+  std::vector<int64_t> ids = {3, 4, 5};
+
+  IdKeyBuffer buffer;
+  buffer.Append('r', 1, ids.data(), ids.size());
+  buffer.Append('r', 2, 100);
+  ASSERT_EQ(buffer.Size(), 4);
+
+  EXPECT_EQ(buffer.Key(1), EncodeOne('r', 1, 4));
+  EXPECT_EQ(buffer.Key(3), EncodeOne('r', 2, 100));
+  EXPECT_EQ(buffer.Id(2), 5);
+  EXPECT_EQ(buffer.Id(3), 100);
+
+  buffer.Clear();
+  EXPECT_TRUE(buffer.Empty());
+}
+
+}  // namespace key_codec
+}  // namespace sdk
+}  // namespace dingodb
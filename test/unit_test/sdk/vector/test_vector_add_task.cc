@@ -14,8 +14,12 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
 #include "sdk/rpc/coordinator_rpc.h"
 #include "dingosdk/vector.h"
 #include "sdk/vector/vector_add_task.h"
@@ -26,9 +30,24 @@ namespace sdk {
 
 class SDKVectorAddTaskTest : public TestBase {
  public:
-  void SetUp() override {}
+  // background prefetch of auto increment id issue requests not expected by these tests
+  void SetUp() override {
+    prefetch_ratio = FLAGS_auto_incre_prefetch_ratio;
+    FLAGS_auto_incre_prefetch_ratio = 0;
+    op_delay_ms = FLAGS_vector_op_delay_ms;
+    FLAGS_vector_op_delay_ms = 0;
+    op_max_retry = FLAGS_vector_op_max_retry;
+  }
+
+  void TearDown() override {
+    FLAGS_auto_incre_prefetch_ratio = prefetch_ratio;
+    FLAGS_vector_op_delay_ms = op_delay_ms;
+    FLAGS_vector_op_max_retry = op_max_retry;
+  }
 
-  void TearDown() override {}
+  double prefetch_ratio;
+  int64_t op_delay_ms;
+  int64_t op_max_retry;
 };
 
 TEST_F(SDKVectorAddTaskTest, EmptyVectors) {
@@ -205,5 +224,111 @@ TEST_F(SDKVectorAddTaskTest, InitAutoIncreUseGenerateid) {
   }
 }
 
+// one region per partition, region id is 100 + partition id
+static void FillPartitionRegions(MetaCache& meta_cache, const std::shared_ptr<VectorIndex>& vector_index) {
+  const auto& partition = vector_index->GetIndexDefWithId().index_definition().index_partition();
+  for (int i = 0; i < partition.partitions_size(); i++) {
+    pb::common::RegionEpoch epoch;
+    epoch.set_version(1);
+    epoch.set_conf_version(1);
+    meta_cache.MaybeAddRegion(GenRegion(100 + partition.partitions(i).id().entity_id(), partition.partitions(i).range(),
+                                        epoch, pb::common::RegionType::INDEX_REGION));
+  }
+}
+
+static std::vector<VectorWithId> GenFloatVectors(int64_t start_id, int64_t count) {
+  std::vector<VectorWithId> vectors;
+  for (int64_t id = start_id; id < start_id + count; id++) {
+    Vector vector(ValueType::kFloat, 2);
+    vector.float_values = {1.0f * id, 2.0f * id};
+    vectors.emplace_back(id, std::move(vector));
+  }
+  return vectors;
+}
+
+static void ExpectGetIndex(MockCoordinatorRpcController& meta_rpc_controller,
+                           const std::shared_ptr<VectorIndex>& vector_index) {
+  EXPECT_CALL(meta_rpc_controller, SyncCall).WillOnce([vector_index](Rpc& rpc) {
+    auto* t_rpc = dynamic_cast<GetIndexRpc*>(&rpc);
+    *(t_rpc->MutableResponse()->mutable_index_definition_with_id()) = vector_index->GetIndexDefWithId();
+    return Status::OK();
+  });
+}
+
+TEST_F(SDKVectorAddTaskTest, RetryOnlyPendingVectors) {
+  auto vector_index = CreateFakeVectorIndex();
+  ExpectGetIndex(*meta_rpc_controller, vector_index);
+  FillPartitionRegions(*meta_cache, vector_index);
+
+  // ids 1~12 spread over the regions of partition 3, 4 and 5
+  std::vector<VectorWithId> vectors = GenFloatVectors(1, 12);
+
+  std::mutex mutex;
+  std::vector<std::set<int64_t>> sent;
+  bool failed = false;
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* t_rpc = dynamic_cast<VectorAddRpc*>(&rpc);
+    CHECK_NOTNULL(t_rpc);
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      std::set<int64_t> ids;
+      for (const auto& vector : t_rpc->Request()->vectors()) {
+        ids.insert(vector.id());
+      }
+      sent.push_back(std::move(ids));
+
+      // region of partition 4 is not ready in the first round
+      if (t_rpc->Request()->context().region_id() == 104 && !failed) {
+        failed = true;
+        t_rpc->MutableResponse()->mutable_error()->set_errcode(pb::error::EVECTOR_INDEX_NOT_READY);
+      }
+    }
+    cb();
+  });
+
+  VectorAddTask task(*stub, vector_index->GetId(), vectors);
+  Status s = task.Run();
+  EXPECT_TRUE(s.ok()) << s.ToString();
+
+  // first round goes to three regions, the second round only resends the ids of the failed one
+  ASSERT_EQ(sent.size(), 4U);
+  EXPECT_EQ(sent.back(), (std::set<int64_t>{5, 6, 7, 8, 9}));
+}
+
+TEST_F(SDKVectorAddTaskTest, LookupRegionFailNotRetry) {
+  auto vector_index = CreateFakeVectorIndex();
+  ExpectGetIndex(*meta_rpc_controller, vector_index);
+
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).WillOnce([&](Rpc& rpc) {
+    EXPECT_NE(dynamic_cast<ScanRegionsRpc*>(&rpc), nullptr);
+    return Status::NetworkError("mock error");
+  });
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(0);
+
+  std::vector<VectorWithId> vectors = GenFloatVectors(1, 3);
+  VectorAddTask task(*stub, vector_index->GetId(), vectors);
+  Status s = task.Run();
+  EXPECT_TRUE(s.IsNetworkError()) << s.ToString();
+}
+
+TEST_F(SDKVectorAddTaskTest, RegionNotFoundRetry) {
+  auto vector_index = CreateFakeVectorIndex();
+  ExpectGetIndex(*meta_rpc_controller, vector_index);
+  FLAGS_vector_op_max_retry = 3;
+
+  // coordinator knows no region for the key every round
+  EXPECT_CALL(*coordinator_rpc_controller, SyncCall).Times(3).WillRepeatedly([&](Rpc& rpc) {
+    EXPECT_NE(dynamic_cast<ScanRegionsRpc*>(&rpc), nullptr);
+    return Status::OK();
+  });
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(0);
+
+  std::vector<VectorWithId> vectors = GenFloatVectors(1, 3);
+  VectorAddTask task(*stub, vector_index->GetId(), vectors);
+  Status s = task.Run();
+  EXPECT_TRUE(s.IsAborted()) << s.ToString();
+  EXPECT_EQ(s.Errno(), pb::error::EREGION_NOT_FOUND);
+}
+
 }  // namespace sdk
 }  // namespace dingodb
\ No newline at end of file
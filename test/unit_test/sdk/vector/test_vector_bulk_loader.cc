@@ -0,0 +1,216 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dingosdk/status.h"
+#include "gtest/gtest.h"
+#include "sdk/rpc/coordinator_rpc.h"
+#include "sdk/rpc/index_service_rpc.h"
+#include "sdk/vector/vector_bulk_loader.h"
+#include "sdk/vector/vector_common.h"
+#include "sdk/vector/vector_rows.h"
+#include "sdk/vector/vector_search_cache.h"
+#include "test_base.h"
+
+namespace dingodb {
+namespace sdk {
+
+TEST(SDKVectorBulkLoaderTest, WatermarkInOrder) {
+  BulkLoadWatermark watermark;
+  int64_t c0 = watermark.AddChunk(10);
+  int64_t c1 = watermark.AddChunk(5);
+  EXPECT_EQ(watermark.EndOffset(), 15);
+
+  watermark.Ack(c0, 4);
+  EXPECT_EQ(watermark.Watermark(), 0);
+  watermark.Ack(c0, 6);
+  EXPECT_EQ(watermark.Watermark(), 10);
+  watermark.Ack(c1, 5);
+  EXPECT_EQ(watermark.Watermark(), 15);
+}
+
+TEST(SDKVectorBulkLoaderTest, WatermarkOutOfOrder) {
+  BulkLoadWatermark watermark(100);
+  int64_t c0 = watermark.AddChunk(3);
+  int64_t c1 = watermark.AddChunk(3);
+  int64_t c2 = watermark.AddChunk(3);
+
+  // later chunks done first do not move the watermark
+  watermark.Ack(c2, 3);
+  watermark.Ack(c1, 3);
+  EXPECT_EQ(watermark.Watermark(), 100);
+
+  watermark.Ack(c0, 3);
+  EXPECT_EQ(watermark.Watermark(), 109);
+
+  int64_t c3 = watermark.AddChunk(1);
+  EXPECT_EQ(c3, c2 + 1);
+  watermark.Ack(c3, 1);
+  EXPECT_EQ(watermark.Watermark(), 110);
+}
+
+class SDKVectorBulkLoaderCheckpointTest : public ::testing::Test {
+ public:
+  void SetUp() override { path = "./bulk_load_checkpoint_" + std::to_string(getpid()); }
+
+  void TearDown() override { std::remove(path.c_str()); }
+
+  std::string path;
+};
+
+TEST_F(SDKVectorBulkLoaderCheckpointTest, NotFound) {
+  int64_t offset = 0;
+  Status s = ReadBulkLoadCheckpoint(path, 1, offset);
+  EXPECT_TRUE(s.IsNotFound());
+}
+
+TEST_F(SDKVectorBulkLoaderCheckpointTest, WriteAndRead) {
+  EXPECT_TRUE(WriteBulkLoadCheckpoint(path, 7, 1024).ok());
+  EXPECT_TRUE(WriteBulkLoadCheckpoint(path, 7, 4096).ok());
+
+  int64_t offset = 0;
+  Status s = ReadBulkLoadCheckpoint(path, 7, offset);
+  EXPECT_TRUE(s.ok());
+  EXPECT_EQ(offset, 4096);
+}
+
+TEST_F(SDKVectorBulkLoaderCheckpointTest, OtherIndex) {
+  EXPECT_TRUE(WriteBulkLoadCheckpoint(path, 7, 1024).ok());
+
+  int64_t offset = 0;
+  Status s = ReadBulkLoadCheckpoint(path, 8, offset);
+  EXPECT_TRUE(s.IsInvalidArgument());
+}
+
+TEST_F(SDKVectorBulkLoaderCheckpointTest, Corrupted) {
+  {
+    std::ofstream out(path);
+    out << "not a checkpoint";
+  }
+
+  int64_t offset = 0;
+  Status s = ReadBulkLoadCheckpoint(path, 7, offset);
+  EXPECT_TRUE(s.IsCorruption());
+}
+
+class SDKVectorBulkLoaderInitTest : public TestBase {
+ public:
+  void SetUp() override { path = "./bulk_load_init_checkpoint_" + std::to_string(getpid()); }
+
+  void TearDown() override { std::remove(path.c_str()); }
+
+  void ExpectGetIndex(bool auto_increment) {
+    std::vector<int64_t> index_and_part_ids{2, 3};
+    FlatParam flat_param{2, dingodb::sdk::MetricType::kL2};
+
+    pb::meta::IndexDefinitionWithId index_definition_with_id;
+    FillVectorIndexId(index_definition_with_id.mutable_index_id(), index_and_part_ids[0], 2);
+    auto* defination = index_definition_with_id.mutable_index_definition();
+    defination->set_name("test");
+    FillRangePartitionRule(defination->mutable_index_partition(), {}, index_and_part_ids);
+    defination->set_replica(3);
+    if (auto_increment) {
+      defination->set_with_auto_incrment(true);
+      defination->set_auto_increment(1);
+    }
+
+    auto* index_parameter = defination->mutable_index_parameter();
+    index_parameter->set_index_type(pb::common::IndexType::INDEX_TYPE_VECTOR);
+    FillFlatParmeter(index_parameter->mutable_vector_index_parameter(), flat_param);
+
+    EXPECT_CALL(*meta_rpc_controller, SyncCall).WillRepeatedly([index_definition_with_id](Rpc& rpc) {
+      auto* t_rpc = dynamic_cast<GetIndexRpc*>(&rpc);
+      CHECK_NOTNULL(t_rpc);
+      *(t_rpc->MutableResponse()->mutable_index_definition_with_id()) = index_definition_with_id;
+      return Status::OK();
+    });
+
+    pb::common::RegionEpoch epoch;
+    epoch.set_version(1);
+    epoch.set_conf_version(1);
+    meta_cache->MaybeAddRegion(GenRegion(103, defination->index_partition().partitions(0).range(), epoch,
+                                         pb::common::RegionType::INDEX_REGION));
+  }
+
+  std::string path;
+};
+
+TEST_F(SDKVectorBulkLoaderInitTest, AutoIncrementRejectCheckpoint) {
+  ExpectGetIndex(true);
+
+  BulkLoadOption option;
+  option.checkpoint_path = path;
+  VectorBulkLoader::Data data(*stub, 2, option);
+  Status s = data.Init();
+  EXPECT_TRUE(s.IsInvalidArgument()) << s.ToString();
+}
+
+TEST_F(SDKVectorBulkLoaderInitTest, CheckpointWithoutAutoIncrement) {
+  ExpectGetIndex(false);
+
+  BulkLoadOption option;
+  option.checkpoint_path = path;
+  VectorBulkLoader::Data data(*stub, 2, option);
+  Status s = data.Init();
+  EXPECT_TRUE(s.ok()) << s.ToString();
+  EXPECT_EQ(data.ResumeOffset(), 0);
+}
+
+TEST_F(SDKVectorBulkLoaderInitTest, LoadInvalidatesSearchCache) {
+  ExpectGetIndex(false);
+  auto cache = std::make_shared<VectorSearchCache>(1024 * 1024, 60 * 1000, 0);
+  EXPECT_CALL(*stub, GetVectorSearchCache).WillRepeatedly(testing::Return(cache));
+
+  SearchParam param;
+  param.topk = 1;
+  Vector query(ValueType::kFloat, 2);
+  query.float_values = {1.0, 1.0};
+  std::vector<VectorWithDistance> result(1);
+  result[0].vector_data.id = 1;
+  cache->Put(cache->EncodeKey(2, param, query), result);
+  ASSERT_TRUE(cache->Get(cache->EncodeKey(2, param, query), result));
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([](Rpc& rpc, std::function<void()> cb) {
+    CHECK_NOTNULL(dynamic_cast<VectorAddRpc*>(&rpc));
+    cb();
+  });
+
+  BulkLoadOption option;
+  VectorBulkLoader::Data data(*stub, 2, option);
+  ASSERT_TRUE(data.Init().ok());
+
+  std::vector<VectorWithId> vectors;
+  for (int64_t id = 1; id <= 3; id++) {
+    Vector vector(ValueType::kFloat, 2);
+    vector.float_values = {1.0f * id, 1.0f * id};
+    vectors.emplace_back(id, std::move(vector));
+  }
+  VectorRows rows(vectors);
+  ASSERT_TRUE(data.Add(rows).ok());
+  ASSERT_TRUE(data.Flush().ok());
+
+  // the search cached before the load does not hide the loaded vectors
+  EXPECT_FALSE(cache->Get(cache->EncodeKey(2, param, query), result));
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,266 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "dingosdk/vector.h"
+#include "gtest/gtest.h"
+#include "sdk/vector/vector_distance.h"
+
+namespace dingodb {
+namespace sdk {
+
+static const int64_t kDimensions[] = {1, 7, 16, 33, 128, 1000};
+
+template <typename T>
+static std::vector<T> RandomValues(std::mt19937& gen, int64_t size, int lower, int upper) {
+  std::uniform_int_distribution<int> dist(lower, upper);
+  std::vector<T> values(size);
+  for (auto& value : values) {
+    value = static_cast<T>(dist(gen));
+  }
+  return values;
+}
+
+static std::vector<float> RandomFloats(std::mt19937& gen, int64_t size) {
+  std::uniform_real_distribution<float> dist(-1.0, 1.0);
+  std::vector<float> values(size);
+  for (auto& value : values) {
+    value = dist(gen);
+  }
+  return values;
+}
+
+TEST(SDKVectorDistanceTest, SupportedKernels) {
+  const auto& kernels = vector_distance::SupportedKernels();
+  ASSERT_FALSE(kernels.empty());
+  EXPECT_STREQ(kernels.front().name, "scalar");
+  EXPECT_STREQ(vector_distance::SimdName(), kernels.back().name);
+}
+
+TEST(SDKVectorDistanceTest, FloatMatchScalar) {
+  std::mt19937 gen(1);
+  for (const auto& kernel : vector_distance::SupportedKernels()) {
+    for (int64_t dim : kDimensions) {
+      auto x = RandomFloats(gen, dim);
+      auto y = RandomFloats(gen, dim);
+      float tolerance = 1e-4 * dim;
+      EXPECT_NEAR(kernel.l2_sqr(x.data(), y.data(), dim), vector_distance::scalar::L2Sqr(x.data(), y.data(), dim),
+                  tolerance)
+          << kernel.name << " dim: " << dim;
+      EXPECT_NEAR(kernel.inner_product(x.data(), y.data(), dim),
+                  vector_distance::scalar::InnerProduct(x.data(), y.data(), dim), tolerance)
+          << kernel.name << " dim: " << dim;
+    }
+  }
+
+  for (int64_t dim : kDimensions) {
+    auto x = RandomFloats(gen, dim);
+    auto y = RandomFloats(gen, dim);
+    EXPECT_NEAR(vector_distance::Cosine(x.data(), y.data(), dim),
+                vector_distance::scalar::Cosine(x.data(), y.data(), dim), 1e-4);
+  }
+}
+
+TEST(SDKVectorDistanceTest, HammingMatchScalar) {
+  std::mt19937 gen(2);
+  for (const auto& kernel : vector_distance::SupportedKernels()) {
+    for (int64_t bytes : kDimensions) {
+      auto x = RandomValues<uint8_t>(gen, bytes, 0, 255);
+      auto y = RandomValues<uint8_t>(gen, bytes, 0, 255);
+      EXPECT_EQ(kernel.hamming(x.data(), y.data(), bytes), vector_distance::scalar::Hamming(x.data(), y.data(), bytes))
+          << kernel.name << " bytes: " << bytes;
+    }
+  }
+}
+
+// keeps the timed distances from being optimized out
+static volatile float benchmark_sink = 0;
+
+// time distances of query to every base vector, laid out back to back, return nanoseconds per distance
+template <typename T, typename Func>
+static double NsPerDistance(const std::vector<T>& query, const std::vector<T>& base, int64_t dim, int rounds,
+                            Func func) {
+  int64_t count = base.size() / dim;
+  float sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    for (int64_t i = 0; i < count; i++) {
+      sink += func(query.data(), base.data() + i * dim, dim);
+    }
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  benchmark_sink = sink;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / (count * rounds);
+}
+
+static void PrintBenchmark(const char* metric, const char* kernel, int64_t dim, double ns, double scalar_ns) {
+  printf("%-14s %-8s dim %-5lld %9.1f ns  scalar %9.1f ns  speedup %5.2fx\n", metric, kernel,
+         static_cast<long long>(dim), ns, scalar_ns, scalar_ns / ns);
+}
+
+// micro benchmark of every supported kernel against the scalar code, run it with
+// --gtest_also_run_disabled_tests --gtest_filter=*KernelBenchmark
+TEST(SDKVectorDistanceTest, DISABLED_KernelBenchmark) {
+  const int64_t kBaseBytes = 16 * 1024 * 1024;
+  const int kRounds = 5;
+  std::mt19937 gen(3);
+
+  for (int64_t dim : {128, 768, 1536}) {
+    auto query = RandomFloats(gen, dim);
+    auto base = RandomFloats(gen, kBaseBytes / sizeof(float) / dim * dim);
+
+    double l2_scalar = NsPerDistance(query, base, dim, kRounds, vector_distance::scalar::L2Sqr);
+    double ip_scalar = NsPerDistance(query, base, dim, kRounds, vector_distance::scalar::InnerProduct);
+    for (const auto& kernel : vector_distance::SupportedKernels()) {
+      PrintBenchmark("l2", kernel.name, dim, NsPerDistance(query, base, dim, kRounds, kernel.l2_sqr), l2_scalar);
+      PrintBenchmark("inner_product", kernel.name, dim, NsPerDistance(query, base, dim, kRounds, kernel.inner_product),
+                     ip_scalar);
+    }
+
+    // cosine is built on the inner product kernel, only the dispatched one is timed
+    PrintBenchmark("cosine", vector_distance::SimdName(), dim,
+                   NsPerDistance(query, base, dim, kRounds, vector_distance::Cosine),
+                   NsPerDistance(query, base, dim, kRounds, vector_distance::scalar::Cosine));
+  }
+
+  for (int64_t bytes : {16, 128, 512}) {
+    auto query = RandomValues<uint8_t>(gen, bytes, 0, 255);
+    auto base = RandomValues<uint8_t>(gen, kBaseBytes / bytes * bytes, 0, 255);
+
+    double hamming_scalar = NsPerDistance(query, base, bytes, kRounds, vector_distance::scalar::Hamming);
+    for (const auto& kernel : vector_distance::SupportedKernels()) {
+      PrintBenchmark("hamming", kernel.name, bytes * 8, NsPerDistance(query, base, bytes, kRounds, kernel.hamming),
+                     hamming_scalar);
+    }
+  }
+}
+
+TEST(SDKVectorDistanceTest, Known) {
+  float x[] = {1, 2, 3};
+  float y[] = {4, 6, 3};
+  EXPECT_FLOAT_EQ(vector_distance::L2Sqr(x, y, 3), 25);
+  EXPECT_FLOAT_EQ(vector_distance::InnerProduct(x, y, 3), 25);
+  EXPECT_FLOAT_EQ(vector_distance::Cosine(x, x, 3), 1);
+
+  uint8_t a[] = {0xFF, 0x00};
+  uint8_t b[] = {0x0F, 0x01};
+  EXPECT_EQ(vector_distance::Hamming(a, b, 2), 5);
+}
+
+TEST(SDKVectorDistanceTest, Distance) {
+  Vector x(ValueType::kFloat, 2);
+  x.float_values = {1, 0};
+  Vector y(ValueType::kFloat, 2);
+  y.float_values = {0, 1};
+
+  float distance = 0;
+  EXPECT_TRUE(vector_distance::Distance(x, y, MetricType::kL2, distance).ok());
+  EXPECT_FLOAT_EQ(distance, 2);
+  EXPECT_TRUE(vector_distance::Distance(x, y, MetricType::kCosine, distance).ok());
+  EXPECT_FLOAT_EQ(distance, 0);
+  EXPECT_TRUE(vector_distance::Distance(x, y, MetricType::kHamming, distance).IsNotSupported());
+
+  y.float_values.push_back(1);
+  EXPECT_TRUE(vector_distance::Distance(x, y, MetricType::kL2, distance).IsInvalidArgument());
+}
+
+TEST(SDKVectorDistanceTest, BinaryDistance) {
+  // 16 bits packed into 2 bytes
+  Vector x(ValueType::kUint8, 16);
+  x.binary_values = {0xFF, 0x00};
+  Vector y(ValueType::kUint8, 16);
+  y.binary_values = {0x0F, 0x01};
+
+  float distance = 0;
+  EXPECT_TRUE(vector_distance::Distance(x, y, MetricType::kHamming, distance).ok());
+  EXPECT_FLOAT_EQ(distance, 5);
+  EXPECT_TRUE(vector_distance::Distance(x, y, MetricType::kL2, distance).IsNotSupported());
+  EXPECT_TRUE(vector_distance::Distance(x, y, MetricType::kInnerProduct, distance).IsNotSupported());
+}
+
+TEST(SDKVectorDistanceTest, Rerank) {
+  Vector query(ValueType::kFloat, 2);
+  query.float_values = {0, 0};
+
+  std::vector<VectorWithDistance> results(3);
+  std::vector<float> values = {3, 1, 2};
+  for (int i = 0; i < results.size(); i++) {
+    results[i].vector_data.id = i + 1;
+    results[i].vector_data.vector = Vector(ValueType::kFloat, 2);
+    results[i].vector_data.vector.float_values = {values[i], 0};
+    results[i].distance = 0;
+    results[i].metric_type = MetricType::kL2;
+  }
+
+  EXPECT_TRUE(vector_distance::Rerank(query, results).ok());
+  EXPECT_EQ(results[0].vector_data.id, 2);
+  EXPECT_EQ(results[1].vector_data.id, 3);
+  EXPECT_EQ(results[2].vector_data.id, 1);
+  EXPECT_FLOAT_EQ(results[0].distance, 1);
+}
+
+TEST(SDKVectorDistanceTest, RerankInnerProduct) {
+  Vector query(ValueType::kFloat, 2);
+  query.float_values = {1, 0};
+
+  std::vector<VectorWithDistance> results(3);
+  std::vector<float> values = {0.2, 0.9, 0.5};
+  for (int i = 0; i < results.size(); i++) {
+    results[i].vector_data.id = i + 1;
+    results[i].vector_data.vector = Vector(ValueType::kFloat, 2);
+    results[i].vector_data.vector.float_values = {values[i], 0};
+    results[i].distance = 0;
+    results[i].metric_type = MetricType::kInnerProduct;
+  }
+
+  // re-scored as 1 - inner product like store does, the largest product comes first
+  EXPECT_TRUE(vector_distance::Rerank(query, results).ok());
+  EXPECT_EQ(results[0].vector_data.id, 2);
+  EXPECT_EQ(results[1].vector_data.id, 3);
+  EXPECT_EQ(results[2].vector_data.id, 1);
+  EXPECT_FLOAT_EQ(results[0].distance, 0.1);
+}
+
+TEST(SDKVectorDistanceTest, RerankAllOrNone) {
+  Vector query(ValueType::kFloat, 2);
+  query.float_values = {0, 0};
+
+  std::vector<VectorWithDistance> results(3);
+  std::vector<float> values = {3, 1, 2};
+  for (int i = 0; i < results.size(); i++) {
+    results[i].vector_data.id = i + 1;
+    results[i].vector_data.vector = Vector(ValueType::kFloat, 2);
+    results[i].vector_data.vector.float_values = {values[i], 0};
+    results[i].distance = 10.0f + i;
+    results[i].metric_type = MetricType::kL2;
+  }
+  // vector data of the last result is missing
+  results[2].vector_data.vector.float_values.clear();
+
+  // server distances are never mixed with re-scored ones
+  EXPECT_FALSE(vector_distance::Rerank(query, results).ok());
+  for (int i = 0; i < results.size(); i++) {
+    EXPECT_EQ(results[i].vector_data.id, i + 1);
+    EXPECT_FLOAT_EQ(results[i].distance, 10.0f + i);
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
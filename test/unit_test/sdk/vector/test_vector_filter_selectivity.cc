@@ -0,0 +1,239 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dingosdk/status.h"
+#include "dingosdk/vector.h"
+#include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
+#include "sdk/expression/langchain_expr_factory.h"
+#include "sdk/rpc/index_service_rpc.h"
+#include "sdk/vector/vector_common.h"
+#include "sdk/vector/vector_filter_selectivity.h"
+#include "sdk/vector/vector_index.h"
+#include "test_base.h"
+
+namespace dingodb {
+namespace sdk {
+
+static ScalarValue Int64Value(int64_t value) {
+  ScalarValue scalar;
+  scalar.type = kINT64;
+  ScalarField field;
+  field.long_data = value;
+  scalar.fields.push_back(field);
+  return scalar;
+}
+
+static ScalarValue StringValue(const std::string& value) {
+  ScalarValue scalar;
+  scalar.type = kSTRING;
+  ScalarField field;
+  field.string_data = value;
+  scalar.fields.push_back(field);
+  return scalar;
+}
+
+class SDKVectorFilterSelectivityTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    // age 0..99, tag "a" for even age and "b" for odd, every 10th vector without tag
+    for (int64_t i = 0; i < 100; i++) {
+      std::map<std::string, ScalarValue> row;
+      row.emplace("age", Int64Value(i));
+      if (i % 10 != 0) {
+        row.emplace("tag", StringValue(i % 2 == 0 ? "a" : "b"));
+      }
+      sample.rows.push_back(std::move(row));
+    }
+  }
+
+  double Estimate(const std::string& json_str, const std::map<std::string, ScalarField>& params = {}) {
+    std::shared_ptr<expression::LangchainExpr> expr;
+    expression::LangchainExprFactory factory;
+    Status s = factory.CreateExpr(json_str, expr);
+    EXPECT_TRUE(s.ok()) << s.ToString();
+    return EstimateSelectivity(sample, expr.get(), params);
+  }
+
+  ScalarSample sample;
+};
+
+TEST_F(SDKVectorFilterSelectivityTest, Comparator) {
+  EXPECT_DOUBLE_EQ(
+      Estimate(R"({"type": "comparator", "comparator": "lt", "attribute": "age", "value": 25, "value_type": "INT64"})"),
+      0.25);
+  EXPECT_DOUBLE_EQ(
+      Estimate(R"({"type": "comparator", "comparator": "gte", "attribute": "age", "value": 89.5,
+                   "value_type": "DOUBLE"})"),
+      0.10);
+  // vectors without tag never match
+  EXPECT_DOUBLE_EQ(
+      Estimate(R"({"type": "comparator", "comparator": "eq", "attribute": "tag", "value": "a",
+                   "value_type": "STRING"})"),
+      0.40);
+  EXPECT_DOUBLE_EQ(
+      Estimate(R"({"type": "comparator", "comparator": "eq", "attribute": "none", "value": 1, "value_type": "INT64"})"),
+      0.0);
+}
+
+TEST_F(SDKVectorFilterSelectivityTest, Operator) {
+  std::string json_str = R"({
+      "type": "operator",
+      "operator": "and",
+      "arguments": [
+        {"type": "comparator", "comparator": "eq", "attribute": "tag", "value": "b", "value_type": "STRING"},
+        {"type": "operator", "operator": "not", "arguments": [
+          {"type": "comparator", "comparator": "gte", "attribute": "age", "value": 50, "value_type": "INT64"}
+        ]}
+      ]
+    })";
+  EXPECT_DOUBLE_EQ(Estimate(json_str), 0.25);
+}
+
+TEST_F(SDKVectorFilterSelectivityTest, Param) {
+  std::string json_str = R"({"type": "comparator", "comparator": "lt", "attribute": "age", "value": {"param": "p"},
+                             "value_type": "INT64"})";
+  ScalarField field;
+  field.long_data = 5;
+  EXPECT_DOUBLE_EQ(Estimate(json_str, {{"p", field}}), 0.05);
+
+  // unbound param never matches
+  EXPECT_DOUBLE_EQ(Estimate(json_str), 0.0);
+}
+
+TEST(SDKVectorFilterPlanTest, PlanFilter) {
+  int64_t origin = FLAGS_vector_filter_auto_max_overfetch;
+  FLAGS_vector_filter_auto_max_overfetch = 10;
+
+  FilterPlan plan = PlanFilter(1.0, 10);
+  EXPECT_EQ(plan.filter_type, kQueryPost);
+  EXPECT_EQ(plan.top_n, 10);
+
+  plan = PlanFilter(0.3, 10);
+  EXPECT_EQ(plan.filter_type, kQueryPost);
+  EXPECT_EQ(plan.top_n, 40);
+
+  plan = PlanFilter(0.1, 10);
+  EXPECT_EQ(plan.filter_type, kQueryPost);
+  EXPECT_EQ(plan.top_n, 100);
+
+  plan = PlanFilter(0.05, 10);
+  EXPECT_EQ(plan.filter_type, kQueryPre);
+  EXPECT_EQ(plan.top_n, 10);
+
+  // nothing matched or empty sample
+  plan = PlanFilter(0.0, 10);
+  EXPECT_EQ(plan.filter_type, kQueryPre);
+  plan = PlanFilter(-1.0, 10);
+  EXPECT_EQ(plan.filter_type, kQueryPre);
+  EXPECT_EQ(plan.top_n, 10);
+
+  FLAGS_vector_filter_auto_max_overfetch = origin;
+}
+
+class SDKScalarSampleTest : public TestBase {
+ public:
+  void SetUp() override {
+    sample_ttl_s = FLAGS_vector_filter_sample_ttl_s;
+
+    // one partition of part id 3 served by region 103
+    std::vector<int64_t> index_and_part_ids{2, 3};
+    FlatParam flat_param{2, dingodb::sdk::MetricType::kL2};
+    pb::meta::IndexDefinitionWithId index_definition_with_id;
+    FillVectorIndexId(index_definition_with_id.mutable_index_id(), index_and_part_ids[0], 2);
+    auto* defination = index_definition_with_id.mutable_index_definition();
+    defination->set_name("test");
+    FillRangePartitionRule(defination->mutable_index_partition(), {}, index_and_part_ids);
+    defination->set_replica(3);
+    auto* index_parameter = defination->mutable_index_parameter();
+    index_parameter->set_index_type(pb::common::IndexType::INDEX_TYPE_VECTOR);
+    FillFlatParmeter(index_parameter->mutable_vector_index_parameter(), flat_param);
+    vector_index = std::make_shared<VectorIndex>(index_definition_with_id);
+
+    pb::common::RegionEpoch epoch;
+    epoch.set_version(1);
+    epoch.set_conf_version(1);
+    meta_cache->MaybeAddRegion(GenRegion(103, defination->index_partition().partitions(0).range(), epoch,
+                                         pb::common::RegionType::INDEX_REGION));
+  }
+
+  void TearDown() override { FLAGS_vector_filter_sample_ttl_s = sample_ttl_s; }
+
+  // wait until the sample of the index is not old_sample
+  std::shared_ptr<const ScalarSample> WaitSample(const std::shared_ptr<const ScalarSample>& old_sample) {
+    for (int i = 0; i < 200; i++) {
+      auto sample = vector_index->GetScalarSample();
+      if (sample != nullptr && sample != old_sample) {
+        return sample;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return nullptr;
+  }
+
+  std::shared_ptr<VectorIndex> vector_index;
+  int64_t sample_ttl_s;
+};
+
+TEST_F(SDKScalarSampleTest, SingleFlightInBackground) {
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic<int> rpc_count{0};
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* t_rpc = dynamic_cast<VectorScanQueryRpc*>(&rpc);
+    CHECK_NOTNULL(t_rpc);
+    rpc_count.fetch_add(1);
+    released.wait();
+    auto* vector = t_rpc->MutableResponse()->add_vectors();
+    vector->set_id(1);
+    vector->mutable_vector()->set_value_type(pb::common::ValueType::FLOAT);
+    cb();
+  });
+
+  // searches do not wait for the sampling and only one sampling runs
+  for (int i = 0; i < 5; i++) {
+    std::shared_ptr<const ScalarSample> sample;
+    EXPECT_TRUE(GetScalarSample(*stub, vector_index, sample).IsNotFound());
+  }
+  release.set_value();
+
+  auto first = WaitSample(nullptr);
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(first->rows.size(), 1);
+  EXPECT_EQ(rpc_count.load(), 1);
+
+  // a stale sample is served while it is sampled again
+  FLAGS_vector_filter_sample_ttl_s = 0;
+  std::shared_ptr<const ScalarSample> sample;
+  EXPECT_TRUE(GetScalarSample(*stub, vector_index, sample).ok());
+  EXPECT_EQ(sample, first);
+
+  auto second = WaitSample(first);
+  ASSERT_NE(second, nullptr);
+  EXPECT_EQ(rpc_count.load(), 2);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
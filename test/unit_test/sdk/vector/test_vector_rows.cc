@@ -0,0 +1,121 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <cstdint>
+#include <vector>
+
+#include "dingosdk/vector.h"
+#include "gtest/gtest.h"
+#include "sdk/vector/vector_rows.h"
+
+namespace dingodb {
+namespace sdk {
+
+static VectorBatch CreateFloatBatch(int64_t rows, int32_t dimension) {
+  VectorBatch batch(ValueType::kFloat, dimension);
+  for (int64_t i = 0; i < rows; i++) {
+    batch.ids.push_back(i + 1);
+    for (int32_t j = 0; j < dimension; j++) {
+      batch.float_values.push_back(i * dimension + j);
+    }
+  }
+
+  ScalarColumn column(kINT64);
+  for (int64_t i = 0; i < rows; i++) {
+    column.long_data.push_back(i * 10);
+  }
+  batch.scalar_columns.emplace("age", std::move(column));
+
+  return batch;
+}
+
+TEST(SDKVectorRowsTest, CheckBatch) {
+  VectorBatch batch = CreateFloatBatch(4, 8);
+  VectorRows rows(batch);
+  EXPECT_TRUE(rows.Check().ok());
+  EXPECT_EQ(rows.Size(), 4);
+
+  batch.float_values.pop_back();
+  EXPECT_TRUE(rows.Check().IsInvalidArgument());
+
+  batch = CreateFloatBatch(4, 8);
+  batch.ids.pop_back();
+  EXPECT_TRUE(rows.Check().IsInvalidArgument());
+
+  batch = CreateFloatBatch(4, 8);
+  batch.scalar_columns["age"].long_data.pop_back();
+  EXPECT_TRUE(rows.Check().IsInvalidArgument());
+
+  batch = CreateFloatBatch(4, 8);
+  batch.ids.clear();
+  EXPECT_TRUE(rows.Check().ok());
+  EXPECT_EQ(rows.GetId(0), 0);
+}
+
+TEST(SDKVectorRowsTest, FillFloatBatch) {
+  VectorBatch batch = CreateFloatBatch(3, 4);
+  VectorRows rows(batch);
+
+  pb::common::VectorWithId pb;
+  rows.FillVectorWithIdPB(&pb, 2);
+
+  EXPECT_EQ(pb.id(), 3);
+  EXPECT_EQ(pb.vector().dimension(), 4);
+  EXPECT_EQ(pb.vector().value_type(), pb::common::ValueType::FLOAT);
+  ASSERT_EQ(pb.vector().float_values_size(), 4);
+  for (int32_t j = 0; j < 4; j++) {
+    EXPECT_EQ(pb.vector().float_values(j), 2 * 4 + j);
+  }
+
+  const auto& scalar = pb.scalar_data().scalar_data().at("age");
+  EXPECT_EQ(scalar.field_type(), pb::common::ScalarFieldType::INT64);
+  ASSERT_EQ(scalar.fields_size(), 1);
+  EXPECT_EQ(scalar.fields(0).long_data(), 20);
+
+  Vector vector = rows.GetVector(1);
+  EXPECT_EQ(vector.float_values, std::vector<float>({4, 5, 6, 7}));
+}
+
+TEST(SDKVectorRowsTest, FillBinaryBatch) {
+  VectorBatch batch(ValueType::kUint8, 16);
+  batch.binary_values = {1, 2, 3, 4};
+  VectorRows rows(batch);
+  EXPECT_TRUE(rows.Check().ok());
+  EXPECT_EQ(rows.Size(), 2);
+
+  pb::common::VectorWithId pb;
+  rows.FillVectorWithIdPB(&pb, 1, false);
+  EXPECT_EQ(pb.id(), 0);
+  ASSERT_EQ(pb.vector().binary_values_size(), 2);
+  EXPECT_EQ(static_cast<uint8_t>(pb.vector().binary_values(0)[0]), 3);
+  EXPECT_EQ(static_cast<uint8_t>(pb.vector().binary_values(1)[0]), 4);
+}
+
+TEST(SDKVectorRowsTest, SetIds) {
+  std::vector<VectorWithId> vectors(3);
+  VectorRows rows(vectors);
+  rows.SetIds({7, 8, 9});
+  EXPECT_EQ(vectors[0].id, 7);
+  EXPECT_EQ(rows.GetId(2), 9);
+
+  VectorBatch batch = CreateFloatBatch(3, 2);
+  batch.ids.clear();
+  VectorRows batch_rows(batch);
+  batch_rows.SetIds({7, 8, 9});
+  EXPECT_EQ(batch.ids, std::vector<int64_t>({7, 8, 9}));
+}
+
+}  // namespace sdk
+}  // namespace dingodb
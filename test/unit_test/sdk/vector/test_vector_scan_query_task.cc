@@ -0,0 +1,273 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dingosdk/vector.h"
+#include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/coordinator_rpc.h"
+#include "sdk/rpc/index_service_rpc.h"
+#include "sdk/vector/vector_common.h"
+#include "sdk/vector/vector_scan_query_task.h"
+#include "test_base.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKVectorScanQueryPageTaskTest : public TestBase {
+ public:
+  void SetUp() override {
+    parallel_regions = FLAGS_scan_query_page_parallel_regions;
+    FLAGS_scan_query_page_parallel_regions = 2;
+
+    vector_index = CreateFakeVectorIndex();
+    EXPECT_CALL(*meta_rpc_controller, SyncCall).WillRepeatedly([this](Rpc& rpc) {
+      auto* t_rpc = dynamic_cast<GetIndexRpc*>(&rpc);
+      CHECK_NOTNULL(t_rpc);
+      *(t_rpc->MutableResponse()->mutable_index_definition_with_id()) = vector_index->GetIndexDefWithId();
+      return Status::OK();
+    });
+
+    // one region per partition, region id is 100 + partition id
+    const auto& partition = vector_index->GetIndexDefWithId().index_definition().index_partition();
+    for (int i = 0; i < partition.partitions_size(); i++) {
+      pb::common::RegionEpoch epoch;
+      epoch.set_version(1);
+      epoch.set_conf_version(1);
+      meta_cache->MaybeAddRegion(GenRegion(100 + partition.partitions(i).id().entity_id(),
+                                           partition.partitions(i).range(), epoch,
+                                           pb::common::RegionType::INDEX_REGION));
+    }
+
+    EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([this](Rpc& rpc, std::function<void()> cb) {
+      auto* t_rpc = dynamic_cast<VectorScanQueryRpc*>(&rpc);
+      CHECK_NOTNULL(t_rpc);
+      FillScanQueryResponse(*t_rpc);
+      cb();
+    });
+  }
+
+  void TearDown() override { FLAGS_scan_query_page_parallel_regions = parallel_regions; }
+
+  // partitions 3, 4, 5, 6 own ids [0, 5), [5, 10), [10, 20), [20, max)
+  static std::shared_ptr<VectorIndex> CreateFakeVectorIndex() {
+    std::vector<int64_t> index_and_part_ids{2, 3, 4, 5, 6};
+    std::vector<int64_t> range_seperator_ids = {5, 10, 20};
+    FlatParam flat_param{2, dingodb::sdk::MetricType::kL2};
+
+    pb::meta::IndexDefinitionWithId index_definition_with_id;
+    FillVectorIndexId(index_definition_with_id.mutable_index_id(), index_and_part_ids[0], 2);
+    auto* defination = index_definition_with_id.mutable_index_definition();
+    defination->set_name("test");
+    FillRangePartitionRule(defination->mutable_index_partition(), range_seperator_ids, index_and_part_ids);
+    defination->set_replica(3);
+
+    auto* index_parameter = defination->mutable_index_parameter();
+    index_parameter->set_index_type(pb::common::IndexType::INDEX_TYPE_VECTOR);
+    FillFlatParmeter(index_parameter->mutable_vector_index_parameter(), flat_param);
+
+    return std::make_shared<VectorIndex>(index_definition_with_id);
+  }
+
+  // a region scans its ids from vector_id_start in scan order, bounded by vector_id_end and max_scan_count. with scalar
+  // filter only even ids match and a region stops after kFilterScanRows rows like a store bounding its scan work.
+  void FillScanQueryResponse(VectorScanQueryRpc& rpc) {
+    const auto* request = rpc.Request();
+    int64_t part_id = request->context().region_id() - 100;
+    static const std::map<int64_t, std::pair<int64_t, int64_t>> kPartRanges = {
+        {3, {0, 5}}, {4, {5, 10}}, {5, {10, 20}}, {6, {20, INT64_MAX}}};
+    const auto& [lo, hi] = kPartRanges.at(part_id);
+
+    std::vector<int64_t> ids;
+    for (int64_t id : store_ids) {
+      if (id < lo || id >= hi) {
+        continue;
+      }
+      if (request->is_reverse_scan()) {
+        if (id <= request->vector_id_start() && id >= request->vector_id_end()) {
+          ids.push_back(id);
+        }
+      } else if (id >= request->vector_id_start() &&
+                 (request->vector_id_end() == 0 || id <= request->vector_id_end())) {
+        ids.push_back(id);
+      }
+    }
+    if (request->is_reverse_scan()) {
+      std::reverse(ids.begin(), ids.end());
+    }
+
+    int64_t scanned = 0;
+    int64_t returned = 0;
+    for (int64_t id : ids) {
+      if (returned >= request->max_scan_count()) {
+        break;
+      }
+      if (request->use_scalar_filter()) {
+        if (scanned++ >= kFilterScanRows) {
+          break;
+        }
+        if (id % 2 != 0) {
+          continue;
+        }
+      }
+      auto* vector = rpc.MutableResponse()->add_vectors();
+      vector->set_id(id);
+      vector->mutable_vector()->set_value_type(pb::common::ValueType::FLOAT);
+      returned++;
+    }
+  }
+
+  // scan every page from page_token, return the ids of each page and the number of pages
+  std::vector<int64_t> ScanAll(const ScanQueryParam& param, std::string page_token, int64_t& page_count) {
+    std::vector<int64_t> ids;
+    page_count = 0;
+    do {
+      ScanQueryResult result;
+      std::string next_page_token;
+      VectorScanQueryPageTask task(*stub, vector_index->GetId(), param, page_token, result, next_page_token);
+      Status s = task.Run();
+      EXPECT_TRUE(s.ok()) << s.ToString();
+      if (!s.ok()) {
+        break;
+      }
+
+      EXPECT_LE(result.vectors.size(), param.max_scan_count);
+      // a token always leads to a non-empty page
+      if (!page_token.empty()) {
+        EXPECT_FALSE(result.vectors.empty());
+      }
+      for (const auto& vector : result.vectors) {
+        ids.push_back(vector.id);
+      }
+      page_count++;
+      page_token = next_page_token;
+    } while (!page_token.empty() && page_count < 100);
+    return ids;
+  }
+
+  static constexpr int64_t kFilterScanRows = 2;
+
+  std::shared_ptr<VectorIndex> vector_index;
+  std::set<int64_t> store_ids;
+  int64_t parallel_regions;
+};
+
+TEST_F(SDKVectorScanQueryPageTaskTest, Forward) {
+  store_ids = {1, 2, 3, 7, 8, 12, 25};
+
+  ScanQueryParam param;
+  param.vector_id_start = 1;
+  param.max_scan_count = 3;
+
+  ScanQueryResult result;
+  std::string next_page_token;
+  VectorScanQueryPageTask task(*stub, vector_index->GetId(), param, "", result, next_page_token);
+  Status s = task.Run();
+  ASSERT_TRUE(s.ok()) << s.ToString();
+  ASSERT_EQ(result.vectors.size(), 3);
+  EXPECT_EQ(result.vectors[0].id, 1);
+  EXPECT_EQ(result.vectors[2].id, 3);
+  EXPECT_EQ(next_page_token, "7");
+
+  int64_t page_count = 0;
+  EXPECT_EQ(ScanAll(param, "", page_count), std::vector<int64_t>({1, 2, 3, 7, 8, 12, 25}));
+  EXPECT_EQ(page_count, 3);
+}
+
+TEST_F(SDKVectorScanQueryPageTaskTest, Reverse) {
+  store_ids = {1, 2, 3, 7, 8, 12, 25};
+
+  ScanQueryParam param;
+  param.vector_id_start = 30;
+  param.vector_id_end = 2;
+  param.is_reverse = true;
+  param.max_scan_count = 2;
+
+  int64_t page_count = 0;
+  EXPECT_EQ(ScanAll(param, "", page_count), std::vector<int64_t>({25, 12, 8, 7, 3, 2}));
+  EXPECT_EQ(page_count, 3);
+}
+
+TEST_F(SDKVectorScanQueryPageTaskTest, ResumeFromToken) {
+  store_ids = {1, 2, 3, 7, 8, 12, 25};
+
+  ScanQueryParam param;
+  param.vector_id_start = 1;
+  param.vector_id_end = 20;
+  param.max_scan_count = 10;
+
+  int64_t page_count = 0;
+  EXPECT_EQ(ScanAll(param, "7", page_count), std::vector<int64_t>({7, 8, 12}));
+  EXPECT_EQ(page_count, 1);
+
+  ScanQueryResult result;
+  std::string next_page_token;
+  VectorScanQueryPageTask task(*stub, vector_index->GetId(), param, "bad", result, next_page_token);
+  EXPECT_TRUE(task.Run().IsInvalidArgument());
+}
+
+TEST_F(SDKVectorScanQueryPageTaskTest, ExactlyFullLastPage) {
+  store_ids = {1, 2, 3, 7};
+
+  ScanQueryParam param;
+  param.vector_id_start = 1;
+  param.max_scan_count = 2;
+
+  // the last page is full and ends the scan, no token to an empty page
+  int64_t page_count = 0;
+  EXPECT_EQ(ScanAll(param, "", page_count), std::vector<int64_t>({1, 2, 3, 7}));
+  EXPECT_EQ(page_count, 2);
+
+  param.max_scan_count = 4;
+  ScanQueryResult result;
+  std::string next_page_token;
+  VectorScanQueryPageTask task(*stub, vector_index->GetId(), param, "", result, next_page_token);
+  Status s = task.Run();
+  ASSERT_TRUE(s.ok()) << s.ToString();
+  EXPECT_EQ(result.vectors.size(), 4);
+  EXPECT_TRUE(next_page_token.empty());
+}
+
+TEST_F(SDKVectorScanQueryPageTaskTest, ScalarFilterShortRegion) {
+  // every region returns fewer vectors than asked before its end, the scan must go on in the same region
+  store_ids = {1, 2, 3, 4, 6, 7, 8, 9, 12, 14, 25, 26};
+
+  ScanQueryParam param;
+  param.vector_id_start = 1;
+  param.max_scan_count = 3;
+  param.use_scalar_filter = true;
+
+  int64_t page_count = 0;
+  EXPECT_EQ(ScanAll(param, "", page_count), std::vector<int64_t>({2, 4, 6, 8, 12, 14, 26}));
+  EXPECT_EQ(page_count, 3);
+
+  param.vector_id_start = 30;
+  param.vector_id_end = 1;
+  param.is_reverse = true;
+  EXPECT_EQ(ScanAll(param, "", page_count), std::vector<int64_t>({26, 14, 12, 8, 6, 4, 2}));
+  EXPECT_EQ(page_count, 3);
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,135 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "dingosdk/vector.h"
+#include "gtest/gtest.h"
+#include "sdk/vector/vector_search_cache.h"
+
+namespace dingodb {
+namespace sdk {
+
+static Vector CreateQuery(std::vector<float> values) {
+  Vector vector(ValueType::kFloat, values.size());
+  vector.float_values = std::move(values);
+  return vector;
+}
+
+static std::vector<VectorWithDistance> CreateResult(int64_t id) {
+  std::vector<VectorWithDistance> result(1);
+  result[0].vector_data.id = id;
+  result[0].distance = 1.0;
+  return result;
+}
+
+TEST(SDKVectorSearchCacheTest, HitAndQuantize) {
+  VectorSearchCache cache(1024 * 1024, 60 * 1000, 1e-3);
+  SearchParam param;
+  param.topk = 10;
+
+  std::string key = cache.EncodeKey(1, param, CreateQuery({0.1, 0.2}));
+  std::vector<VectorWithDistance> result;
+  EXPECT_FALSE(cache.Get(key, result));
+
+  cache.Put(key, CreateResult(7));
+  EXPECT_TRUE(cache.Get(cache.EncodeKey(1, param, CreateQuery({0.1, 0.2001})), result));
+  ASSERT_EQ(result.size(), 1);
+  EXPECT_EQ(result[0].vector_data.id, 7);
+
+  EXPECT_FALSE(cache.Get(cache.EncodeKey(1, param, CreateQuery({0.1, 0.3})), result));
+  EXPECT_FALSE(cache.Get(cache.EncodeKey(2, param, CreateQuery({0.1, 0.2})), result));
+  param.topk = 5;
+  EXPECT_FALSE(cache.Get(cache.EncodeKey(1, param, CreateQuery({0.1, 0.2})), result));
+
+  SearchCacheStats stats;
+  cache.GetStats(stats);
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 4);
+  EXPECT_EQ(stats.entries, 1);
+}
+
+TEST(SDKVectorSearchCacheTest, ExactWithoutQuantize) {
+  VectorSearchCache cache(1024 * 1024, 60 * 1000, 0);
+  SearchParam param;
+
+  // values which round to the same integer are still different queries
+  std::string key = cache.EncodeKey(1, param, CreateQuery({0.1, 0.2}));
+  EXPECT_NE(key, cache.EncodeKey(1, param, CreateQuery({0.1, 0.2001})));
+  EXPECT_NE(key, cache.EncodeKey(1, param, CreateQuery({0.3, 0.4})));
+  EXPECT_EQ(key, cache.EncodeKey(1, param, CreateQuery({0.1, 0.2})));
+  EXPECT_EQ(cache.EncodeKey(1, param, CreateQuery({0.0})), cache.EncodeKey(1, param, CreateQuery({-0.0})));
+}
+
+TEST(SDKVectorSearchCacheTest, QuantizeOverflow) {
+  VectorSearchCache cache(1024 * 1024, 60 * 1000, 1e-30);
+  SearchParam param;
+
+  // quantized values out of the int64 range fall back to exact values instead of overflow
+  float inf = std::numeric_limits<float>::infinity();
+  EXPECT_NE(cache.EncodeKey(1, param, CreateQuery({1e10})), cache.EncodeKey(1, param, CreateQuery({2e10})));
+  EXPECT_NE(cache.EncodeKey(1, param, CreateQuery({-1e10})), cache.EncodeKey(1, param, CreateQuery({1e10})));
+  EXPECT_NE(cache.EncodeKey(1, param, CreateQuery({inf})), cache.EncodeKey(1, param, CreateQuery({-inf})));
+  EXPECT_EQ(cache.EncodeKey(1, param, CreateQuery({1e10})), cache.EncodeKey(1, param, CreateQuery({1e10})));
+}
+
+TEST(SDKVectorSearchCacheTest, Invalidate) {
+  VectorSearchCache cache(1024 * 1024, 60 * 1000, 1e-6);
+  SearchParam param;
+  std::string key = cache.EncodeKey(1, param, CreateQuery({1.0}));
+  cache.Put(key, CreateResult(1));
+
+  cache.Invalidate(2);
+  std::vector<VectorWithDistance> result;
+  EXPECT_TRUE(cache.Get(cache.EncodeKey(1, param, CreateQuery({1.0})), result));
+
+  cache.Invalidate(1);
+  EXPECT_FALSE(cache.Get(cache.EncodeKey(1, param, CreateQuery({1.0})), result));
+}
+
+TEST(SDKVectorSearchCacheTest, Ttl) {
+  VectorSearchCache cache(1024 * 1024, 0, 1e-6);
+  SearchParam param;
+  std::string key = cache.EncodeKey(1, param, CreateQuery({1.0}));
+  cache.Put(key, CreateResult(1));
+
+  std::vector<VectorWithDistance> result;
+  EXPECT_FALSE(cache.Get(key, result));
+}
+
+TEST(SDKVectorSearchCacheTest, EvictLru) {
+  VectorSearchCache cache(2048, 60 * 1000, 1e-6);
+  SearchParam param;
+  std::vector<std::string> keys;
+  for (int i = 0; i < 64; i++) {
+    keys.push_back(cache.EncodeKey(1, param, CreateQuery({static_cast<float>(i)})));
+    cache.Put(keys.back(), CreateResult(i));
+  }
+
+  SearchCacheStats stats;
+  cache.GetStats(stats);
+  EXPECT_LE(stats.bytes, 2048);
+  EXPECT_LT(stats.entries, 64);
+
+  std::vector<VectorWithDistance> result;
+  EXPECT_TRUE(cache.Get(keys.back(), result));
+  EXPECT_FALSE(cache.Get(keys.front(), result));
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,156 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "dingosdk/vector.h"
+#include "gtest/gtest.h"
+#include "sdk/vector/vector_rows.h"
+#include "sdk/vector/vector_search_coalescer.h"
+
+namespace dingodb {
+namespace sdk {
+
+static std::vector<VectorWithId> CreateQueries(float value, int64_t count) {
+  std::vector<VectorWithId> queries;
+  for (int64_t i = 0; i < count; i++) {
+    Vector vector(ValueType::kFloat, 1);
+    vector.float_values.push_back(value + i);
+    queries.emplace_back(std::move(vector));
+  }
+  return queries;
+}
+
+// echo the first float of each query as the distance of its only result
+static Status EchoSearch(const std::vector<VectorWithId>& target_vectors, std::vector<SearchResult>& out_result) {
+  for (const auto& target : target_vectors) {
+    SearchResult result(target);
+    result.vector_datas.resize(1);
+    result.vector_datas[0].distance = target.vector.float_values[0];
+    out_result.push_back(std::move(result));
+  }
+  return Status::OK();
+}
+
+TEST(SDKVectorSearchCoalescerTest, MergeConcurrentSearch) {
+  const int kCallers = 8;
+  VectorSearchCoalescer coalescer(10 * 1000 * 1000, kCallers * 2);
+  SearchParam param;
+  param.topk = 10;
+
+  std::atomic<int> calls{0};
+  std::atomic<int> merged_vectors{0};
+  auto search_func = [&](const std::vector<VectorWithId>& target_vectors, std::vector<SearchResult>& out_result) {
+    calls++;
+    merged_vectors += target_vectors.size();
+    return EchoSearch(target_vectors, out_result);
+  };
+
+  std::vector<std::thread> threads;
+  std::vector<Status> statuses(kCallers);
+  std::vector<std::vector<SearchResult>> results(kCallers);
+  for (int i = 0; i < kCallers; i++) {
+    threads.emplace_back([&, i] {
+      auto queries = CreateQueries(i * 100, 2);
+      statuses[i] = coalescer.Search(1, param, VectorRows(queries), results[i], search_func);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // the batch is sealed by max_batch, not by the long window
+  EXPECT_EQ(calls.load(), 1);
+  EXPECT_EQ(merged_vectors.load(), kCallers * 2);
+  for (int i = 0; i < kCallers; i++) {
+    ASSERT_TRUE(statuses[i].ok()) << statuses[i].ToString();
+    ASSERT_EQ(results[i].size(), 2);
+    EXPECT_EQ(results[i][0].vector_datas[0].distance, i * 100);
+    EXPECT_EQ(results[i][1].vector_datas[0].distance, i * 100 + 1);
+  }
+}
+
+TEST(SDKVectorSearchCoalescerTest, WindowExpire) {
+  VectorSearchCoalescer coalescer(200, 64);
+  SearchParam param;
+
+  auto queries = CreateQueries(3, 1);
+  std::vector<SearchResult> results;
+  Status s = coalescer.Search(1, param, VectorRows(queries), results, EchoSearch);
+  ASSERT_TRUE(s.ok()) << s.ToString();
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(results[0].vector_datas[0].distance, 3);
+}
+
+TEST(SDKVectorSearchCoalescerTest, DifferentParamNotMerged) {
+  VectorSearchCoalescer coalescer(50 * 1000, 64);
+  SearchParam param1;
+  param1.topk = 10;
+  SearchParam param2;
+  param2.topk = 20;
+
+  std::atomic<int> calls{0};
+  auto search_func = [&](const std::vector<VectorWithId>& target_vectors, std::vector<SearchResult>& out_result) {
+    calls++;
+    return EchoSearch(target_vectors, out_result);
+  };
+
+  std::vector<SearchResult> results1;
+  std::vector<SearchResult> results2;
+  std::thread thread([&] {
+    auto queries = CreateQueries(1, 1);
+    EXPECT_TRUE(coalescer.Search(1, param1, VectorRows(queries), results1, search_func).ok());
+  });
+  auto queries = CreateQueries(2, 1);
+  EXPECT_TRUE(coalescer.Search(1, param2, VectorRows(queries), results2, search_func).ok());
+  thread.join();
+
+  EXPECT_EQ(calls.load(), 2);
+  ASSERT_EQ(results1.size(), 1);
+  ASSERT_EQ(results2.size(), 1);
+  EXPECT_EQ(results1[0].vector_datas[0].distance, 1);
+  EXPECT_EQ(results2[0].vector_datas[0].distance, 2);
+}
+
+TEST(SDKVectorSearchCoalescerTest, ErrorToAllCallers) {
+  VectorSearchCoalescer coalescer(10 * 1000 * 1000, 4);
+  SearchParam param;
+
+  auto search_func = [](const std::vector<VectorWithId>&, std::vector<SearchResult>&) {
+    return Status::RemoteError("mock error");
+  };
+
+  std::vector<std::thread> threads;
+  std::vector<Status> statuses(4);
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&, i] {
+      auto queries = CreateQueries(i, 1);
+      std::vector<SearchResult> results;
+      statuses[i] = coalescer.Search(1, param, VectorRows(queries), results, search_func);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& status : statuses) {
+    EXPECT_TRUE(status.IsRemoteError()) << status.ToString();
+  }
+}
+
+}  // namespace sdk
+}  // namespace dingodb
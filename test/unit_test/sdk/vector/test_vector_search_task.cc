@@ -0,0 +1,471 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "dingosdk/vector.h"
+#include "gtest/gtest.h"
+#include "sdk/common/param_config.h"
+#include "sdk/rpc/coordinator_rpc.h"
+#include "sdk/rpc/index_service_rpc.h"
+#include "sdk/vector/vector_common.h"
+#include "sdk/vector/vector_search_task.h"
+#include "sdk/vector/vector_stream_search_task.h"
+#include "test_base.h"
+
+namespace dingodb {
+namespace sdk {
+
+class SDKVectorSearchTaskTest : public TestBase {
+ public:
+  void SetUp() override {
+    late_materialize_min_regions = FLAGS_vector_search_late_materialize_min_regions;
+    FLAGS_vector_search_late_materialize_min_regions = 0;
+
+    vector_index = CreateFakeVectorIndex();
+    EXPECT_CALL(*meta_rpc_controller, SyncCall).WillRepeatedly([this](Rpc& rpc) {
+      auto* t_rpc = dynamic_cast<GetIndexRpc*>(&rpc);
+      CHECK_NOTNULL(t_rpc);
+      *(t_rpc->MutableResponse()->mutable_index_definition_with_id()) = vector_index->GetIndexDefWithId();
+      return Status::OK();
+    });
+
+    // one region per partition, region id is 100 + partition id
+    const auto& partition = vector_index->GetIndexDefWithId().index_definition().index_partition();
+    for (int i = 0; i < partition.partitions_size(); i++) {
+      pb::common::RegionEpoch epoch;
+      epoch.set_version(1);
+      epoch.set_conf_version(1);
+      meta_cache->MaybeAddRegion(GenRegion(100 + partition.partitions(i).id().entity_id(),
+                                           partition.partitions(i).range(), epoch,
+                                           pb::common::RegionType::INDEX_REGION));
+    }
+  }
+
+  void TearDown() override { FLAGS_vector_search_late_materialize_min_regions = late_materialize_min_regions; }
+
+  // partitions 3, 4, 5, 6 own ids [0, 5), [5, 10), [10, 20), [20, max)
+  static std::shared_ptr<VectorIndex> CreateFakeVectorIndex() {
+    std::vector<int64_t> index_and_part_ids{2, 3, 4, 5, 6};
+    std::vector<int64_t> range_seperator_ids = {5, 10, 20};
+    FlatParam flat_param{2, dingodb::sdk::MetricType::kL2};
+
+    pb::meta::IndexDefinitionWithId index_definition_with_id;
+    FillVectorIndexId(index_definition_with_id.mutable_index_id(), index_and_part_ids[0], 2);
+    auto* defination = index_definition_with_id.mutable_index_definition();
+    defination->set_name("test");
+    FillRangePartitionRule(defination->mutable_index_partition(), range_seperator_ids, index_and_part_ids);
+    defination->set_replica(3);
+
+    auto* index_parameter = defination->mutable_index_parameter();
+    index_parameter->set_index_type(pb::common::IndexType::INDEX_TYPE_VECTOR);
+    FillFlatParmeter(index_parameter->mutable_vector_index_parameter(), flat_param);
+
+    return std::make_shared<VectorIndex>(index_definition_with_id);
+  }
+
+  static std::vector<VectorWithId> GenTargetVectors(int64_t count) {
+    std::vector<VectorWithId> vectors;
+    for (int64_t i = 0; i < count; i++) {
+      Vector vector(ValueType::kFloat, 2);
+      vector.float_values = {1.0f * i, 1.0f * i};
+      vectors.emplace_back(std::move(vector));
+    }
+    return vectors;
+  }
+
+  // every region answers each target vector with the vector of id (region id - 100), distance is the id
+  static void FillSearchResponse(VectorSearchRpc& rpc) {
+    int64_t id = rpc.Request()->context().region_id() - 100;
+    for (int i = 0; i < rpc.Request()->vector_with_ids_size(); i++) {
+      auto* distance = rpc.MutableResponse()->add_batch_results()->add_vector_with_distances();
+      distance->mutable_vector_with_id()->set_id(id);
+      distance->mutable_vector_with_id()->mutable_vector()->set_value_type(pb::common::ValueType::FLOAT);
+      distance->set_distance(static_cast<float>(id));
+      distance->set_metric_type(pb::common::MetricType::METRIC_TYPE_L2);
+    }
+  }
+
+  // every asked id is found with vector (id, id), except the deleted ones
+  static void FillBatchQueryResponse(VectorBatchQueryRpc& rpc, const std::set<int64_t>& deleted_ids) {
+    for (const auto& id : rpc.Request()->vector_ids()) {
+      auto* vector_with_id = rpc.MutableResponse()->add_vectors();
+      if (deleted_ids.count(id) > 0) {
+        continue;
+      }
+      vector_with_id->set_id(id);
+      auto* vector = vector_with_id->mutable_vector();
+      vector->set_value_type(pb::common::ValueType::FLOAT);
+      vector->set_dimension(2);
+      vector->add_float_values(1.0f * id);
+      vector->add_float_values(1.0f * id);
+    }
+  }
+
+  std::shared_ptr<VectorIndex> vector_index;
+  int64_t late_materialize_min_regions;
+};
+
+TEST_F(SDKVectorSearchTaskTest, RegionRequestFromTemplate) {
+  SearchParam param;
+  param.topk = 2;
+  param.with_scalar_data = true;
+  param.selected_keys = {"key"};
+  std::vector<VectorWithId> target_vectors = GenTargetVectors(2);
+
+  std::mutex mutex;
+  std::map<int64_t, pb::index::VectorSearchRequest> region_requests;
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(4).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* t_rpc = dynamic_cast<VectorSearchRpc*>(&rpc);
+    CHECK_NOTNULL(t_rpc);
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      region_requests[t_rpc->Request()->context().region_id()] = *t_rpc->Request();
+    }
+    FillSearchResponse(*t_rpc);
+    cb();
+  });
+
+  std::vector<SearchResult> out_result;
+  VectorSearchTask task(*stub, vector_index->GetId(), param, target_vectors, out_result);
+  Status s = task.Run();
+  ASSERT_TRUE(s.ok()) << s.ToString();
+
+  // every region gets the same parameter and target vectors with its own context
+  ASSERT_EQ(region_requests.size(), 4U);
+  const auto& first = region_requests.begin()->second;
+  EXPECT_EQ(first.parameter().top_n(), 2);
+  EXPECT_FALSE(first.parameter().without_scalar_data());
+  ASSERT_EQ(first.parameter().selected_keys_size(), 1);
+  EXPECT_EQ(first.vector_with_ids_size(), 2);
+  for (const auto& [region_id, request] : region_requests) {
+    EXPECT_EQ(request.context().region_id(), region_id);
+    EXPECT_EQ(request.context().region_epoch().version(), 1);
+    EXPECT_EQ(request.parameter().SerializeAsString(), first.parameter().SerializeAsString());
+    ASSERT_EQ(request.vector_with_ids_size(), 2);
+    for (int i = 0; i < request.vector_with_ids_size(); i++) {
+      EXPECT_EQ(request.vector_with_ids(i).vector().float_values(0), 1.0f * i);
+    }
+  }
+
+  // merged top-2 of the four regions
+  ASSERT_EQ(out_result.size(), 2U);
+  for (const auto& result : out_result) {
+    ASSERT_EQ(result.vector_datas.size(), 2U);
+    EXPECT_EQ(result.vector_datas[0].vector_data.id, 3);
+    EXPECT_EQ(result.vector_datas[1].vector_data.id, 4);
+  }
+}
+
+TEST_F(SDKVectorSearchTaskTest, PruneByVectorIds) {
+  SearchParam param;
+  param.topk = 2;
+  param.filter_source = FilterSource::kVectorIdFilter;
+  param.vector_ids = {1, 2, 12};
+  std::vector<VectorWithId> target_vectors = GenTargetVectors(1);
+
+  // only regions of partition 3 and 5 own the ids, each is sent its own ids
+  std::mutex mutex;
+  std::map<int64_t, std::vector<int64_t>> region_ids;
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(2).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* t_rpc = dynamic_cast<VectorSearchRpc*>(&rpc);
+    CHECK_NOTNULL(t_rpc);
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      const auto& ids = t_rpc->Request()->parameter().vector_ids();
+      region_ids[t_rpc->Request()->context().region_id()].assign(ids.begin(), ids.end());
+    }
+    FillSearchResponse(*t_rpc);
+    cb();
+  });
+
+  std::vector<SearchResult> out_result;
+  VectorSearchTask task(*stub, vector_index->GetId(), param, target_vectors, out_result);
+  Status s = task.Run();
+  ASSERT_TRUE(s.ok()) << s.ToString();
+
+  EXPECT_EQ(region_ids, (std::map<int64_t, std::vector<int64_t>>{{103, {1, 2}}, {105, {12}}}));
+}
+
+TEST_F(SDKVectorSearchTaskTest, NegationVectorIdsNotPrune) {
+  SearchParam param;
+  param.topk = 2;
+  param.filter_source = FilterSource::kVectorIdFilter;
+  param.is_negation = true;
+  param.vector_ids = {1, 12};
+  std::vector<VectorWithId> target_vectors = GenTargetVectors(1);
+
+  // excluded ids say nothing about where results live, every region gets all ids
+  std::mutex mutex;
+  std::map<int64_t, int> region_id_counts;
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(4).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* t_rpc = dynamic_cast<VectorSearchRpc*>(&rpc);
+    CHECK_NOTNULL(t_rpc);
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      region_id_counts[t_rpc->Request()->context().region_id()] = t_rpc->Request()->parameter().vector_ids_size();
+    }
+    FillSearchResponse(*t_rpc);
+    cb();
+  });
+
+  std::vector<SearchResult> out_result;
+  VectorSearchTask task(*stub, vector_index->GetId(), param, target_vectors, out_result);
+  Status s = task.Run();
+  ASSERT_TRUE(s.ok()) << s.ToString();
+
+  EXPECT_EQ(region_id_counts, (std::map<int64_t, int>{{103, 2}, {104, 2}, {105, 2}, {106, 2}}));
+}
+
+TEST_F(SDKVectorSearchTaskTest, StreamQuorum) {
+  SearchParam param;
+  param.topk = 2;
+  std::vector<VectorWithId> target_vectors = GenTargetVectors(1);
+
+  // regions answer in the order sent, half of them reach quorum
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(4).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* t_rpc = dynamic_cast<VectorSearchRpc*>(&rpc);
+    CHECK_NOTNULL(t_rpc);
+    FillSearchResponse(*t_rpc);
+    cb();
+  });
+
+  std::vector<int64_t> callback_region_ids;
+  StreamSearchOption option;
+  option.quorum_ratio = 0.5;
+  option.region_callback = [&](int64_t region_id, const std::vector<SearchResult>& region_results) {
+    EXPECT_EQ(region_results.size(), 1U);
+    callback_region_ids.push_back(region_id);
+  };
+
+  StreamSearchResult out_result;
+  VectorStreamSearchTask task(*stub, vector_index->GetId(), param, target_vectors, option, out_result);
+  Status s = task.Run();
+  ASSERT_TRUE(s.ok()) << s.ToString();
+
+  EXPECT_EQ(out_result.region_count, 4);
+  EXPECT_EQ(callback_region_ids, (std::vector<int64_t>{103, 104}));
+  EXPECT_EQ(out_result.skipped_region_ids, (std::vector<int64_t>{105, 106}));
+  ASSERT_EQ(out_result.results.size(), 1U);
+  ASSERT_EQ(out_result.results[0].vector_datas.size(), 2U);
+  EXPECT_EQ(out_result.results[0].vector_datas[0].vector_data.id, 3);
+}
+
+TEST_F(SDKVectorSearchTaskTest, StreamSkipFailedRegion) {
+  SearchParam param;
+  param.topk = 10;
+  std::vector<VectorWithId> target_vectors = GenTargetVectors(1);
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(4).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* t_rpc = dynamic_cast<VectorSearchRpc*>(&rpc);
+    CHECK_NOTNULL(t_rpc);
+    if (t_rpc->Request()->context().region_id() == 105) {
+      t_rpc->MutableResponse()->mutable_error()->set_errcode(pb::error::EVECTOR_INDEX_NOT_READY);
+    } else {
+      FillSearchResponse(*t_rpc);
+    }
+    cb();
+  });
+
+  // quorum of 3 out of 4 regions is still reached with one failed region
+  StreamSearchOption option;
+  option.quorum_ratio = 0.75;
+
+  StreamSearchResult out_result;
+  VectorStreamSearchTask task(*stub, vector_index->GetId(), param, target_vectors, option, out_result);
+  Status s = task.Run();
+  ASSERT_TRUE(s.ok()) << s.ToString();
+
+  EXPECT_EQ(out_result.skipped_region_ids, (std::vector<int64_t>{105}));
+  ASSERT_EQ(out_result.results.size(), 1U);
+  ASSERT_EQ(out_result.results[0].vector_datas.size(), 3U);
+  EXPECT_EQ(out_result.results[0].vector_datas[2].vector_data.id, 6);
+}
+
+TEST_F(SDKVectorSearchTaskTest, StreamDeadline) {
+  SearchParam param;
+  param.topk = 10;
+  std::vector<VectorWithId> target_vectors = GenTargetVectors(1);
+
+  // regions of partition 5 and 6 never answer before deadline
+  std::mutex mutex;
+  std::vector<std::function<void()>> held_callbacks;
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(4).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* t_rpc = dynamic_cast<VectorSearchRpc*>(&rpc);
+    CHECK_NOTNULL(t_rpc);
+    FillSearchResponse(*t_rpc);
+    if (t_rpc->Request()->context().region_id() >= 105) {
+      std::lock_guard<std::mutex> guard(mutex);
+      held_callbacks.push_back(std::move(cb));
+      return;
+    }
+    cb();
+  });
+
+  std::vector<int64_t> callback_region_ids;
+  StreamSearchOption option;
+  option.deadline_ms = 50;
+  option.region_callback = [&](int64_t region_id, const std::vector<SearchResult>& region_results) {
+    callback_region_ids.push_back(region_id);
+  };
+
+  StreamSearchResult out_result;
+  VectorStreamSearchTask task(*stub, vector_index->GetId(), param, target_vectors, option, out_result);
+  Status s = task.Run();
+  ASSERT_TRUE(s.ok()) << s.ToString();
+
+  EXPECT_EQ(out_result.skipped_region_ids, (std::vector<int64_t>{105, 106}));
+  ASSERT_EQ(out_result.results.size(), 1U);
+  EXPECT_EQ(out_result.results[0].vector_datas.size(), 2U);
+
+  // late answers after the search returned are dropped without callback
+  for (auto& cb : held_callbacks) {
+    cb();
+  }
+  EXPECT_EQ(callback_region_ids, (std::vector<int64_t>{103, 104}));
+}
+
+TEST_F(SDKVectorSearchTaskTest, LateMaterializeMergePayload) {
+  FLAGS_vector_search_late_materialize_min_regions = 2;
+
+  SearchParam param;
+  param.topk = 2;
+  param.with_vector_data = true;
+  std::vector<VectorWithId> target_vectors = GenTargetVectors(1);
+
+  std::mutex mutex;
+  std::vector<pb::index::VectorSearchRequest> search_requests;
+  std::vector<int64_t> query_ids;
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(5).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* query_rpc = dynamic_cast<VectorBatchQueryRpc*>(&rpc);
+    if (query_rpc != nullptr) {
+      {
+        std::lock_guard<std::mutex> guard(mutex);
+        query_ids.insert(query_ids.end(), query_rpc->Request()->vector_ids().begin(),
+                         query_rpc->Request()->vector_ids().end());
+      }
+      FillBatchQueryResponse(*query_rpc, {});
+      cb();
+      return;
+    }
+
+    auto* t_rpc = dynamic_cast<VectorSearchRpc*>(&rpc);
+    CHECK_NOTNULL(t_rpc);
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      search_requests.push_back(*t_rpc->Request());
+    }
+    FillSearchResponse(*t_rpc);
+    cb();
+  });
+
+  std::vector<SearchResult> out_result;
+  VectorSearchTask task(*stub, vector_index->GetId(), param, target_vectors, out_result);
+  Status s = task.Run();
+  ASSERT_TRUE(s.ok()) << s.ToString();
+
+  // regions send ids and distances only, payload of the merged top-2 is fetched once
+  ASSERT_EQ(search_requests.size(), 4U);
+  for (const auto& request : search_requests) {
+    EXPECT_TRUE(request.parameter().without_vector_data());
+    EXPECT_TRUE(request.parameter().without_scalar_data());
+    EXPECT_TRUE(request.parameter().without_table_data());
+  }
+  std::sort(query_ids.begin(), query_ids.end());
+  EXPECT_EQ(query_ids, (std::vector<int64_t>{3, 4}));
+
+  ASSERT_EQ(out_result.size(), 1U);
+  const auto& vector_datas = out_result[0].vector_datas;
+  ASSERT_EQ(vector_datas.size(), 2U);
+  for (int64_t i = 0; i < 2; i++) {
+    EXPECT_EQ(vector_datas[i].vector_data.id, 3 + i);
+    EXPECT_FLOAT_EQ(vector_datas[i].distance, 3.0f + i);
+    ASSERT_EQ(vector_datas[i].vector_data.vector.float_values.size(), 2U);
+    EXPECT_FLOAT_EQ(vector_datas[i].vector_data.vector.float_values[0], 3.0f + i);
+  }
+}
+
+TEST_F(SDKVectorSearchTaskTest, LateMaterializeDeletedSurvivor) {
+  FLAGS_vector_search_late_materialize_min_regions = 2;
+
+  SearchParam param;
+  param.topk = 2;
+  param.with_vector_data = true;
+  std::vector<VectorWithId> target_vectors = GenTargetVectors(1);
+
+  // vector 4 is deleted between search and payload fetch
+  EXPECT_CALL(*store_rpc_client, SendRpc).Times(5).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* query_rpc = dynamic_cast<VectorBatchQueryRpc*>(&rpc);
+    if (query_rpc != nullptr) {
+      FillBatchQueryResponse(*query_rpc, {4});
+    } else {
+      auto* t_rpc = dynamic_cast<VectorSearchRpc*>(&rpc);
+      CHECK_NOTNULL(t_rpc);
+      FillSearchResponse(*t_rpc);
+    }
+    cb();
+  });
+
+  std::vector<SearchResult> out_result;
+  VectorSearchTask task(*stub, vector_index->GetId(), param, target_vectors, out_result);
+  Status s = task.Run();
+  ASSERT_TRUE(s.ok()) << s.ToString();
+
+  // the deleted vector keeps id and distance without payload
+  ASSERT_EQ(out_result.size(), 1U);
+  const auto& vector_datas = out_result[0].vector_datas;
+  ASSERT_EQ(vector_datas.size(), 2U);
+  EXPECT_EQ(vector_datas[0].vector_data.vector.float_values.size(), 2U);
+  EXPECT_EQ(vector_datas[1].vector_data.id, 4);
+  EXPECT_FLOAT_EQ(vector_datas[1].distance, 4.0f);
+  EXPECT_TRUE(vector_datas[1].vector_data.vector.float_values.empty());
+}
+
+TEST_F(SDKVectorSearchTaskTest, LateMaterializeFetchFail) {
+  FLAGS_vector_search_late_materialize_min_regions = 2;
+
+  SearchParam param;
+  param.topk = 2;
+  param.with_vector_data = true;
+  std::vector<VectorWithId> target_vectors = GenTargetVectors(1);
+
+  EXPECT_CALL(*store_rpc_client, SendRpc).WillRepeatedly([&](Rpc& rpc, std::function<void()> cb) {
+    auto* query_rpc = dynamic_cast<VectorBatchQueryRpc*>(&rpc);
+    if (query_rpc != nullptr) {
+      query_rpc->MutableResponse()->mutable_error()->set_errcode(pb::error::EINTERNAL);
+    } else {
+      auto* t_rpc = dynamic_cast<VectorSearchRpc*>(&rpc);
+      CHECK_NOTNULL(t_rpc);
+      FillSearchResponse(*t_rpc);
+    }
+    cb();
+  });
+
+  // the search fails instead of returning results without the asked payload
+  std::vector<SearchResult> out_result;
+  VectorSearchTask task(*stub, vector_index->GetId(), param, target_vectors, out_result);
+  Status s = task.Run();
+  EXPECT_FALSE(s.ok());
+}
+
+}  // namespace sdk
+}  // namespace dingodb
@@ -0,0 +1,94 @@
+// Copyright (c) 2023 dingodb.com, Inc. All Rights Reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <cstdint>
+#include <vector>
+
+#include "dingosdk/vector.h"
+#include "gtest/gtest.h"
+#include "sdk/vector/vector_topk.h"
+
+namespace dingodb {
+namespace sdk {
+
+static VectorWithDistance CreateResult(int64_t id, float distance, MetricType metric_type) {
+  VectorWithDistance result;
+  result.vector_data.id = id;
+  result.distance = distance;
+  result.metric_type = metric_type;
+  return result;
+}
+
+static std::vector<int64_t> ResultIds(const std::vector<VectorWithDistance>& results) {
+  std::vector<int64_t> ids;
+  for (const auto& result : results) {
+    ids.push_back(result.vector_data.id);
+  }
+  return ids;
+}
+
+TEST(SDKVectorTopKTest, SmallerIsBetter) {
+  VectorTopK topk(3);
+  std::vector<float> distances = {5.0, 1.0, 4.0, 2.0, 3.0};
+  for (int64_t i = 0; i < distances.size(); i++) {
+    topk.Push(CreateResult(i + 1, distances[i], MetricType::kL2));
+  }
+
+  EXPECT_EQ(topk.Size(), 3);
+  EXPECT_TRUE(topk.Accept(2.5));
+  EXPECT_FALSE(topk.Accept(3.5));
+  EXPECT_EQ(ResultIds(topk.Finish()), std::vector<int64_t>({2, 4, 5}));
+  EXPECT_EQ(topk.Size(), 0);
+}
+
+TEST(SDKVectorTopKTest, InnerProductDistance) {
+  // store reports inner product as a distance, smaller is better like l2
+  VectorTopK topk(2);
+  std::vector<float> distances = {0.1, 0.9, -0.5, 0.7};
+  for (int64_t i = 0; i < distances.size(); i++) {
+    topk.Push(CreateResult(i + 1, distances[i], MetricType::kInnerProduct));
+  }
+
+  EXPECT_TRUE(topk.Accept(0.0));
+  EXPECT_FALSE(topk.Accept(0.6));
+  EXPECT_EQ(ResultIds(topk.Finish()), std::vector<int64_t>({3, 1}));
+}
+
+TEST(SDKVectorTopKTest, Merge) {
+  VectorTopK left(2);
+  left.Push(CreateResult(1, 3.0, MetricType::kL2));
+  left.Push(CreateResult(2, 6.0, MetricType::kL2));
+
+  VectorTopK right(2);
+  right.Push(CreateResult(3, 1.0, MetricType::kL2));
+  right.Push(CreateResult(4, 4.0, MetricType::kL2));
+
+  left.Merge(std::move(right));
+  EXPECT_EQ(ResultIds(left.Finish()), std::vector<int64_t>({3, 1}));
+}
+
+TEST(SDKVectorTopKTest, Unbounded) {
+  VectorTopK topk(0);
+  std::vector<float> distances = {3.0, 1.0, 2.0};
+  for (int64_t i = 0; i < distances.size(); i++) {
+    EXPECT_TRUE(topk.Accept(distances[i]));
+    topk.Push(CreateResult(i + 1, distances[i], MetricType::kL2));
+  }
+
+  EXPECT_EQ(ResultIds(topk.Finish()), std::vector<int64_t>({2, 3, 1}));
+}
+
+}  // namespace sdk
+}  // namespace dingodb